@@ -247,6 +247,8 @@ class Content;
 
 class Transform;
 
+struct TrackMatteCache;
+
 class PAGFile;
 
 class ContentVersion;
@@ -490,6 +492,8 @@ class PAG_API PAGLayer : public Content {
   bool layerVisible = true;
   bool _excludedFromTimeline = false;
   std::shared_ptr<PAGLayer> _trackMatteLayer = nullptr;
+  // The cached track matte recorded from this layer if it is a track matte layer.
+  TrackMatteCache* trackMatteCache = nullptr;
   int _editableIndex = -1;
   uint32_t contentVersion = 0;
   std::atomic<uint32_t> audioVersion = {0};
@@ -537,6 +541,8 @@ class PAG_API PAGLayer : public Content {
   friend class PAGDecoder;
 
   friend class VideoInfoManager;
+
+  friend class DamageTracker;
 };
 
 class SolidLayer;
@@ -574,6 +580,8 @@ class TextLayer;
 
 class TextReplacement;
 
+class TextContentCache;
+
 class PAG_API PAGTextLayer : public PAGLayer {
  public:
   static std::shared_ptr<PAGTextLayer> Make(int64_t duration, std::string text, float fontSize = 24,
@@ -656,8 +664,12 @@ class PAG_API PAGTextLayer : public PAGLayer {
 
   TextDocument* textDocumentForWrite();
 
+  std::shared_ptr<TextContentCache> getTextContentCache();
+
   friend class PAGFile;
 
+  friend class PAGPlayer;
+
   friend class TextReplacement;
 };
 
@@ -1023,6 +1035,8 @@ class PAG_API PAGComposition : public PAGLayer {
   friend class PAGDecoder;
 
   friend class VideoInfoManager;
+
+  friend class DamageTracker;
 };
 
 class PAG_API PAGFile : public PAGComposition {
@@ -1043,6 +1057,18 @@ class PAG_API PAGFile : public PAGComposition {
    */
   static std::shared_ptr<PAGFile> Load(const std::string& filePath);
 
+  /**
+   * Asynchronously loads the pag files at the specified paths on the shared background thread
+   * pool, which is bounded by the number of CPU cores. The callback is called once on a background
+   * thread after all files are loaded, with the files in the same order as the paths and null
+   * entries for the ones that failed to load. Loads of the same path that run at the same time,
+   * including synchronous ones, decode the file only once. If preloadResources is true, the images
+   * and text glyphs used by the first frame of each file are also prepared in advance.
+   */
+  static void LoadAsync(const std::vector<std::string>& filePaths,
+                        std::function<void(std::vector<std::shared_ptr<PAGFile>>)> callback,
+                        bool preloadResources = false);
+
   PAGFile(std::shared_ptr<File> file, PreComposeLayer* layer);
 
   /**
@@ -1177,6 +1203,8 @@ class Composition;
 
 class PAGPlayer;
 
+class TextBlock;
+
 class PAG_API PAGSurface {
  public:
   /**
@@ -1271,9 +1299,14 @@ class PAG_API PAGSurface {
   bool externalContext = false;
   void* glRestorer = nullptr;
 
+  std::weak_ptr<tgfx::Surface> lastSurface;
+  std::vector<Rect> dirtyRegion = {};
+
   bool draw(RenderCache* cache, std::shared_ptr<Graphic> graphic, BackendSemaphore* signalSemaphore,
-            bool autoClear = true);
+            bool autoClear = true, const std::vector<tgfx::Rect>* damageRects = nullptr);
   bool prepare(RenderCache* cache, std::shared_ptr<Graphic> graphic);
+  int prewarmFilters(RenderCache* cache, std::shared_ptr<File> file);
+  int prewarmGlyphs(RenderCache* cache, const std::vector<std::shared_ptr<TextBlock>>& textBlocks);
   bool hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y);
   tgfx::Context* lockContext();
   void unlockContext();
@@ -1293,6 +1326,8 @@ class PAG_API PAGSurface {
 
 class FileReporter;
 
+class DamageTracker;
+
 class PAG_API PAGPlayer {
  public:
   PAGPlayer();
@@ -1356,6 +1391,21 @@ class PAG_API PAGPlayer {
    */
   void setUseDiskCache(bool value);
 
+  /**
+   * If set to true, PAGImages created from files or encoded bytes are decoded at a smaller size
+   * when they are only displayed downscaled, e.g. a large photo placed into a small image layer.
+   * The image is decoded again at a larger size once it is displayed larger. This reduces the
+   * decoding time and the graphics memory, but the downscaled images may look slightly different
+   * from the full-size ones. Images that are displayed at their original size or larger are never
+   * downscaled. The default value is false.
+   */
+  bool imageDownsampling();
+
+  /**
+   * Set the value of imageDownsampling property.
+   */
+  void setImageDownsampling(bool value);
+
   /**
    * This value defines the scale factor for internal graphics caches, ranges from 0.0 to 1.0. The
    * scale factors less than 1.0 may result in blurred output, but it can reduce the usage of
@@ -1368,6 +1418,21 @@ class PAG_API PAGPlayer {
    */
   void setCacheScale(float value);
 
+  /**
+   * This value defines the quality of the blur-like filters, such as gaussian blurs, radial blurs,
+   * drop shadows and outer glows, ranges from 0.0 to 1.0. Values less than 1.0 let the filters
+   * with large blur radii run at a lower resolution picked from their radii and then scale the
+   * results back up, which greatly reduces the GPU cost with little visible difference. The lower
+   * the value, the more filters are downsampled. The default value is 1.0, which always runs the
+   * filters at full resolution.
+   */
+  float filterQuality();
+
+  /**
+   * Set the value of filterQuality property.
+   */
+  void setFilterQuality(float value);
+
   /**
    * The maximum frame rate for rendering, ranges from 1 to 60. If set to a value less than the
    * actual frame rate from composition, it drops frames but increases performance. Otherwise, it
@@ -1446,6 +1511,27 @@ class PAG_API PAGPlayer {
    */
   void setAutoClear(bool value);
 
+  /**
+   * If set to true, PAGPlayer tracks the areas changed by each layer since the last frame, and
+   * only redraws those areas when flushing to a surface that retains its content between frames,
+   * such as an offscreen PAGSurface. Other surfaces are still redrawn entirely, but the changed
+   * areas are reported by getDirtyRegion(). It only takes effect when autoClear is true. The
+   * default value is false.
+   */
+  bool partialRedraw();
+
+  /**
+   * Sets the partialRedraw property.
+   */
+  void setPartialRedraw(bool value);
+
+  /**
+   * Returns the areas of the surface changed by the last flush() call, in the coordinate space of
+   * the PAGSurface. Returns the whole bounds of the surface if partialRedraw is false or the
+   * surface was redrawn entirely, and an empty list if nothing was drawn.
+   */
+  std::vector<Rect> getDirtyRegion();
+
   /**
    * Prepares the player for the next flush() call. It collects all CPU tasks from the current
    * progress of the composition and runs them asynchronously in parallel. It is usually used for
@@ -1453,6 +1539,24 @@ class PAG_API PAGPlayer {
    */
   void prepare();
 
+  /**
+   * Compiles the GPU programs of all filters used by the specified file ahead of time, so the first
+   * frame displaying them doesn't stall on shader compiling. The compiled programs are shared by
+   * all players rendering to the same GPU context. It requires the player to have a surface.
+   * Returns the number of filters that have been prewarmed.
+   */
+  int prewarmFilters(std::shared_ptr<PAGFile> file);
+
+  /**
+   * Shapes the texts of all text layers in the specified file, including every keyframe of their
+   * source texts, and rasterizes the glyphs into the glyph atlas at their expected scales ahead of
+   * time, so the first frame displaying them doesn't stall on text shaping and glyph uploading. The
+   * shaped texts are shared by all PAGFiles of the same file, and the glyph atlas is shared by all
+   * players rendering to the same GPU context. It is usually called on a background thread and
+   * requires the player to have a surface. Returns the number of glyphs that have been prewarmed.
+   */
+  int prewarmGlyphs(std::shared_ptr<PAGFile> file);
+
   /**
    * Inserts a GPU semaphore that the current GPU-backed API must wait on before executing any more
    * commands on the GPU for this player. It is usually called before PAGPlayer.flush(). PAG will
@@ -1549,6 +1653,7 @@ class PAG_API PAGPlayer {
 
  private:
   FileReporter* reporter = nullptr;
+  DamageTracker* damageTracker = nullptr;
   float _maxFrameRate = 60;
   PAGScaleMode _scaleMode = PAGScaleMode::LetterBox;
   bool _autoClear = true;
@@ -1635,6 +1740,20 @@ class PAG_API PAGDecoder {
    */
   bool readFrame(int index, HardwareBufferRef hardwareBuffer);
 
+  /**
+   * Reads count image frames starting from the given index in order, and passes the pixels of each
+   * frame to the callback along with its index and rowBytes. The pixels are only valid during the
+   * callback. Frames that are not cached yet are rendered in a pipeline, the next frame is rendered
+   * while the pixels of the previous one are being read back, which is usually much faster than
+   * calling readFrame() for each frame. Returning false from the callback stops reading. Returns
+   * the number of frames passed to the callback. Note that colorType and alphaType must stay the
+   * same as in the readFrame() calls, and the rowBytes is always width * 4.
+   */
+  int readFrames(int startIndex, int count,
+                 std::function<bool(int index, const void* pixels, size_t rowBytes)> callback,
+                 ColorType colorType = ColorType::RGBA_8888,
+                 AlphaType alphaType = AlphaType::Premultiplied);
+
  private:
   std::mutex locker = {};
   int _width = 0;
@@ -1665,6 +1784,8 @@ class PAG_API PAGDecoder {
   bool readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitmap);
   bool renderFrame(std::shared_ptr<PAGComposition> composition, int index,
                    std::shared_ptr<BitmapBuffer> bitmap);
+  bool checkReader(std::shared_ptr<PAGComposition> composition);
+  void checkComplete(const std::shared_ptr<PAGComposition>& composition);
   bool checkSequenceFile(std::shared_ptr<PAGComposition> composition, const tgfx::ImageInfo& info);
   void checkCompositionChange(std::shared_ptr<PAGComposition> composition);
   std::string generateCacheKey(std::shared_ptr<PAGComposition> composition);
@@ -1731,6 +1852,20 @@ class PAG_API PAG {
    * Get SDK version information.
    */
   static std::string SDKVersion();
+
+  /**
+   * Starts or stops recording per-frame trace spans, such as flushing, drawing layers and decoding
+   * sequences. Spans are only recorded if the SDK is built with the PAG_USE_TRACE option, otherwise
+   * this method does nothing.
+   */
+  static void SetTraceEnabled(bool enabled);
+
+  /**
+   * Writes the trace spans recorded so far to the specified file in the Chrome trace event format,
+   * which can be opened by chrome://tracing or https://ui.perfetto.dev, and then discards them.
+   * Returns false if the file cannot be written.
+   */
+  static bool DumpTrace(const std::string& filePath);
 };
 
 }  // namespace pag
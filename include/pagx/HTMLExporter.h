@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include "pagx/OutputSink.h"
 #include "pagx/PAGXDocument.h"
 
 namespace pagx {
@@ -127,6 +128,26 @@ class HTMLExporter {
                             HTMLOutputMode mode = HTMLOutputMode::Fragment,
                             const Options& options = {}, std::string* errorMsg = nullptr);
 
+  /**
+   * Exports a PAGXDocument as HTML to the specified sink instead of returning it as a string. The
+   * generated pieces of the output are written to the sink one after another, so the complete
+   * document is never concatenated in memory. The written bytes are identical to the string
+   * returned by ToHTML() with the same arguments, and the resource directory contract,
+   * precondition, and thread safety rules of ToHTML() apply unchanged.
+   *
+   * @param document The PAGX document to export. Layout is applied automatically if needed.
+   * @param resourceDir Absolute directory path for auxiliary PNGs and copied images. Must not
+   *                    be empty.
+   * @param sink The sink receiving the output. Must not be null.
+   * @param mode Controls whether the output is a bare HTML fragment or a complete document.
+   * @param options Export options controlling output formatting.
+   * @param errorMsg Optional pointer to receive a human-readable error description on failure.
+   * @return True on success, false if the arguments are invalid or any write to the sink fails.
+   */
+  static bool ToStream(PAGXDocument& document, const std::string& resourceDir, OutputSink* sink,
+                       HTMLOutputMode mode = HTMLOutputMode::Fragment, const Options& options = {},
+                       std::string* errorMsg = nullptr);
+
   /**
    * Exports a PAGXDocument to an HTML file. Creates parent directories if they do not exist.
    *
@@ -134,11 +155,13 @@ class HTMLExporter {
    * `parent_path(filePath) / stem(filePath)` — i.e. a sibling directory of the HTML file whose
    * name matches the HTML file's stem. For example, `filePath = "/tmp/abc.html"` writes
    * auxiliary assets to `/tmp/abc/` and the HTML references them via `<img src="abc/...">`.
-   * Internally this method calls ToHTML with the derived resource directory and writes the
-   * resulting string to disk.
+   * Internally this method streams the output of ToStream with the derived resource directory
+   * straight to disk.
    *
-   * File handling: the output file is opened with std::ios::binary and truncated; if a file
-   * already exists at `filePath` it is overwritten without prompting. `filePath` is used
+   * File handling: the output is streamed to a temporary file next to `filePath` (named
+   * `filePath` + ".tmp"), which is renamed over `filePath` only after the whole document has
+   * been written. A failed export leaves any existing file at `filePath` untouched; a
+   * successful one overwrites it without prompting. `filePath` is used
    * verbatim — the library does not validate, sanitise, or restrict it, so protecting against
    * path traversal and ensuring the location is writable are the caller's responsibility.
    *
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace pagx {
+
+/**
+ * OutputSink receives the bytes produced by an exporter as they are generated, so large documents
+ * can be written out without holding the complete output in memory. Exporters write to the sink
+ * in chunks of bounded size, in document order.
+ */
+class OutputSink {
+ public:
+  /**
+   * Creates a sink that writes to the file at the specified path. The file is created if it does
+   * not exist and truncated otherwise. Returns nullptr if the file cannot be opened.
+   */
+  static std::unique_ptr<OutputSink> MakeFromFile(const std::string& filePath);
+
+  /**
+   * Creates a sink that writes to the specified file descriptor. The descriptor is not closed when
+   * the sink is destroyed. Returns nullptr if the descriptor is negative.
+   */
+  static std::unique_ptr<OutputSink> MakeFromFileDescriptor(int fd);
+
+  /**
+   * Creates a sink that forwards every chunk to the specified callback. The callback returns false
+   * to abort the export. Returns nullptr if the callback is empty.
+   */
+  static std::unique_ptr<OutputSink> MakeFromCallback(
+      std::function<bool(const void* data, size_t length)> callback);
+
+  /**
+   * Creates a sink that appends every chunk to the specified string, which must outlive the sink.
+   * Returns nullptr if the string is nullptr.
+   */
+  static std::unique_ptr<OutputSink> MakeFromString(std::string* output);
+
+  virtual ~OutputSink() = default;
+
+  /**
+   * Writes the specified bytes to the sink. Returns false if the bytes could not be written, after
+   * which exporters stop producing output.
+   */
+  virtual bool write(const void* data, size_t length) = 0;
+
+  /**
+   * Writes the specified string to the sink.
+   */
+  bool write(const std::string& text) {
+    return write(text.data(), text.size());
+  }
+
+  /**
+   * Flushes any bytes buffered by the sink to its destination. Returns false on failure.
+   */
+  virtual bool flush() {
+    return true;
+  }
+};
+
+}  // namespace pagx
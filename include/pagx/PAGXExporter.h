@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include "pagx/OutputSink.h"
 #include "pagx/PAGXDocument.h"
 
 namespace pagx {
@@ -47,6 +48,24 @@ class PAGXExporter {
    * The output faithfully reflects the structure of the input document.
    */
   static std::string ToXML(const PAGXDocument& document, const Options& options = {});
+
+  /**
+   * Exports a PAGXDocument as XML to the specified sink. The output is written in bounded chunks
+   * while the document is traversed, and embedded binary data is base64-encoded straight to the
+   * sink, so memory usage does not grow with the size of the output. The written bytes are
+   * identical to the string returned by ToXML(). Returns false if the sink is nullptr or any write
+   * to it fails.
+   */
+  static bool ToStream(const PAGXDocument& document, OutputSink* sink, const Options& options = {});
+
+  /**
+   * Exports a PAGXDocument as XML directly to the file at the specified path, streaming the output
+   * as ToStream() does. The output goes to a temporary file that replaces filePath only after the
+   * whole document has been written, so a failed export leaves an existing file untouched. Returns
+   * false if the file cannot be opened or written.
+   */
+  static bool ToFile(const PAGXDocument& document, const std::string& filePath,
+                     const Options& options = {});
 };
 
 }  // namespace pagx
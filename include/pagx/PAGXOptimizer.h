@@ -52,6 +52,33 @@ class PAGXOptimizer {
      * the convergence signal instead. Useful as a monotonic signal for regression / telemetry.
      */
     int iterationsUsed = 0;
+    /**
+     * Number of layer subtrees removed because opaque layers above them cover them entirely. Only
+     * non-zero when occlusion culling is enabled.
+     */
+    int culledLayers = 0;
+    /**
+     * Number of layer subtrees replaced by a single pre-rasterized image. Only non-zero when static
+     * subtree baking is enabled.
+     */
+    int bakedLayers = 0;
+    /**
+     * Estimated number of draw calls per frame removed by culling and baking, counting one call per
+     * painter, layer style and filter.
+     */
+    int estimatedDrawCallsSaved = 0;
+    /**
+     * Estimated pixel area per frame no longer shaded by culling and baking, in square units of the
+     * affected layers' coordinate spaces. Each saved draw call contributes the area of the bounds
+     * it covered, so overlapping draws are counted once per call.
+     */
+    float estimatedOverdrawSaved = 0.0f;
+    /**
+     * Total number of points in the PathData resources the path simplification pass processed,
+     * before and after the pass. Both are zero when path simplification is disabled.
+     */
+    int pathPointsBefore = 0;
+    int pathPointsAfter = 0;
   };
 
   /**
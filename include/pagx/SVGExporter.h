@@ -20,6 +20,7 @@
 
 #include <string>
 #include <vector>
+#include "pagx/OutputSink.h"
 #include "pagx/PAGXDocument.h"
 
 namespace pagx {
@@ -131,12 +132,25 @@ class SVGExporter {
   static std::string ToSVG(PAGXDocument& document, const Options& options = {},
                            std::vector<std::string>* warnings = nullptr);
 
+  /**
+   * Exports a PAGXDocument as SVG to the specified sink. The document is written in bounded chunks,
+   * and the written bytes are identical to the string returned by ToSVG(). The shared <defs> block
+   * precedes the body in the output, so the body is still buffered until all layers are written.
+   * @param document the PAGXDocument to export. Layout is applied automatically if needed.
+   * @param sink the sink receiving the output.
+   * @param warnings same semantics as ToSVG(); see that method for details.
+   * @return false if the sink is nullptr or any write to it fails.
+   */
+  static bool ToStream(PAGXDocument& document, OutputSink* sink, const Options& options = {},
+                       std::vector<std::string>* warnings = nullptr);
+
   /**
    * Exports a PAGXDocument to an SVG file.
    * @param document the PAGXDocument to export. Passed as non-const because applyLayout() is run
    *        on first use to resolve renderPosition() for layers and groups.
    * @param warnings same semantics as ToSVG(); see that method for details.
-   * @return true on success.
+   * @return true on success. The output is streamed as ToStream() does, to a temporary file that
+   *         replaces filePath only after the whole document has been written.
    */
   static bool ToFile(PAGXDocument& document, const std::string& filePath,
                      const Options& options = {},
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "pagx/nodes/Node.h"
@@ -28,6 +29,8 @@
 
 namespace pagx {
 
+struct PathRenderCache;
+
 /**
  * PathData stores path commands in a format optimized for fast iteration
  * and serialization. Unlike tgfx::Path, it exposes raw data arrays directly.
@@ -151,9 +154,15 @@ class PathData : public Node {
   Rect _cachedBounds = {};
   bool _boundsDirty = true;
 
+  // Lazily-built render cache (the tgfx path shared through PathPool). Hidden behind a PIMPL so
+  // the public header does not expose tgfx types. Dropped whenever the geometry changes. Like
+  // the Font render cache, it is not synchronized: see the contract on LayerBuilder::Build.
+  std::shared_ptr<PathRenderCache> renderCache = nullptr;
+
   friend class PAGXDocument;
   friend class SVGParserContext;
   friend PathData PathDataFromSVGString(const std::string& d);
+  friend class PathPool;
 };
 
 }  // namespace pagx
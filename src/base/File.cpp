@@ -18,19 +18,27 @@
 
 #include "pag/file.h"
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <unordered_map>
 
 namespace pag {
 
+struct LoadingFile {
+  std::condition_variable condition = {};
+  bool finished = false;
+  std::shared_ptr<File> file = nullptr;
+};
+
 static std::mutex globalLocker = {};
 static std::unordered_map<std::string, std::weak_ptr<File>> weakFileMap =
     std::unordered_map<std::string, std::weak_ptr<File>>();
+// The files that are being decoded, concurrent loads of the same path wait for them to finish.
+static std::unordered_map<std::string, std::shared_ptr<LoadingFile>> loadingFileMap =
+    std::unordered_map<std::string, std::shared_ptr<LoadingFile>>();
 
+// Must be called while holding the globalLocker.
 static std::shared_ptr<File> FindFileByPath(const std::string& filePath) {
-  std::lock_guard<std::mutex> autoLock(globalLocker);
-  if (filePath.empty()) {
-    return nullptr;
-  }
   auto result = weakFileMap.find(filePath);
   if (result != weakFileMap.end()) {
     auto& weak = result->second;
@@ -54,28 +62,61 @@ static std::shared_ptr<File> FindFileByPath(const std::string& filePath) {
   return nullptr;
 }
 
-std::shared_ptr<File> File::Load(const std::string& filePath) {
-  auto byteData = ByteData::FromPath(filePath);
-  if (byteData == nullptr) {
-    return nullptr;
+/**
+ * Returns the cached file of the specified path, or calls the loader to load it. If another thread
+ * is loading the same path, waits for it to finish and returns its result instead of loading the
+ * file twice.
+ */
+static std::shared_ptr<File> LoadFileByPath(const std::string& filePath,
+                                            const std::function<std::shared_ptr<File>()>& loader) {
+  if (filePath.empty()) {
+    return loader();
   }
-  return pag::File::Load(byteData->data(), byteData->length(), filePath);
-}
-
-std::shared_ptr<File> File::Load(const void* bytes, size_t length, const std::string& filePath) {
-  auto file = FindFileByPath(filePath);
-  if (file != nullptr) {
-    return file;
+  auto loadingFile = std::make_shared<LoadingFile>();
+  {
+    std::unique_lock<std::mutex> autoLock(globalLocker);
+    auto file = FindFileByPath(filePath);
+    if (file != nullptr) {
+      return file;
+    }
+    auto result = loadingFileMap.find(filePath);
+    if (result != loadingFileMap.end()) {
+      auto pendingFile = result->second;
+      pendingFile->condition.wait(autoLock, [&] { return pendingFile->finished; });
+      return pendingFile->file;
+    }
+    loadingFileMap[filePath] = loadingFile;
   }
-  file = Codec::Decode(bytes, static_cast<uint32_t>(length), filePath);
-  if (file != nullptr) {
+  auto file = loader();
+  {
     std::lock_guard<std::mutex> autoLock(globalLocker);
-    std::weak_ptr<File> weak = file;
-    weakFileMap.insert(std::make_pair(filePath, std::move(weak)));
+    if (file != nullptr) {
+      weakFileMap[filePath] = file;
+    }
+    loadingFileMap.erase(filePath);
+    loadingFile->file = file;
+    loadingFile->finished = true;
   }
+  loadingFile->condition.notify_all();
   return file;
 }
 
+std::shared_ptr<File> File::Load(const std::string& filePath) {
+  return LoadFileByPath(filePath, [&]() -> std::shared_ptr<File> {
+    auto byteData = ByteData::FromPath(filePath);
+    if (byteData == nullptr) {
+      return nullptr;
+    }
+    return Codec::Decode(byteData->data(), static_cast<uint32_t>(byteData->length()), filePath);
+  });
+}
+
+std::shared_ptr<File> File::Load(const void* bytes, size_t length, const std::string& filePath) {
+  return LoadFileByPath(filePath, [&]() {
+    return Codec::Decode(bytes, static_cast<uint32_t>(length), filePath);
+  });
+}
+
 uint16_t File::MaxSupportedTagLevel() {
   return Codec::MaxSupportedTagLevel();
 }
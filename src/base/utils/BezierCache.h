@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace pag {
+/**
+ * BezierCache shares immutable bezier data between all the keyframes that have the same curve. The
+ * entries are split into shards. Each shard publishes an immutable snapshot of its map through an
+ * atomic shared_ptr, so lookups never take a lock, while writers copy the snapshot under the lock
+ * of the shard and publish the new one. New curves are rare once files are decoded, so the copies
+ * are cheap compared to the lookups they keep lock-free. An entry is removed as soon as the last
+ * reference to its value is released, so the cache never holds expired entries. Instances are
+ * intended to be heap-allocated and never destroyed, because cached values may still be released
+ * by other static objects at exit.
+ */
+template <typename Key, typename Value, typename Hasher>
+class BezierCache {
+ public:
+  BezierCache() = default;
+
+  BezierCache(const BezierCache&) = delete;
+
+  BezierCache& operator=(const BezierCache&) = delete;
+
+  /**
+   * Returns the cached value of the specified key, or nullptr if there is none.
+   */
+  std::shared_ptr<Value> find(const Key& key) {
+    auto map = std::atomic_load(&getShard(key).map);
+    auto result = map->find(key);
+    if (result == map->end()) {
+      return nullptr;
+    }
+    return result->second.lock();
+  }
+
+  /**
+   * Takes ownership of the specified value and adds it to the cache. If another thread has added a
+   * value for the same key in the meantime, the specified value is discarded and the cached one is
+   * returned instead.
+   */
+  std::shared_ptr<Value> add(const Key& key, Value* value) {
+    std::shared_ptr<Value> data(value, [this, key](Value* value) {
+      remove(key);
+      delete value;
+    });
+    std::shared_ptr<Value> cachedData = nullptr;
+    {
+      auto& shard = getShard(key);
+      std::lock_guard<std::mutex> autoLock(shard.locker);
+      auto result = shard.map->find(key);
+      if (result != shard.map->end()) {
+        cachedData = result->second.lock();
+      }
+      if (cachedData == nullptr) {
+        auto map = std::make_shared<Map>(*shard.map);
+        (*map)[key] = data;
+        std::atomic_store(&shard.map, std::shared_ptr<const Map>(std::move(map)));
+        return data;
+      }
+    }
+    // The discarded value is released outside the lock, since its deleter locks the shard again.
+    return cachedData;
+  }
+
+ private:
+  static constexpr size_t ShardCount = 16;
+
+  using Map = std::unordered_map<Key, std::weak_ptr<Value>, Hasher>;
+
+  struct Shard {
+    // Guards the writers only. Readers load the snapshot atomically without taking it.
+    std::mutex locker = {};
+    std::shared_ptr<const Map> map = std::make_shared<const Map>();
+  };
+
+  Shard shards[ShardCount];
+
+  Shard& getShard(const Key& key) {
+    // Skips the low bits, which the unordered_map of each shard already uses to pick buckets.
+    return shards[(Hasher()(key) >> 8) % ShardCount];
+  }
+
+  void remove(const Key& key) {
+    auto& shard = getShard(key);
+    std::lock_guard<std::mutex> autoLock(shard.locker);
+    auto result = shard.map->find(key);
+    // The entry may have been replaced by a new value after the old one expired.
+    if (result == shard.map->end() || !result->second.expired()) {
+      return;
+    }
+    auto map = std::make_shared<Map>(*shard.map);
+    map->erase(key);
+    std::atomic_store(&shard.map, std::shared_ptr<const Map>(std::move(map)));
+  }
+};
+}  // namespace pag
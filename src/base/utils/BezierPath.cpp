@@ -17,8 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BezierPath.h"
-#include <mutex>
-#include <unordered_map>
+#include "BezierCache.h"
 
 namespace pag {
 
@@ -122,29 +121,22 @@ size_t BezierHasher::operator()(const pag::BezierKey& key) const {
   return hash;
 }
 
-static std::unordered_map<BezierKey, std::weak_ptr<BezierPath>, BezierHasher> BezierCacheMap =
-    std::unordered_map<BezierKey, std::weak_ptr<BezierPath>, BezierHasher>{};
-static std::mutex locker = {};
+static BezierCache<BezierKey, BezierPath, BezierHasher>* GetBezierPathCache() {
+  static auto cache = new BezierCache<BezierKey, BezierPath, BezierHasher>();
+  return cache;
+}
 
 std::shared_ptr<BezierPath> BezierPath::Build(const pag::Point& start, const pag::Point& control1,
                                               const pag::Point& control2, const pag::Point& end,
                                               float precision) {
   Point points[] = {start, control1, control2, end};
   auto bezierKey = BezierKey::Make(points, precision);
-  {
-    std::lock_guard<std::mutex> autoLock(locker);
-    auto result = BezierCacheMap.find(bezierKey);
-    if (result != BezierCacheMap.end()) {
-      auto& weak = result->second;
-      auto data = weak.lock();
-      if (data) {
-        return data;
-      }
-      BezierCacheMap.erase(result);
-    }
+  auto cache = GetBezierPathCache();
+  auto data = cache->find(bezierKey);
+  if (data) {
+    return data;
   }
-
-  auto bezierPath = std::shared_ptr<BezierPath>(new BezierPath());
+  auto bezierPath = new BezierPath();
   BezierSegment segment = {points[0], 0, 0};
   bezierPath->segments.push_back(segment);
   if (PointOnLine(points[0], points[3], points[1], precision) &&
@@ -156,12 +148,7 @@ std::shared_ptr<BezierPath> BezierPath::Build(const pag::Point& start, const pag
     bezierPath->length =
         BuildCubicSegments(points, 0, 0, MaxBezierTValue, bezierPath->segments, precision);
   }
-  {
-    std::lock_guard<std::mutex> autoLock(locker);
-    std::weak_ptr<BezierPath> weak = bezierPath;
-    BezierCacheMap.insert(std::make_pair(bezierKey, std::move(weak)));
-  }
-  return bezierPath;
+  return cache->add(bezierKey, bezierPath);
 }
 
 Point BezierPath::getPosition(float percent) const {
@@ -17,8 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BezierPath3D.h"
-#include <mutex>
-#include <unordered_map>
+#include "BezierCache.h"
 
 namespace pag {
 
@@ -131,9 +130,10 @@ size_t BezierHasher3D::operator()(const pag::BezierKey3D& key) const {
   return hash;
 }
 
-static std::unordered_map<BezierKey3D, std::weak_ptr<BezierPath3D>, BezierHasher3D> BezierCacheMap =
-    std::unordered_map<BezierKey3D, std::weak_ptr<BezierPath3D>, BezierHasher3D>{};
-static std::mutex locker = {};
+static BezierCache<BezierKey3D, BezierPath3D, BezierHasher3D>* GetBezierPathCache() {
+  static auto cache = new BezierCache<BezierKey3D, BezierPath3D, BezierHasher3D>();
+  return cache;
+}
 
 std::shared_ptr<BezierPath3D> BezierPath3D::Build(const pag::Point3D& start,
                                                   const pag::Point3D& control1,
@@ -141,20 +141,12 @@ std::shared_ptr<BezierPath3D> BezierPath3D::Build(const pag::Point3D& start,
                                                   const pag::Point3D& end, float precision) {
   Point3D points[] = {start, control1, control2, end};
   auto bezierKey = BezierKey3D::Make(points, precision);
-  {
-    std::lock_guard<std::mutex> autoLock(locker);
-    auto result = BezierCacheMap.find(bezierKey);
-    if (result != BezierCacheMap.end()) {
-      auto& weak = result->second;
-      auto data = weak.lock();
-      if (data) {
-        return data;
-      }
-      BezierCacheMap.erase(result);
-    }
+  auto cache = GetBezierPathCache();
+  auto data = cache->find(bezierKey);
+  if (data) {
+    return data;
   }
-
-  auto bezierPath = std::shared_ptr<BezierPath3D>(new BezierPath3D());
+  auto bezierPath = new BezierPath3D();
   BezierSegment3D segment = {points[0], 0, 0};
   bezierPath->segments.push_back(segment);
   if (Point3DOnLine(points[0], points[3], points[1], precision) &&
@@ -166,12 +158,7 @@ std::shared_ptr<BezierPath3D> BezierPath3D::Build(const pag::Point3D& start,
     bezierPath->length =
         BuildCubicSegments(points, 0, 0, MaxBezierTValue, bezierPath->segments, precision);
   }
-  {
-    std::lock_guard<std::mutex> autoLock(locker);
-    std::weak_ptr<BezierPath3D> weak = bezierPath;
-    BezierCacheMap.insert(std::make_pair(bezierKey, std::move(weak)));
-  }
-  return bezierPath;
+  return cache->add(bezierKey, bezierPath);
 }
 
 Point3D BezierPath3D::getPosition(float percent) const {
@@ -0,0 +1,162 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ImagePool.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace pag {
+/**
+ * The encoded bytes are held weakly, the decoded image keeps them alive while it is in use, so an
+ * expired entry does not pin the bytes until the next expiration check.
+ */
+struct EncodedImage {
+  std::weak_ptr<tgfx::Data> data;
+  std::weak_ptr<tgfx::Image> image;
+};
+
+static std::mutex locker = {};
+static std::unordered_multimap<size_t, EncodedImage> encodedImages = {};
+// A mipmapped image keeps its source image alive, so the source address can not be reused while
+// the entry is valid.
+static std::unordered_map<const tgfx::Image*, std::weak_ptr<tgfx::Image>> mipmappedImages = {};
+static size_t expiredCheckCount = 64;
+
+static size_t HashBytes(const void* bytes, size_t length) {
+  return std::hash<std::string_view>()(
+      std::string_view(reinterpret_cast<const char*>(bytes), length));
+}
+
+// Must be called while holding the locker.
+static std::shared_ptr<tgfx::Image> FindEncodedImage(size_t hash, const void* bytes,
+                                                     size_t length) {
+  auto range = encodedImages.equal_range(hash);
+  for (auto item = range.first; item != range.second; ++item) {
+    auto data = item->second.data.lock();
+    if (data == nullptr || data->size() != length || memcmp(data->data(), bytes, length) != 0) {
+      continue;
+    }
+    auto image = item->second.image.lock();
+    if (image != nullptr) {
+      return image;
+    }
+  }
+  return nullptr;
+}
+
+// Must be called while holding the locker.
+static void RemoveExpiredImages() {
+  if (encodedImages.size() + mipmappedImages.size() < expiredCheckCount) {
+    return;
+  }
+  for (auto item = encodedImages.begin(); item != encodedImages.end();) {
+    auto expired = item->second.image.expired() || item->second.data.expired();
+    item = expired ? encodedImages.erase(item) : std::next(item);
+  }
+  for (auto item = mipmappedImages.begin(); item != mipmappedImages.end();) {
+    item = item->second.expired() ? mipmappedImages.erase(item) : std::next(item);
+  }
+  // Checks again after the pool doubles, which keeps the amortized cost of each insertion low.
+  auto count = encodedImages.size() + mipmappedImages.size();
+  expiredCheckCount = std::max(static_cast<size_t>(64), count * 2);
+}
+
+static std::shared_ptr<tgfx::Image> AddEncodedImage(size_t hash, std::shared_ptr<tgfx::Data> data) {
+  auto image = tgfx::Image::MakeFromEncoded(data);
+  if (image == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  // Another thread may have added the same bytes while the image was being created.
+  auto cachedImage = FindEncodedImage(hash, data->data(), data->size());
+  if (cachedImage != nullptr) {
+    return cachedImage;
+  }
+  RemoveExpiredImages();
+  EncodedImage encodedImage = {data, image};
+  encodedImages.emplace(hash, std::move(encodedImage));
+  return image;
+}
+
+std::shared_ptr<tgfx::Image> ImagePool::MakeFromEncoded(const void* bytes, size_t length) {
+  if (bytes == nullptr || length == 0) {
+    return nullptr;
+  }
+  auto hash = HashBytes(bytes, length);
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto image = FindEncodedImage(hash, bytes, length);
+    if (image != nullptr) {
+      return image;
+    }
+  }
+  return AddEncodedImage(hash, tgfx::Data::MakeWithCopy(bytes, length));
+}
+
+std::shared_ptr<tgfx::Image> ImagePool::MakeFromEncoded(std::shared_ptr<tgfx::Data> data) {
+  if (data == nullptr || data->empty()) {
+    return nullptr;
+  }
+  auto hash = HashBytes(data->data(), data->size());
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto image = FindEncodedImage(hash, data->data(), data->size());
+    if (image != nullptr) {
+      return image;
+    }
+  }
+  return AddEncodedImage(hash, std::move(data));
+}
+
+std::shared_ptr<tgfx::Image> ImagePool::MakeFromFile(const std::string& filePath) {
+  if (filePath.empty()) {
+    return nullptr;
+  }
+  // Files are matched by their bytes rather than by path, size or modification time, so a file
+  // rewritten in place never returns the image decoded from its old contents.
+  auto data = tgfx::Data::MakeFromFile(filePath);
+  if (data == nullptr) {
+    // Some platforms resolve paths that can not be read directly, such as Android assets.
+    return tgfx::Image::MakeFromFile(filePath);
+  }
+  return MakeFromEncoded(std::move(data));
+}
+
+std::shared_ptr<tgfx::Image> ImagePool::MakeMipmapped(std::shared_ptr<tgfx::Image> image) {
+  if (image == nullptr || image->hasMipmaps()) {
+    return image;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = mipmappedImages.find(image.get());
+  if (result != mipmappedImages.end()) {
+    auto mipmappedImage = result->second.lock();
+    if (mipmappedImage != nullptr) {
+      return mipmappedImage;
+    }
+  }
+  RemoveExpiredImages();
+  auto mipmappedImage = image->makeMipmapped(true);
+  if (mipmappedImage != nullptr && mipmappedImage != image) {
+    mipmappedImages[image.get()] = mipmappedImage;
+  }
+  return mipmappedImage;
+}
+}  // namespace pag
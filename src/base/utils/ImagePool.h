@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Image.h"
+
+namespace pag {
+/**
+ * ImagePool shares decoded images process-wide between all the PAG files, PAGImages and PAGX
+ * documents that embed identical image bytes or reference the same image file. Images are matched
+ * by content rather than by owner, so they also share the decoded pixels and the GPU textures built
+ * from them. The pool only holds weak references, an image is released as soon as its last user
+ * goes away.
+ */
+class ImagePool {
+ public:
+  /**
+   * Returns an image for the specified encoded bytes, shared with any live image created from
+   * identical bytes. The bytes are only copied if there is no such image yet. Returns nullptr if
+   * the bytes can not be decoded.
+   */
+  static std::shared_ptr<tgfx::Image> MakeFromEncoded(const void* bytes, size_t length);
+
+  /**
+   * Returns an image for the specified encoded data, shared with any live image created from
+   * identical bytes. Returns nullptr if the data can not be decoded.
+   */
+  static std::shared_ptr<tgfx::Image> MakeFromEncoded(std::shared_ptr<tgfx::Data> data);
+
+  /**
+   * Returns an image for the specified file path, shared with any live image created from identical
+   * bytes. The file is read and matched by its contents, so a file rewritten in place is decoded
+   * again. Returns nullptr if the file can not be decoded.
+   */
+  static std::shared_ptr<tgfx::Image> MakeFromFile(const std::string& filePath);
+
+  /**
+   * Returns a mipmapped version of the specified image, shared with any live mipmapped version
+   * created from the same image, so users of a shared image also share its mipmapped texture.
+   */
+  static std::shared_ptr<tgfx::Image> MakeMipmapped(std::shared_ptr<tgfx::Image> image);
+};
+}  // namespace pag
@@ -0,0 +1,303 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Tracer.h"
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+static constexpr size_t TRACE_BUFFER_CAPACITY = 16384;
+// The maximum number of threads recording at the same time, threads beyond it record nothing.
+static constexpr size_t MAX_TRACE_BUFFERS = 32;
+// The maximum number of spans kept from exited threads, the oldest ones are dropped beyond it.
+static constexpr size_t MAX_RETAINED_SPANS = TRACE_BUFFER_CAPACITY * 4;
+
+/**
+ * A slot of the ring buffer. The fields are atomics so that DumpJSON() can read slots the owning
+ * thread is writing at the same time. The sequence is odd while the slot is being written and
+ * 2 * (index + 1) once the event of that index is published.
+ */
+struct TraceEvent {
+  std::atomic<uint64_t> sequence = {0};
+  std::atomic<const char*> name = {nullptr};
+  std::atomic<int64_t> startTime = {0};
+  std::atomic<int64_t> duration = {0};
+  std::atomic<int64_t> arg = {-1};
+};
+
+struct TraceBuffer {
+  TraceBuffer() : events(TRACE_BUFFER_CAPACITY) {
+  }
+
+  std::atomic<uint32_t> threadID = {0};
+  std::vector<TraceEvent> events;
+  // Only the owning thread writes writeIndex, clearIndex is written under bufferLocker.
+  std::atomic<uint64_t> writeIndex = {0};
+  std::atomic<uint64_t> clearIndex = {0};
+  // Set while a thread owns the buffer, written under bufferLocker.
+  bool inUse = false;
+};
+
+/**
+ * A span copied out of a ring buffer.
+ */
+struct TraceSpan {
+  const char* name = nullptr;
+  int64_t startTime = 0;
+  int64_t duration = 0;
+  int64_t arg = -1;
+  uint32_t threadID = 0;
+};
+
+static std::atomic<bool> traceEnabled = {false};
+static std::mutex bufferLocker = {};
+static std::vector<std::unique_ptr<TraceBuffer>> allBuffers = {};
+// Spans of exited threads, moved out of their buffers before the buffers are reused.
+static std::deque<TraceSpan> retainedSpans = {};
+static uint32_t nextThreadID = 1;
+
+// Must be called while holding the bufferLocker. Copies the spans recorded since the last clear
+// into spans, and discards them from the buffer if clear is true.
+static void CollectSpans(TraceBuffer* buffer, bool clear, std::vector<TraceSpan>* spans) {
+  auto endIndex = buffer->writeIndex.load(std::memory_order_acquire);
+  auto startIndex = buffer->clearIndex.load(std::memory_order_relaxed);
+  if (endIndex - startIndex > TRACE_BUFFER_CAPACITY) {
+    startIndex = endIndex - TRACE_BUFFER_CAPACITY;
+  }
+  auto threadID = buffer->threadID.load(std::memory_order_relaxed);
+  for (auto index = startIndex; index < endIndex; index++) {
+    auto& slot = buffer->events[index % TRACE_BUFFER_CAPACITY];
+    auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != index * 2 + 2) {
+      // The owning thread has overwritten the slot with a newer event meanwhile.
+      continue;
+    }
+    TraceSpan span = {};
+    span.name = slot.name.load(std::memory_order_relaxed);
+    span.startTime = slot.startTime.load(std::memory_order_relaxed);
+    span.duration = slot.duration.load(std::memory_order_relaxed);
+    span.arg = slot.arg.load(std::memory_order_relaxed);
+    span.threadID = threadID;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence || span.name == nullptr) {
+      continue;
+    }
+    spans->push_back(span);
+  }
+  if (clear) {
+    buffer->clearIndex.store(endIndex, std::memory_order_relaxed);
+  }
+}
+
+// Must be called while holding the bufferLocker.
+static void RetainSpans(TraceBuffer* buffer) {
+  std::vector<TraceSpan> spans = {};
+  CollectSpans(buffer, true, &spans);
+  retainedSpans.insert(retainedSpans.end(), spans.begin(), spans.end());
+  while (retainedSpans.size() > MAX_RETAINED_SPANS) {
+    retainedSpans.pop_front();
+  }
+}
+
+static TraceBuffer* AcquireBuffer() {
+  std::lock_guard<std::mutex> autoLock(bufferLocker);
+  TraceBuffer* result = nullptr;
+  for (auto& buffer : allBuffers) {
+    if (!buffer->inUse) {
+      // The spans of the exited thread have been moved to retainedSpans already.
+      result = buffer.get();
+      break;
+    }
+  }
+  if (result == nullptr) {
+    if (allBuffers.size() >= MAX_TRACE_BUFFERS) {
+      return nullptr;
+    }
+    allBuffers.push_back(std::make_unique<TraceBuffer>());
+    result = allBuffers.back().get();
+  }
+  result->inUse = true;
+  result->threadID.store(nextThreadID++, std::memory_order_relaxed);
+  return result;
+}
+
+/**
+ * Hands the buffer of a thread back to the pool when the thread exits.
+ */
+class ThreadBufferHolder {
+ public:
+  ~ThreadBufferHolder() {
+    if (buffer != nullptr) {
+      std::lock_guard<std::mutex> autoLock(bufferLocker);
+      RetainSpans(buffer);
+      buffer->inUse = false;
+    }
+  }
+
+  TraceBuffer* get() {
+    if (!acquired) {
+      acquired = true;
+      buffer = AcquireBuffer();
+    }
+    return buffer;
+  }
+
+ private:
+  bool acquired = false;
+  TraceBuffer* buffer = nullptr;
+};
+
+static TraceBuffer* GetThreadBuffer() {
+  thread_local ThreadBufferHolder holder = {};
+  return holder.get();
+}
+
+bool Tracer::IsEnabled() {
+  return traceEnabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::SetEnabled(bool enabled) {
+  traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::Record(const char* name, int64_t startTime, int64_t duration, int64_t arg) {
+  auto buffer = GetThreadBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+  auto index = buffer->writeIndex.load(std::memory_order_relaxed);
+  auto& event = buffer->events[index % TRACE_BUFFER_CAPACITY];
+  event.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.name.store(name, std::memory_order_relaxed);
+  event.startTime.store(startTime, std::memory_order_relaxed);
+  event.duration.store(duration, std::memory_order_relaxed);
+  event.arg.store(arg, std::memory_order_relaxed);
+  event.sequence.store(index * 2 + 2, std::memory_order_release);
+  buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+// Copies all spans recorded so far under one lock, and discards them if clear is true, so spans
+// recorded concurrently are either returned or kept for the next call, but never lost.
+static std::vector<TraceSpan> TakeSpans(bool clear) {
+  std::vector<TraceSpan> spans = {};
+  std::lock_guard<std::mutex> autoLock(bufferLocker);
+  spans.insert(spans.end(), retainedSpans.begin(), retainedSpans.end());
+  if (clear) {
+    retainedSpans.clear();
+  }
+  for (auto& buffer : allBuffers) {
+    CollectSpans(buffer.get(), clear, &spans);
+  }
+  return spans;
+}
+
+void Tracer::Clear() {
+  std::lock_guard<std::mutex> autoLock(bufferLocker);
+  retainedSpans.clear();
+  for (auto& buffer : allBuffers) {
+    buffer->clearIndex.store(buffer->writeIndex.load(std::memory_order_acquire),
+                             std::memory_order_relaxed);
+  }
+}
+
+static void AppendEscapedName(std::string* json, const char* name) {
+  for (auto c = name; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      json->push_back('\\');
+    }
+    json->push_back(*c);
+  }
+}
+
+static std::string ToJSON(const std::vector<TraceSpan>& spans) {
+  std::string json = "{\"traceEvents\":[";
+  char text[128];
+  for (size_t i = 0; i < spans.size(); i++) {
+    auto& span = spans[i];
+    if (i > 0) {
+      json += ",";
+    }
+    json += "{\"name\":\"";
+    AppendEscapedName(&json, span.name);
+    snprintf(text, sizeof(text), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lld,\"dur\":%lld",
+             span.threadID, static_cast<long long>(span.startTime),
+             static_cast<long long>(span.duration));
+    json += text;
+    if (span.arg >= 0) {
+      snprintf(text, sizeof(text), ",\"args\":{\"id\":%lld}", static_cast<long long>(span.arg));
+      json += text;
+    }
+    json += "}";
+  }
+  json += "],\"displayTimeUnit\":\"ms\"}";
+  return json;
+}
+
+static bool WriteFile(const std::string& filePath, const std::string& json) {
+  auto file = fopen(filePath.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  auto written = fwrite(json.data(), 1, json.size(), file);
+  fclose(file);
+  return written == json.size();
+}
+
+std::string Tracer::DumpJSON() {
+  return ToJSON(TakeSpans(false));
+}
+
+bool Tracer::DumpJSON(const std::string& filePath) {
+  return WriteFile(filePath, DumpJSON());
+}
+
+bool Tracer::DumpJSON(const std::string& filePath, bool clear) {
+  if (!clear) {
+    return DumpJSON(filePath);
+  }
+  auto spans = TakeSpans(true);
+  if (WriteFile(filePath, ToJSON(spans))) {
+    return true;
+  }
+  // Puts the spans back in front of the ones recorded meanwhile, so a failed dump loses nothing.
+  std::lock_guard<std::mutex> autoLock(bufferLocker);
+  retainedSpans.insert(retainedSpans.begin(), spans.begin(), spans.end());
+  while (retainedSpans.size() > MAX_RETAINED_SPANS) {
+    retainedSpans.pop_front();
+  }
+  return false;
+}
+
+TraceScope::TraceScope(const char* name, int64_t arg) : name(name), arg(arg) {
+  if (Tracer::IsEnabled()) {
+    startTime = tgfx::Clock::Now();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (startTime >= 0) {
+    Tracer::Record(name, startTime, tgfx::Clock::Now() - startTime, arg);
+  }
+}
+}  // namespace pag
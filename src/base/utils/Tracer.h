@@ -0,0 +1,114 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace pag {
+/**
+ * Tracer records timing spans into lock-free per-thread ring buffers and exports them in the Chrome
+ * trace event format, which can be opened by chrome://tracing or https://ui.perfetto.dev. Spans
+ * recorded on the same thread nest by time, so the exported trace shows the full call hierarchy of
+ * each frame. Only the most recent spans of each thread are kept once its ring buffer is full. When
+ * a thread exits, its spans are moved out of its buffer, so the buffer can be reused by the next
+ * thread that starts recording while the spans are still dumped.
+ *
+ * Spans are usually recorded through the TRACE_SCOPE() macros, which compile to nothing unless
+ * PAG_USE_TRACE is defined. Recording is disabled at runtime by default, call SetEnabled(true) to
+ * start it. Apps control it through PAG::SetTraceEnabled() and PAG::DumpTrace().
+ */
+class Tracer {
+ public:
+  /**
+   * Returns true if spans are being recorded.
+   */
+  static bool IsEnabled();
+
+  /**
+   * Starts or stops recording spans.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Records a finished span on the calling thread. The name must be a string literal or any other
+   * string that lives as long as the process. Times are in microseconds. Pass a negative arg if the
+   * span has no associated ID.
+   */
+  static void Record(const char* name, int64_t startTime, int64_t duration, int64_t arg = -1);
+
+  /**
+   * Discards all spans recorded so far.
+   */
+  static void Clear();
+
+  /**
+   * Returns all spans recorded so far as a Chrome trace JSON string.
+   */
+  static std::string DumpJSON();
+
+  /**
+   * Writes all spans recorded so far to the specified file as Chrome trace JSON. Returns false if
+   * the file cannot be written.
+   */
+  static bool DumpJSON(const std::string& filePath);
+
+  /**
+   * Writes all spans recorded so far to the specified file as Chrome trace JSON. If clear is true,
+   * the written spans are taken out of the buffers under the same lock that collects them, so spans
+   * recorded during the dump are kept for the next one instead of being cleared unwritten. Returns
+   * false if the file cannot be written, the spans are then kept.
+   */
+  static bool DumpJSON(const std::string& filePath, bool clear);
+};
+
+/**
+ * TraceScope records a span covering its own lifetime.
+ */
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name, int64_t arg = -1);
+
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* name = nullptr;
+  int64_t arg = -1;
+  int64_t startTime = -1;
+};
+
+#ifdef PAG_USE_TRACE
+
+#define PAG_TRACE_CONCAT_INNER(a, b) a##b
+#define PAG_TRACE_CONCAT(a, b) PAG_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) ::pag::TraceScope PAG_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_SCOPE_ID(name, id) \
+  ::pag::TraceScope PAG_TRACE_CONCAT(traceScope, __LINE__)(name, static_cast<int64_t>(id))
+
+#else
+
+#define TRACE_SCOPE(name)
+#define TRACE_SCOPE_ID(name, id)
+
+#endif
+}  // namespace pag
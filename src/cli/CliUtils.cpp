@@ -21,6 +21,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include "pagx/PAGXExporter.h"
 #include "pagx/PAGXImporter.h"
 
 namespace pagx::cli {
@@ -82,6 +83,20 @@ bool LoadFontConfig(FontConfig* fontConfig, const std::vector<std::string>& font
   return true;
 }
 
+static bool ReplaceWithTempFile(const std::string& tempPath, const std::string& filePath,
+                                const std::string& command) {
+  std::error_code ec;
+  std::filesystem::rename(tempPath, filePath, ec);
+  if (ec) {
+    std::cerr << command << ": failed to write '" << filePath
+              << "' (replacing output file failed)\n";
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  std::cout << command << ": wrote " << filePath << "\n";
+  return true;
+}
+
 bool WriteStringToFile(const std::string& content, const std::string& filePath,
                        const std::string& command) {
   auto tempPath = filePath + ".tmp";
@@ -100,12 +115,15 @@ bool WriteStringToFile(const std::string& content, const std::string& filePath,
       return false;
     }
   }
-  std::error_code ec;
-  std::filesystem::rename(tempPath, filePath, ec);
-  if (ec) {
-    std::cerr << command << ": failed to write '" << filePath
-              << "' (replacing output file failed)\n";
-    std::remove(tempPath.c_str());
+  return ReplaceWithTempFile(tempPath, filePath, command);
+}
+
+bool WriteDocumentToFile(const PAGXDocument& document, const std::string& filePath,
+                         const std::string& command) {
+  // PAGXExporter::ToFile() writes through a temporary file itself, so a failed export leaves any
+  // existing file untouched.
+  if (!PAGXExporter::ToFile(document, filePath)) {
+    std::cerr << command << ": failed to write '" << filePath << "'\n";
     return false;
   }
   std::cout << command << ": wrote " << filePath << "\n";
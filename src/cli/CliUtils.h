@@ -243,4 +243,11 @@ bool LoadFontConfig(FontConfig* fontConfig, const std::vector<std::string>& font
 bool WriteStringToFile(const std::string& content, const std::string& filePath,
                        const std::string& command);
 
+/**
+ * Exports a document as PAGX XML, streaming it to disk without building the whole XML string in
+ * memory. Errors and the success message are printed the same way as WriteStringToFile().
+ */
+bool WriteDocumentToFile(const PAGXDocument& document, const std::string& filePath,
+                         const std::string& command);
+
 }  // namespace pagx::cli
@@ -22,7 +22,6 @@
 #include <vector>
 #include "cli/CliUtils.h"
 #include "pagx/FontConfig.h"
-#include "pagx/PAGXExporter.h"
 #include "pagx/nodes/Font.h"
 #include "renderer/FontEmbedder.h"
 #include "renderer/ImageEmbedder.h"
@@ -148,8 +147,7 @@ int RunEmbed(int argc, char* argv[]) {
     }
   }
 
-  auto xml = PAGXExporter::ToXML(*document);
-  if (!WriteStringToFile(xml, options.outputFile, "pagx embed")) {
+  if (!WriteDocumentToFile(*document, options.outputFile, "pagx embed")) {
     return 1;
   }
   return 0;
@@ -36,7 +36,6 @@
 #include "cli/CommandResolve.h"
 #include "cli/ImageStorage.h"
 #include "pagx/HTMLImporter.h"
-#include "pagx/PAGXExporter.h"
 #include "pagx/PAGXOptimizer.h"
 #include "pagx/SVGImporter.h"
 
@@ -533,8 +532,7 @@ int RunImport(int argc, char* argv[]) {
     ApplyImageStorage(result.document.get(), imageOptions, "pagx import");
   }
 
-  auto xml = PAGXExporter::ToXML(*result.document);
-  if (!WriteStringToFile(xml, options.outputFile, "pagx import")) {
+  if (!WriteDocumentToFile(*result.document, options.outputFile, "pagx import")) {
     return 1;
   }
 
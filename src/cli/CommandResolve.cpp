@@ -18,7 +18,6 @@
 
 #include "cli/CommandResolve.h"
 #include <cmath>
-#include <fstream>
 #include <iostream>
 #include <string>
 #include <unordered_set>
@@ -419,13 +418,10 @@ int RunResolve(int argc, char* argv[]) {
     ApplyImageStorage(doc.get(), imageOptions, "pagx resolve");
   }
 
-  auto xml = PAGXExporter::ToXML(*doc);
-  std::ofstream out(options.outputFile);
-  if (!out.is_open()) {
+  if (!PAGXExporter::ToFile(*doc, options.outputFile)) {
     std::cerr << "pagx resolve: error: failed to write '" << options.outputFile << "'\n";
     return 1;
   }
-  out << xml;
 
   std::cout << "pagx resolve: resolved " << resolvedCount << " import(s)";
   if (errorCount > 0) {
@@ -140,7 +140,8 @@ static std::unique_ptr<ByteData> ConcatMP4(const VideoSequence* videoSequence) {
   return payload.release();
 }
 
-static std::unique_ptr<ByteData> MakeMP4Data(const VideoSequence* videoSequence, bool includeMdat) {
+std::unique_ptr<ByteData> MP4BoxHelper::MakeMP4Data(const VideoSequence* videoSequence,
+                                                     bool includeMdat, bool twoPass) {
   auto mp4Track = MakeMP4Track(videoSequence);
   if (!mp4Track || mp4Track->len == 0) {
     return nullptr;
@@ -160,7 +161,7 @@ static std::unique_ptr<ByteData> MakeMP4Data(const VideoSequence* videoSequence,
   EncodeStream stream(nullptr,
                       static_cast<uint32_t>(static_cast<float>(mp4Track->len) * sizeFactor));
   stream.setByteOrder(tgfx::ByteOrder::BigEndian);
-  MP4Generator mp4Generator(boxParam);
+  MP4Generator mp4Generator(boxParam, twoPass);
   mp4Generator.ftyp(&stream, true);
   mp4Generator.moov(&stream, true);
   mp4Generator.moof(&stream, true);
@@ -180,4 +181,23 @@ std::unique_ptr<ByteData> MP4BoxHelper::CovertToMP4(const VideoSequence* videoSe
 void MP4BoxHelper::WriteMP4Header(VideoSequence* videoSequence) {
   videoSequence->MP4Header = MakeMP4Data(videoSequence, false).release();
 }
+
+bool MP4BoxHelper::WriteMP4(const VideoSequence* videoSequence, FILE* file) {
+  if (file == nullptr) {
+    return false;
+  }
+  std::unique_ptr<ByteData> headerData = nullptr;
+  const ByteData* header = videoSequence->MP4Header;
+  if (header == nullptr) {
+    headerData = MakeMP4Data(videoSequence, false);
+    header = headerData.get();
+  }
+  if (header == nullptr || fwrite(header->data(), 1, header->length(), file) != header->length()) {
+    return false;
+  }
+  BoxParam boxParam;
+  boxParam.videoSequence = videoSequence;
+  MP4Generator mp4Generator(boxParam);
+  return mp4Generator.mdat(file) > 0;
+}
 }  // namespace pag
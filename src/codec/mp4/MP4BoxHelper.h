@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstdio>
 #include <memory>
 #include "pag/file.h"
 
@@ -33,5 +34,16 @@ class MP4BoxHelper {
    * Creates mp4 header box data, and writes into VideoSequence mp4Header member
    */
   static void WriteMP4Header(VideoSequence* videoSequence);
+
+  /**
+   * Muxes h264 data in VideoSequence and writes the mp4 data into the file at its current position.
+   * The samples are streamed into the file without being buffered in memory. Returns false if the
+   * file cannot be written.
+   */
+  static bool WriteMP4(const VideoSequence* videoSequence, FILE* file);
+
+ private:
+  static std::unique_ptr<ByteData> MakeMP4Data(const VideoSequence* videoSequence, bool includeMdat,
+                                               bool twoPass = false);
 };
 }  // namespace pag
@@ -28,7 +28,32 @@ namespace pag {
 static const char* VIDEO = "video";
 static const char* AUDIO = "audio";
 
-MP4Generator::MP4Generator(BoxParam param) : param(std::move(param)) {
+MP4Generator::MP4Generator(BoxParam param, bool twoPass)
+    : param(std::move(param)), twoPass(twoPass) {
+}
+
+static void PatchInt32(EncodeStream* stream, uint32_t position, int32_t value) {
+  auto currentPosition = stream->position();
+  stream->setPosition(position);
+  stream->writeInt32(value);
+  stream->setPosition(currentPosition);
+}
+
+static bool WriteInt32(FILE* file, int32_t value) {
+  auto data = static_cast<uint32_t>(value);
+  uint8_t bytes[4] = {static_cast<uint8_t>(data >> 24), static_cast<uint8_t>(data >> 16),
+                      static_cast<uint8_t>(data >> 8), static_cast<uint8_t>(data)};
+  return fwrite(bytes, 1, 4, file) == 4;
+}
+
+static bool WriteNalu(FILE* file, const ByteData* nalu) {
+  // Replaces the 4-byte start code with the payload size.
+  auto payloadSize = static_cast<int32_t>(nalu->length()) - 4;
+  if (!WriteInt32(file, payloadSize)) {
+    return false;
+  }
+  auto length = static_cast<size_t>(payloadSize);
+  return fwrite(nalu->data() + 4, 1, length, file) == length;
 }
 
 static int WriteCharCode(EncodeStream* stream, std::string stringData, bool write) {
@@ -96,7 +121,12 @@ int MP4Generator::moof(EncodeStream* stream, bool write) {
   writeFun.reserve(2);
   PushInWriteFun(mfhd);
   PushInWriteFun(traf);
-  return box(stream, "moof", writeFun, write);
+  auto size = box(stream, "moof", writeFun, write);
+  if (!twoPass && write) {
+    // The samples start right after the moof box and the header of the mdat box.
+    PatchInt32(stream, dataOffsetPosition, size + 8);
+  }
+  return size;
 }
 
 int MP4Generator::mdat(EncodeStream* stream, bool write) {
@@ -106,6 +136,33 @@ int MP4Generator::mdat(EncodeStream* stream, bool write) {
   return box(stream, "mdat", writeFun, write);
 }
 
+int MP4Generator::mdat(FILE* file) const {
+  if (file == nullptr || param.videoSequence == nullptr) {
+    return 0;
+  }
+  auto start = ftell(file);
+  if (start < 0 || !WriteInt32(file, 0) || fwrite("mdat", 1, 4, file) != 4) {
+    return 0;
+  }
+  for (const auto* header : param.videoSequence->headers) {
+    if (!WriteNalu(file, header)) {
+      return 0;
+    }
+  }
+  for (const auto* frame : param.videoSequence->frames) {
+    if (!WriteNalu(file, frame->fileBytes)) {
+      return 0;
+    }
+  }
+  auto end = ftell(file);
+  auto size = static_cast<int32_t>(end - start);
+  if (fseek(file, start, SEEK_SET) != 0 || !WriteInt32(file, size) ||
+      fseek(file, end, SEEK_SET) != 0) {
+    return 0;
+  }
+  return size;
+}
+
 int MP4Generator::hdlr(EncodeStream* stream, bool write) {
   std::vector<std::function<int(EncodeStream*, bool)>> writeFun;
   writeFun.reserve(1);
@@ -529,8 +586,10 @@ int MP4Generator::tkhd(EncodeStream* stream, bool write) {
 int MP4Generator::traf(EncodeStream* stream, bool write) {
   std::vector<std::function<int(EncodeStream*, bool)>> writeFun;
   writeFun.reserve(4);
-  int sdtpLen = sdtp(stream, false);
-  param.offset = sdtpLen + 72;
+  if (twoPass) {
+    int sdtpLen = sdtp(stream, false);
+    param.offset = sdtpLen + 72;
+  }
   PushInWriteFun(tfhd);
   PushInWriteFun(tfdt);
   PushInWriteFun(trun);
@@ -646,6 +705,8 @@ int MP4Generator::trun(EncodeStream* stream, bool write) {
     }
     stream->writeInt32(0x00000f01);
     stream->writeInt32(len);
+    // In single-pass mode, the data offset is back-patched in moof().
+    dataOffsetPosition = stream->position();
     stream->writeInt32(param.offset);
 
     for (auto& sample : samples) {
@@ -742,6 +803,17 @@ int MP4Generator::stss(EncodeStream* stream, bool write) {
 int MP4Generator::box(EncodeStream* stream, const std::string& type,
                       const std::vector<std::function<int(EncodeStream*, bool)>>& boxFunctions,
                       bool write) {
+  if (!twoPass && write) {
+    auto start = stream->position();
+    stream->writeInt32(0);
+    WriteCharCode(stream, type, true);
+    for (const auto& writeStreamFun : boxFunctions) {
+      writeStreamFun(stream, true);
+    }
+    auto size = static_cast<int>(stream->position() - start);
+    PatchInt32(stream, start, size);
+    return size;
+  }
   int size = 8;
   auto iter = boxSizeMap.find(type);
   if (iter != boxSizeMap.end()) {
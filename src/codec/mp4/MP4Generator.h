@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -71,15 +72,27 @@ struct BoxParam {
   std::vector<std::shared_ptr<MP4Track>> tracks;
 };
 
+/**
+ * MP4Generator writes the boxes in a single pass by default: the size field of each box is reserved
+ * and back-patched after its children are written, so every box is visited only once. If twoPass is
+ * true, each box is measured before it is written instead, which produces the same bytes.
+ */
 class MP4Generator {
  public:
-  explicit MP4Generator(BoxParam param);
+  explicit MP4Generator(BoxParam param, bool twoPass = false);
 
   int ftyp(EncodeStream* stream, bool write = false);
   int moov(EncodeStream* stream, bool write = false);
   int moof(EncodeStream* stream, bool write = false);
   int mdat(EncodeStream* stream, bool write = false);
 
+  /**
+   * Streams the mdat box into the file at its current position without buffering the samples in
+   * memory. The size field is back-patched after all samples are written. Returns the size of the
+   * box, or 0 if the file cannot be written.
+   */
+  int mdat(FILE* file) const;
+
  private:
   int mvhd(EncodeStream* stream, bool write = false);
   int mvex(EncodeStream* stream, bool write = false);
@@ -119,6 +132,9 @@ class MP4Generator {
 
   std::unordered_map<std::string, int> boxSizeMap;
   BoxParam param;
+  bool twoPass = false;
+  // The position of the data offset field in the trun box, which is back-patched in moof().
+  uint32_t dataOffsetPosition = 0;
 };
 
 }  // namespace pag
@@ -0,0 +1,138 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pagx/OutputSink.h"
+#include <cerrno>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace pagx {
+
+class FileSink : public OutputSink {
+ public:
+  explicit FileSink(FILE* file) : file(file) {
+  }
+
+  ~FileSink() override {
+    fclose(file);
+  }
+
+  bool write(const void* data, size_t length) override {
+    return fwrite(data, 1, length, file) == length;
+  }
+
+  bool flush() override {
+    return fflush(file) == 0;
+  }
+
+ private:
+  FILE* file = nullptr;
+};
+
+class FileDescriptorSink : public OutputSink {
+ public:
+  explicit FileDescriptorSink(int fd) : fd(fd) {
+  }
+
+  bool write(const void* data, size_t length) override {
+    auto bytes = static_cast<const char*>(data);
+    while (length > 0) {
+#ifdef _WIN32
+      auto written = _write(fd, bytes, static_cast<unsigned>(length));
+#else
+      auto written = ::write(fd, bytes, length);
+#endif
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      bytes += written;
+      length -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+ private:
+  int fd = -1;
+};
+
+class CallbackSink : public OutputSink {
+ public:
+  explicit CallbackSink(std::function<bool(const void*, size_t)> callback)
+      : callback(std::move(callback)) {
+  }
+
+  bool write(const void* data, size_t length) override {
+    return callback(data, length);
+  }
+
+ private:
+  std::function<bool(const void*, size_t)> callback = nullptr;
+};
+
+class StringSink : public OutputSink {
+ public:
+  explicit StringSink(std::string* output) : output(output) {
+  }
+
+  bool write(const void* data, size_t length) override {
+    output->append(static_cast<const char*>(data), length);
+    return true;
+  }
+
+ private:
+  std::string* output = nullptr;
+};
+
+std::unique_ptr<OutputSink> OutputSink::MakeFromFile(const std::string& filePath) {
+  auto file = fopen(filePath.c_str(), "wb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<FileSink>(file);
+}
+
+std::unique_ptr<OutputSink> OutputSink::MakeFromFileDescriptor(int fd) {
+  if (fd < 0) {
+    return nullptr;
+  }
+  return std::make_unique<FileDescriptorSink>(fd);
+}
+
+std::unique_ptr<OutputSink> OutputSink::MakeFromCallback(
+    std::function<bool(const void* data, size_t length)> callback) {
+  if (callback == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<CallbackSink>(std::move(callback));
+}
+
+std::unique_ptr<OutputSink> OutputSink::MakeFromString(std::string* output) {
+  if (output == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<StringSink>(output);
+}
+
+}  // namespace pagx
@@ -18,6 +18,7 @@
 
 #include "pagx/PAGScene.h"
 #include "base/utils/Log.h"
+#include "base/utils/Tracer.h"
 #include "pagx/DataBindRuntime.h"
 #include "pagx/DataContext.h"
 #include "pagx/PAGAnimation.h"
@@ -512,6 +513,7 @@ std::shared_ptr<PAGComposition> PAGScene::rootComposition() const {
 }
 
 bool PAGScene::draw(const std::shared_ptr<PAGSurface>& surface, bool autoClear) {
+  TRACE_SCOPE("PAGScene::draw");
   if (surface == nullptr || surface->drawable == nullptr) {
     return false;
   }
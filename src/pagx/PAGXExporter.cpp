@@ -72,7 +72,7 @@
 #include "pagx/nodes/ViewModel.h"
 #include "pagx/nodes/ViewModelProperty.h"
 #include "pagx/svg/SVGPathParser.h"
-#include "pagx/utils/Base64.h"
+#include "pagx/utils/ExporterUtils.h"
 #include "pagx/utils/ImageMime.h"
 #include "pagx/utils/StringParser.h"
 #include "pagx/xml/XMLBuilder.h"
@@ -627,8 +627,7 @@ static void WriteColorSource(XMLBuilder& xml, const ColorSource* node) {
         } else if (pattern->image->data) {
           const auto* bytes = pattern->image->data->bytes();
           auto size = pattern->image->data->size();
-          xml.addAttribute("image", std::string("data:") + DetectImageMimeOrPNG(bytes, size) +
-                                        ";base64," + Base64Encode(bytes, size));
+          xml.addDataURIAttribute("image", DetectImageMimeOrPNG(bytes, size), bytes, size);
         }
       }
       if (pattern->tileModeX != Default<ImagePattern>().tileModeX) {
@@ -1394,8 +1393,7 @@ static void WriteResource(XMLBuilder& xml, const Node* node, const Options& opti
       } else if (image->data) {
         const auto* bytes = image->data->bytes();
         auto size = image->data->size();
-        xml.addAttribute("source", std::string("data:") + DetectImageMimeOrPNG(bytes, size) +
-                                       ";base64," + Base64Encode(bytes, size));
+        xml.addDataURIAttribute("source", DetectImageMimeOrPNG(bytes, size), bytes, size);
       } else {
         // `source` is a required attribute (see pagx.xsd). An unresolved image — e.g. an `<img>`
         // whose `src` was missing/invalid at HTML import time, preserved so the element is not
@@ -1488,8 +1486,7 @@ static void WriteResource(XMLBuilder& xml, const Node* node, const Options& opti
             } else if (glyph->image->data) {
               const auto* bytes = glyph->image->data->bytes();
               auto size = glyph->image->data->size();
-              xml.addAttribute("image", std::string("data:") + DetectImageMimeOrPNG(bytes, size) +
-                                            ";base64," + Base64Encode(bytes, size));
+              xml.addDataURIAttribute("image", DetectImageMimeOrPNG(bytes, size), bytes, size);
             }
           }
           if (glyph->offset != Default<Glyph>().offset) {
@@ -1764,8 +1761,7 @@ static void WriteLayer(XMLBuilder& xml, const Layer* node, const Options& option
 // Main Export function
 //==============================================================================
 
-std::string PAGXExporter::ToXML(const PAGXDocument& doc, const Options& options) {
-  XMLBuilder xml(true);
+static void WriteDocument(XMLBuilder& xml, const PAGXDocument& doc, const Options& options) {
   xml.appendDeclaration();
 
   xml.openElement("pagx");
@@ -1868,8 +1864,27 @@ std::string PAGXExporter::ToXML(const PAGXDocument& doc, const Options& options)
   }
 
   xml.closeElement();
+}
 
+std::string PAGXExporter::ToXML(const PAGXDocument& doc, const Options& options) {
+  XMLBuilder xml(true);
+  WriteDocument(xml, doc, options);
   return xml.release();
 }
 
+bool PAGXExporter::ToStream(const PAGXDocument& doc, OutputSink* sink, const Options& options) {
+  if (sink == nullptr) {
+    return false;
+  }
+  XMLBuilder xml(sink, true);
+  WriteDocument(xml, doc, options);
+  return xml.finish();
+}
+
+bool PAGXExporter::ToFile(const PAGXDocument& doc, const std::string& filePath,
+                          const Options& options) {
+  return WriteFileAtomically(filePath,
+                             [&](OutputSink* sink) { return ToStream(doc, sink, options); });
+}
+
 }  // namespace pagx
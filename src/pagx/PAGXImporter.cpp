@@ -83,6 +83,7 @@
 #include "pagx/svg/SVGPathParser.h"
 #include "pagx/types/Color.h"
 #include "pagx/utils/Base64.h"
+#include "pagx/utils/NumberCodec.h"
 #include "pagx/utils/StringParser.h"
 #include "pagx/xml/XMLDOM.h"
 
@@ -422,7 +423,8 @@ static void ReadDimension(const DOMNode* node, const std::string& name, float* o
     return;
   }
   const char* cstr = str->c_str();
-  // Reject leading whitespace, sign, and hex prefix; strtof would otherwise accept them.
+  // Reject leading whitespace, sign, and hex prefix; the float parser would otherwise accept the
+  // first two and read the hex prefix as a zero.
   char first = cstr[0];
   if (first == ' ' || first == '\t' || first == '+' || first == '-') {
     ReportError(doc, node, "Invalid value '" + *str + "' for '" + name + "' attribute.");
@@ -432,8 +434,8 @@ static void ReadDimension(const DOMNode* node, const std::string& name, float* o
     ReportError(doc, node, "Invalid value '" + *str + "' for '" + name + "' attribute.");
     return;
   }
-  char* endPtr = nullptr;
-  float value = strtof(cstr, &endPtr);
+  float value = 0.0f;
+  auto endPtr = ParseFloat(cstr, cstr + str->size(), &value);
   if (endPtr == cstr || !std::isfinite(value) || value < 0) {
     ReportError(doc, node, "Invalid value '" + *str + "' for '" + name + "' attribute.");
     return;
@@ -1609,12 +1611,8 @@ static bool LooksLikeFloat(const std::string& value) {
   if (value.empty()) {
     return false;
   }
-  char* end = nullptr;
-  float f = strtof(value.c_str(), &end);
-  if (end != value.c_str() && *end == '\0') {
-    return std::isfinite(f);
-  }
-  return false;
+  float f = 0.0f;
+  return ParseFloat(value, &f) && std::isfinite(f);
 }
 
 // Parses a keyframe value string into the typed representation T. Numeric, bool and color
@@ -1630,9 +1628,8 @@ static T ParseTypedValue(const std::string&, PAGXDocument*, const DOMNode*) {
 
 template <>
 float ParseTypedValue<float>(const std::string& value, PAGXDocument* doc, const DOMNode* node) {
-  char* endPtr = nullptr;
-  float result = strtof(value.c_str(), &endPtr);
-  if (endPtr == value.c_str() || *endPtr != '\0' || !std::isfinite(result)) {
+  float result = 0.0f;
+  if (!ParseFloat(value, &result) || !std::isfinite(result)) {
     ReportError(doc, node, "Invalid float keyframe value '" + value + "'.");
     return 0.0f;
   }
@@ -2227,8 +2224,8 @@ static std::vector<Point> ParseSemicolonSeparatedPoints(const std::string& str)
     if (ptr >= end) {
       break;
     }
-    char* endPtr = nullptr;
-    float x = strtof(ptr, &endPtr);
+    float x = 0.0f;
+    auto endPtr = ParseFloat(ptr, end, &x);
     if (endPtr == ptr) {
       break;
     }
@@ -2236,7 +2233,8 @@ static std::vector<Point> ParseSemicolonSeparatedPoints(const std::string& str)
     while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == ',')) {
       ++ptr;
     }
-    float y = strtof(ptr, &endPtr);
+    float y = 0.0f;
+    endPtr = ParseFloat(ptr, end, &y);
     if (endPtr == ptr) {
       break;
     }
@@ -2543,9 +2541,9 @@ static float GetFloatAttribute(const DOMNode* node, const std::string& name, flo
   if (!str || str->empty()) {
     return defaultValue;
   }
-  char* endPtr = nullptr;
-  float value = strtof(str->c_str(), &endPtr);
-  if (endPtr == str->c_str()) {
+  float value = 0.0f;
+  auto endPtr = ParseFloat(str->data(), str->data() + str->size(), &value);
+  if (endPtr == str->data()) {
     if (doc) {
       ReportError(doc, node, "Invalid value '" + *str + "' for '" + name + "' attribute.");
     }
@@ -2625,9 +2623,9 @@ static std::optional<float> GetOptionalFloatAttribute(const DOMNode* node, const
   if (!str || str->empty()) {
     return std::nullopt;
   }
-  char* endPtr = nullptr;
-  float value = strtof(str->c_str(), &endPtr);
-  if (endPtr == str->c_str()) {
+  float value = 0.0f;
+  auto endPtr = ParseFloat(str->data(), str->data() + str->size(), &value);
+  if (endPtr == str->data()) {
     if (doc) {
       ReportError(doc, node, "Invalid value '" + *str + "' for '" + name + "' attribute.");
     }
@@ -2648,12 +2646,11 @@ static std::pair<float, float> ParseTwoFloats(const std::string& str, bool* outV
   float second = 0;
   const char* ptr = str.c_str();
   const char* end = ptr + str.size();
-  char* endPtr = nullptr;
   ptr = SkipWhitespaceAndComma(ptr, end);
-  first = strtof(ptr, &endPtr);
+  auto endPtr = ParseFloat(ptr, end, &first);
   if (endPtr > ptr) {
     ptr = SkipWhitespaceAndComma(endPtr, end);
-    second = strtof(ptr, &endPtr);
+    endPtr = ParseFloat(ptr, end, &second);
     if (outValid) {
       *outValid = (endPtr > ptr);
     }
@@ -2679,21 +2676,20 @@ static Rect ParseRect(const std::string& str, bool* outValid) {
   Rect rect = {};
   const char* ptr = str.c_str();
   const char* end = ptr + str.size();
-  char* endPtr = nullptr;
   bool valid = true;
   ptr = SkipWhitespaceAndComma(ptr, end);
-  rect.x = strtof(ptr, &endPtr);
+  auto endPtr = ParseFloat(ptr, end, &rect.x);
   if (endPtr > ptr) {
     ptr = SkipWhitespaceAndComma(endPtr, end);
-    rect.y = strtof(ptr, &endPtr);
+    endPtr = ParseFloat(ptr, end, &rect.y);
   }
   if (endPtr > ptr) {
     ptr = SkipWhitespaceAndComma(endPtr, end);
-    rect.width = strtof(ptr, &endPtr);
+    endPtr = ParseFloat(ptr, end, &rect.width);
   }
   if (endPtr > ptr) {
     ptr = SkipWhitespaceAndComma(endPtr, end);
-    rect.height = strtof(ptr, &endPtr);
+    endPtr = ParseFloat(ptr, end, &rect.height);
     if (endPtr <= ptr) {
       valid = false;
     }
@@ -2806,7 +2802,6 @@ static Color ParseColor(const std::string& str, bool* outValid) {
     }
     const char* ptr = str.c_str() + fmt.prefixLen;
     const char* strEnd = str.c_str() + str.size();
-    char* endPtr = nullptr;
     float components[4] = {};
     int count = 0;
     for (; count < 4 && ptr < strEnd && *ptr != ')'; ++count) {
@@ -2814,7 +2809,7 @@ static Color ParseColor(const std::string& str, bool* outValid) {
       if (ptr >= strEnd || *ptr == ')') {
         break;
       }
-      components[count] = strtof(ptr, &endPtr);
+      auto endPtr = ParseFloat(ptr, strEnd, &components[count]);
       if (endPtr == ptr) {
         break;
       }
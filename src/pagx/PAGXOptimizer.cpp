@@ -39,8 +39,14 @@
 #include "pagx/nodes/SolidColor.h"
 #include "pagx/nodes/Stroke.h"
 #include "pagx/nodes/Text.h"
+#include "pagx/nodes/TextPath.h"
 #include "pagx/types/PathVerb.h"
+#include "pagx/types/ScaleMode.h"
+#include "pagx/utils/PathSimplifier.h"
+#include "pagx/utils/RasterUtils.h"
 #include "pagx/utils/VerifyUtils.h"
+#include "renderer/LayerBuilder.h"
+#include "tgfx/core/Data.h"
 
 namespace pagx {
 
@@ -132,6 +138,51 @@ bool MergeAdjacentGroupsInLayer(Layer* layer);
 
 void RecomputeMaskRefs(PAGXDocument* doc, std::unordered_set<const Layer*>& refs);
 
+struct PathSimplifyContext;
+
+void LimitPathTolerance(PathSimplifyContext* context, PathData* data, float tolerance);
+float MatrixScaleBound(const Matrix& matrix);
+float GroupScaleBound(const Group* group);
+void CollectPathTolerancesInElements(const std::vector<Element*>& elements, float scale,
+                                     PathSimplifyContext* context);
+void CollectPathTolerancesInLayer(Layer* layer, float scale, PathSimplifyContext* context);
+void SimplifyPaths(PAGXDocument* doc, const PAGXOptimizerOptions& options,
+                   PAGXOptimizer::Result* result);
+
+struct ConservativeBounds;
+
+bool IsNodeAddressable(const Node* node);
+bool IsStaticElement(const Element* element);
+bool IsStaticSubtree(const Layer* layer, const std::unordered_set<const Layer*>& maskRefs,
+                     bool allowAddressableRoot);
+bool ElementsReadBackdrop(const std::vector<Element*>& elements);
+bool LayerReadsBackdrop(const Layer* layer);
+bool TryGetStaticLayerMatrix(const Layer* layer, Matrix* matrix);
+bool TryComputeElementsBounds(const std::vector<Element*>& elements, ConservativeBounds* bounds);
+bool TryComputeLayerBounds(const Layer* layer, ConservativeBounds* bounds);
+bool TryGetOccluderRect(const Layer* layer, ConservativeBounds* rect);
+int CountPainters(const std::vector<Element*>& elements);
+int EstimateDrawCalls(const Layer* layer);
+bool IsOccluded(const Layer* layer, const std::vector<ConservativeBounds>& occluders,
+                const std::unordered_set<const Layer*>& maskRefs, ConservativeBounds* bounds);
+bool CullOccludedLayersInList(std::vector<Layer*>& layers, bool parentHasLayout,
+                              const std::unordered_set<const Layer*>& maskRefs,
+                              PAGXOptimizer::Result* result);
+bool CullOccludedLayers(PAGXDocument* doc, const std::unordered_set<const Layer*>& maskRefs,
+                        PAGXOptimizer::Result* result);
+
+int LayerDepth(const Layer* layer);
+int CountLayerEffects(const Layer* layer);
+bool IsBakeCandidate(const Layer* layer, const std::unordered_set<const Layer*>& maskRefs,
+                     const PAGXOptimizerOptions& options);
+void CollectBakeCandidates(const std::vector<Layer*>& layers, bool parentHasLayout,
+                           const std::unordered_set<const Layer*>& maskRefs,
+                           const PAGXOptimizerOptions& options, std::vector<Layer*>& candidates);
+void ReplaceWithBakedImage(PAGXDocument* doc, Layer* layer, float left, float top, float width,
+                           float height, const std::shared_ptr<tgfx::Data>& png, float scale);
+bool BakeStaticSubtrees(PAGXDocument* doc, const std::unordered_set<const Layer*>& maskRefs,
+                        const PAGXOptimizerOptions& options, PAGXOptimizer::Result* result);
+
 std::string PathDataSignature(const PathData* data);
 void RewritePathDataInElements(std::vector<Element*>& elements,
                                const std::unordered_map<PathData*, PathData*>& redirect);
@@ -1441,6 +1492,708 @@ void RecomputeMaskRefs(PAGXDocument* doc, std::unordered_set<const Layer*>& refs
   }
 }
 
+// ----------------------------------------------------------------------------
+// Path simplification.
+// Converts the device-pixel tolerance into the units of each PathData using an
+// upper bound of the scale applied above it, then simplifies every PathData
+// that only fixed-geometry Path elements reference. A PathData reached through
+// several Paths uses the smallest of their tolerances; zero means hands off.
+// ----------------------------------------------------------------------------
+
+struct PathSimplifyContext {
+  float tolerance = 0.0f;
+  std::unordered_map<PathData*, float> tolerances = {};
+  // Keeps the pass deterministic, since the map above is unordered.
+  std::vector<PathData*> pathOrder = {};
+};
+
+void LimitPathTolerance(PathSimplifyContext* context, PathData* data, float tolerance) {
+  auto result = context->tolerances.emplace(data, tolerance);
+  if (result.second) {
+    context->pathOrder.push_back(data);
+  } else {
+    result.first->second = std::min(result.first->second, tolerance);
+  }
+}
+
+// The largest singular value of the matrix's linear part: how much it can stretch any length.
+float MatrixScaleBound(const Matrix& matrix) {
+  float sum = matrix.a * matrix.a + matrix.b * matrix.b + matrix.c * matrix.c + matrix.d * matrix.d;
+  float determinant = matrix.a * matrix.d - matrix.b * matrix.c;
+  float root = std::sqrt(std::max(0.0f, sum * sum - 4.0f * determinant * determinant));
+  return std::sqrt((sum + root) * 0.5f);
+}
+
+// Rotation keeps lengths and a skew stretches them by at most 1 + |tan(skew)|.
+float GroupScaleBound(const Group* group) {
+  float skew = std::abs(std::tan(group->skew * 3.14159265358979323846f / 180.0f));
+  return std::max(std::abs(group->scale.x), std::abs(group->scale.y)) * (1.0f + skew);
+}
+
+void CollectPathTolerancesInElements(const std::vector<Element*>& elements, float scale,
+                                     PathSimplifyContext* context) {
+  for (auto* element : elements) {
+    // Repeater copies may be scaled without bound, so the geometry in its scope is left alone.
+    if (element->nodeType() == NodeType::Repeater) {
+      scale = INFINITY;
+    }
+  }
+  for (auto* element : elements) {
+    switch (element->nodeType()) {
+      case NodeType::Path: {
+        auto* path = static_cast<Path*>(element);
+        if (path->data == nullptr) {
+          break;
+        }
+        // An addressable Path may be animated, data-bound or replaced by a script at runtime, and
+        // layout rescales a Path with an authored size or constraints.
+        bool fixedGeometry = !IsNodeAddressable(path) && !ElementHasConstraints(path) &&
+                             std::isnan(path->width) && std::isnan(path->height);
+        LimitPathTolerance(context, path->data, fixedGeometry ? context->tolerance / scale : 0.0f);
+        break;
+      }
+      case NodeType::TextPath: {
+        auto* textPath = static_cast<TextPath*>(element);
+        if (textPath->path != nullptr) {
+          LimitPathTolerance(context, textPath->path, 0.0f);
+        }
+        break;
+      }
+      case NodeType::Group:
+      case NodeType::TextBox: {
+        auto* group = static_cast<Group*>(element);
+        // Like the culling pass, treats every addressable node as a possible target of an
+        // animation, a DataBind or a script.
+        float groupScale = IsNodeAddressable(group) ? INFINITY : scale * GroupScaleBound(group);
+        CollectPathTolerancesInElements(group->elements, groupScale, context);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void CollectPathTolerancesInLayer(Layer* layer, float scale, PathSimplifyContext* context) {
+  // A layer with its own timelines or ViewModel context runs scripts over its subtree.
+  if (IsNodeAddressable(layer) || !layer->timelines.empty() || !layer->vmContext.empty() ||
+      !layer->matrix3D.isIdentity()) {
+    scale = INFINITY;
+  } else {
+    scale *= MatrixScaleBound(layer->matrix);
+  }
+  CollectPathTolerancesInElements(layer->contents, scale, context);
+  for (auto* child : layer->children) {
+    CollectPathTolerancesInLayer(child, scale, context);
+  }
+  if (layer->mask != nullptr) {
+    CollectPathTolerancesInLayer(layer->mask, scale, context);
+  }
+  if (layer->composition != nullptr) {
+    for (auto* compositionLayer : layer->composition->layers) {
+      CollectPathTolerancesInLayer(compositionLayer, scale, context);
+    }
+  }
+}
+
+void SimplifyPaths(PAGXDocument* doc, const PAGXOptimizerOptions& options,
+                   PAGXOptimizer::Result* result) {
+  if (!(options.simplifyTolerance > 0)) {
+    return;
+  }
+  PathSimplifyContext context = {};
+  context.tolerance = options.simplifyTolerance;
+  for (auto& node : doc->nodes) {
+    if (node->nodeType() == NodeType::Glyph) {
+      auto* glyph = static_cast<Glyph*>(node.get());
+      if (glyph->path != nullptr) {
+        LimitPathTolerance(&context, glyph->path, 0.0f);
+      }
+    }
+  }
+  for (auto* layer : doc->layers) {
+    CollectPathTolerancesInLayer(layer, 1.0f, &context);
+  }
+  for (auto* data : context.pathOrder) {
+    float tolerance = context.tolerances[data];
+    if (!(tolerance > 0)) {
+      continue;
+    }
+    result->pathPointsBefore += static_cast<int>(data->countPoints());
+    SimplifyPathData(data, tolerance);
+    result->pathPointsAfter += static_cast<int>(data->countPoints());
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Occlusion culling.
+// Walks each sibling list from the topmost layer down, collecting the
+// axis-aligned rectangles painted by opaque solid-fill layers, and drops static
+// layers whose conservative bounds fall entirely inside one of them. A layer
+// that reads its backdrop (backdrop blur, non-Normal blending) resets the
+// collected rectangles, since its output depends on the pixels beneath it.
+// ----------------------------------------------------------------------------
+
+// Anti-aliased edges are partially transparent, so an occluder only hides what lies at least this
+// far inside its rectangle.
+constexpr float OCCLUSION_EDGE_INSET = 1.0f;
+
+// Axis-aligned rectangle in left/top/right/bottom form. Starts empty so that joining the first
+// rectangle adopts it unchanged.
+struct ConservativeBounds {
+  float left = INFINITY;
+  float top = INFINITY;
+  float right = -INFINITY;
+  float bottom = -INFINITY;
+
+  bool isEmpty() const {
+    return !(left < right && top < bottom);
+  }
+
+  float area() const {
+    return isEmpty() ? 0.0f : (right - left) * (bottom - top);
+  }
+
+  void join(const ConservativeBounds& other) {
+    left = std::min(left, other.left);
+    top = std::min(top, other.top);
+    right = std::max(right, other.right);
+    bottom = std::max(bottom, other.bottom);
+  }
+
+  void outset(float distance) {
+    left -= distance;
+    top -= distance;
+    right += distance;
+    bottom += distance;
+  }
+
+  bool contains(const ConservativeBounds& other) const {
+    return other.left >= left && other.top >= top && other.right <= right &&
+           other.bottom <= bottom;
+  }
+
+  ConservativeBounds mapped(const Matrix& matrix) const {
+    ConservativeBounds result = {};
+    Point corners[] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+    for (auto& corner : corners) {
+      auto point = matrix.mapPoint(corner);
+      result.join({point.x, point.y, point.x, point.y});
+    }
+    return result;
+  }
+};
+
+bool IsNodeAddressable(const Node* node) {
+  return node != nullptr && (!node->id.empty() || !node->customData.empty());
+}
+
+bool IsStaticElement(const Element* element) {
+  if (IsNodeAddressable(element)) {
+    return false;
+  }
+  switch (element->nodeType()) {
+    case NodeType::Fill:
+      return !IsNodeAddressable(static_cast<const Fill*>(element)->color);
+    case NodeType::Stroke:
+      return !IsNodeAddressable(static_cast<const Stroke*>(element)->color);
+    case NodeType::Group:
+    case NodeType::TextBox:
+      for (auto* child : static_cast<const Group*>(element)->elements) {
+        if (!IsStaticElement(child)) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return true;
+  }
+}
+
+// A static subtree renders the same pixels for its whole lifetime: nothing in it can be targeted by
+// an animation, a script, a mask or a runtime lookup. The root may keep its id and name when the
+// caller preserves the root node itself.
+bool IsStaticSubtree(const Layer* layer, const std::unordered_set<const Layer*>& maskRefs,
+                     bool allowAddressableRoot) {
+  if (!allowAddressableRoot && (IsNodeAddressable(layer) || !layer->name.empty())) {
+    return false;
+  }
+  if (LayerNeedsKeeping(layer, maskRefs) || layer->mask != nullptr) {
+    return false;
+  }
+  if (layer->composition != nullptr || !layer->compositionFilePath.empty() ||
+      layer->externalDoc != nullptr || HasUnresolvedImport(layer)) {
+    return false;
+  }
+  if (!layer->timelines.empty() || !layer->vmContext.empty()) {
+    return false;
+  }
+  for (auto* element : layer->contents) {
+    if (!IsStaticElement(element)) {
+      return false;
+    }
+  }
+  for (auto* style : layer->styles) {
+    if (IsNodeAddressable(style)) {
+      return false;
+    }
+  }
+  for (auto* filter : layer->filters) {
+    if (IsNodeAddressable(filter)) {
+      return false;
+    }
+  }
+  for (auto* child : layer->children) {
+    if (!IsStaticSubtree(child, maskRefs, false)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ElementsReadBackdrop(const std::vector<Element*>& elements) {
+  for (auto* element : elements) {
+    switch (element->nodeType()) {
+      case NodeType::Fill:
+        if (static_cast<const Fill*>(element)->blendMode != BlendMode::Normal) {
+          return true;
+        }
+        break;
+      case NodeType::Stroke:
+        if (static_cast<const Stroke*>(element)->blendMode != BlendMode::Normal) {
+          return true;
+        }
+        break;
+      case NodeType::Group:
+      case NodeType::TextBox:
+        if (ElementsReadBackdrop(static_cast<const Group*>(element)->elements)) {
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+bool LayerReadsBackdrop(const Layer* layer) {
+  if (layer->blendMode != BlendMode::Normal) {
+    return true;
+  }
+  for (auto* style : layer->styles) {
+    if (style->nodeType() == NodeType::BackgroundBlurStyle) {
+      return true;
+    }
+  }
+  if (ElementsReadBackdrop(layer->contents)) {
+    return true;
+  }
+  for (auto* child : layer->children) {
+    if (LayerReadsBackdrop(child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Mirrors the layer transform LayerBuilder applies when no layout constraint moves the layer.
+bool TryGetStaticLayerMatrix(const Layer* layer, Matrix* matrix) {
+  if (LayoutNodeHasConstraints(layer) || layer->preserve3D || !layer->matrix3D.isIdentity()) {
+    return false;
+  }
+  *matrix = Matrix::Translate(layer->x, layer->y) * layer->matrix;
+  return true;
+}
+
+bool TryComputeElementsBounds(const std::vector<Element*>& elements, ConservativeBounds* bounds) {
+  // Painters apply to every geometry accumulated in their scope, so the widest stroke in the scope
+  // outsets the union of all of them.
+  float strokeOutset = 0.0f;
+  for (auto* element : elements) {
+    if (ElementHasConstraints(element)) {
+      return false;
+    }
+    switch (element->nodeType()) {
+      case NodeType::Rectangle:
+      case NodeType::Ellipse: {
+        Point position = {};
+        Size size = {};
+        float width = NAN;
+        float height = NAN;
+        if (element->nodeType() == NodeType::Rectangle) {
+          auto* rect = static_cast<const Rectangle*>(element);
+          position = rect->position;
+          size = rect->size;
+          width = rect->width;
+          height = rect->height;
+        } else {
+          auto* ellipse = static_cast<const Ellipse*>(element);
+          position = ellipse->position;
+          size = ellipse->size;
+          width = ellipse->width;
+          height = ellipse->height;
+        }
+        float w = std::isnan(width) ? size.width : width;
+        float h = std::isnan(height) ? size.height : height;
+        float left = std::isnan(position.x) ? 0 : position.x - w * 0.5f;
+        float top = std::isnan(position.y) ? 0 : position.y - h * 0.5f;
+        bounds->join({left, top, left + w, top + h});
+        break;
+      }
+      case NodeType::Path: {
+        auto* path = static_cast<Path*>(element);
+        if (!std::isnan(path->width) || !std::isnan(path->height)) {
+          return false;
+        }
+        if (path->data == nullptr) {
+          break;
+        }
+        auto rect = path->data->getBounds();
+        float left = path->position.x + rect.x;
+        float top = path->position.y + rect.y;
+        bounds->join({left, top, left + rect.width, top + rect.height});
+        break;
+      }
+      case NodeType::Group: {
+        auto* group = static_cast<const Group*>(element);
+        if (group->rotation != 0 || group->skew != 0 || !std::isnan(group->width) ||
+            !std::isnan(group->height) || !group->padding.isZero()) {
+          return false;
+        }
+        ConservativeBounds groupBounds = {};
+        if (!TryComputeElementsBounds(group->elements, &groupBounds)) {
+          return false;
+        }
+        if (!groupBounds.isEmpty()) {
+          auto matrix = Matrix::Translate(group->position.x, group->position.y) *
+                        Matrix::Scale(group->scale.x, group->scale.y) *
+                        Matrix::Translate(-group->anchor.x, -group->anchor.y);
+          bounds->join(groupBounds.mapped(matrix));
+        }
+        break;
+      }
+      case NodeType::Stroke: {
+        auto* stroke = static_cast<const Stroke*>(element);
+        // Miter joins reach at most width * miterLimit / 2 past the centerline, and an outside
+        // stroke or a square cap at most one width, so this covers every join, cap and alignment.
+        strokeOutset = std::max(strokeOutset, stroke->width * std::max(stroke->miterLimit, 1.0f));
+        break;
+      }
+      case NodeType::Fill:
+      case NodeType::TrimPath:
+      case NodeType::RoundCorner:
+      case NodeType::MergePath:
+        // These only paint or shrink the geometry that is already accounted for.
+        break;
+      default:
+        return false;
+    }
+  }
+  if (strokeOutset > 0 && !bounds->isEmpty()) {
+    bounds->outset(strokeOutset);
+  }
+  return true;
+}
+
+// Computes a rectangle in the layer's own coordinate space that contains everything the layer and
+// its children can paint. Returns false for anything whose extent is not known before layout or
+// rendering (text, layout-driven placement, filters and styles that spread outside the content).
+bool TryComputeLayerBounds(const Layer* layer, ConservativeBounds* bounds) {
+  if (!layer->styles.empty() || !layer->filters.empty()) {
+    return false;
+  }
+  if (layer->layout != LayoutMode::None && !layer->children.empty()) {
+    return false;
+  }
+  if (!TryComputeElementsBounds(layer->contents, bounds)) {
+    return false;
+  }
+  for (auto* child : layer->children) {
+    if (!child->visible) {
+      continue;
+    }
+    Matrix matrix = {};
+    if (!TryGetStaticLayerMatrix(child, &matrix)) {
+      return false;
+    }
+    ConservativeBounds childBounds = {};
+    if (!TryComputeLayerBounds(child, &childBounds)) {
+      return false;
+    }
+    if (!childBounds.isEmpty()) {
+      bounds->join(childBounds.mapped(matrix));
+    }
+  }
+  return true;
+}
+
+// An occluder is a plain, static layer that paints one opaque axis-aligned rectangle.
+bool TryGetOccluderRect(const Layer* layer, ConservativeBounds* rect) {
+  if (IsNodeAddressable(layer) || !layer->name.empty() || !layer->visible) {
+    return false;
+  }
+  if (layer->alpha != 1.0f || layer->blendMode != BlendMode::Normal || layer->mask != nullptr ||
+      layer->hasScrollRect || layer->clipToBounds || !layer->styles.empty() ||
+      !layer->filters.empty()) {
+    return false;
+  }
+  if (layer->composition != nullptr || !layer->compositionFilePath.empty() ||
+      layer->externalDoc != nullptr || HasUnresolvedImport(layer) || !layer->timelines.empty() ||
+      !layer->vmContext.empty() || !layer->children.empty() || layer->contents.size() != 2) {
+    return false;
+  }
+  Matrix matrix = {};
+  if (!TryGetStaticLayerMatrix(layer, &matrix) || matrix.b != 0 || matrix.c != 0) {
+    return false;
+  }
+  auto* first = layer->contents[0];
+  auto* second = layer->contents[1];
+  if (first->nodeType() != NodeType::Rectangle || second->nodeType() != NodeType::Fill) {
+    return false;
+  }
+  auto* rectangle = static_cast<const Rectangle*>(first);
+  auto* fill = static_cast<const Fill*>(second);
+  if (IsNodeAddressable(rectangle) || rectangle->roundness != 0 || IsNodeAddressable(fill)) {
+    return false;
+  }
+  if (fill->alpha < 1.0f || fill->blendMode != BlendMode::Normal || fill->color == nullptr ||
+      fill->color->nodeType() != NodeType::SolidColor || IsNodeAddressable(fill->color)) {
+    return false;
+  }
+  if (static_cast<const SolidColor*>(fill->color)->color.alpha < 1.0f) {
+    return false;
+  }
+  ConservativeBounds local = {};
+  if (!TryComputeElementsBounds(layer->contents, &local) || local.isEmpty()) {
+    return false;
+  }
+  *rect = local.mapped(matrix);
+  if (layer->antiAlias) {
+    rect->outset(-OCCLUSION_EDGE_INSET);
+  }
+  return !rect->isEmpty();
+}
+
+int CountPainters(const std::vector<Element*>& elements) {
+  int count = 0;
+  for (auto* element : elements) {
+    if (IsPainter(element->nodeType())) {
+      count++;
+    } else if (element->nodeType() == NodeType::Group || element->nodeType() == NodeType::TextBox) {
+      count += CountPainters(static_cast<const Group*>(element)->elements);
+    }
+  }
+  return count;
+}
+
+// Rough draw-call count of a subtree: one per painter, one per layer style and one per filter pass.
+int EstimateDrawCalls(const Layer* layer) {
+  int count = CountPainters(layer->contents) + static_cast<int>(layer->styles.size()) +
+              static_cast<int>(layer->filters.size());
+  for (auto* child : layer->children) {
+    count += EstimateDrawCalls(child);
+  }
+  return count;
+}
+
+bool IsOccluded(const Layer* layer, const std::vector<ConservativeBounds>& occluders,
+                const std::unordered_set<const Layer*>& maskRefs, ConservativeBounds* bounds) {
+  if (!layer->visible || !IsStaticSubtree(layer, maskRefs, false)) {
+    return false;
+  }
+  Matrix matrix = {};
+  ConservativeBounds local = {};
+  if (!TryGetStaticLayerMatrix(layer, &matrix) || !TryComputeLayerBounds(layer, &local) ||
+      local.isEmpty()) {
+    return false;
+  }
+  *bounds = local.mapped(matrix);
+  for (auto& occluder : occluders) {
+    if (occluder.contains(*bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CullOccludedLayersInList(std::vector<Layer*>& layers, bool parentHasLayout,
+                              const std::unordered_set<const Layer*>& maskRefs,
+                              PAGXOptimizer::Result* result) {
+  bool changed = false;
+  for (auto* layer : layers) {
+    changed |= CullOccludedLayersInList(layer->children, layer->layout != LayoutMode::None,
+                                        maskRefs, result);
+  }
+  // Removing a laid-out sibling would move the remaining ones.
+  if (parentHasLayout) {
+    return changed;
+  }
+  std::vector<ConservativeBounds> occluders = {};
+  // Later siblings draw on top, so walk from the last layer to the first.
+  for (size_t i = layers.size(); i > 0; i--) {
+    auto* layer = layers[i - 1];
+    ConservativeBounds bounds = {};
+    if (!occluders.empty() && IsOccluded(layer, occluders, maskRefs, &bounds)) {
+      int drawCalls = EstimateDrawCalls(layer);
+      result->culledLayers++;
+      result->estimatedDrawCallsSaved += drawCalls;
+      result->estimatedOverdrawSaved += bounds.area() * static_cast<float>(drawCalls);
+      layers.erase(layers.begin() + static_cast<ptrdiff_t>(i - 1));
+      changed = true;
+      continue;
+    }
+    if (LayerReadsBackdrop(layer)) {
+      occluders.clear();
+    }
+    ConservativeBounds rect = {};
+    if (TryGetOccluderRect(layer, &rect)) {
+      occluders.push_back(rect);
+    }
+  }
+  return changed;
+}
+
+bool CullOccludedLayers(PAGXDocument* doc, const std::unordered_set<const Layer*>& maskRefs,
+                        PAGXOptimizer::Result* result) {
+  bool changed = CullOccludedLayersInList(doc->layers, false, maskRefs, result);
+  for (auto& node : doc->nodes) {
+    if (node->nodeType() == NodeType::Composition) {
+      auto* comp = static_cast<Composition*>(node.get());
+      changed |= CullOccludedLayersInList(comp->layers, false, maskRefs, result);
+    }
+  }
+  return changed;
+}
+
+// ----------------------------------------------------------------------------
+// Static subtree baking.
+// Replaces deep, effect-heavy static subtrees with a single Rectangle filled by
+// a pre-rasterized image of the subtree. Unlike the other rules this trades
+// exact output for fewer draw calls: the image is resampled when the document
+// is scaled beyond the bake resolution. The subtree root keeps its id, name,
+// transform and visibility, so anything that addresses it keeps working.
+// ----------------------------------------------------------------------------
+
+int LayerDepth(const Layer* layer) {
+  int depth = 0;
+  for (auto* child : layer->children) {
+    depth = std::max(depth, LayerDepth(child));
+  }
+  return depth + 1;
+}
+
+int CountLayerEffects(const Layer* layer) {
+  int count = static_cast<int>(layer->styles.size() + layer->filters.size());
+  for (auto* child : layer->children) {
+    count += CountLayerEffects(child);
+  }
+  return count;
+}
+
+bool IsBakeCandidate(const Layer* layer, const std::unordered_set<const Layer*>& maskRefs,
+                     const PAGXOptimizerOptions& options) {
+  // The root keeps drawing itself after baking, so everything it applies on top of its own content
+  // (opacity, blending, clipping, 3D) must stay out of the baked pixels.
+  if (!layer->visible || layer->alpha != 1.0f || layer->blendMode != BlendMode::Normal ||
+      layer->hasScrollRect || layer->clipToBounds || layer->preserve3D) {
+    return false;
+  }
+  // Constraints may place the root by its measured size, which changes once the content is baked.
+  if (LayoutNodeHasConstraints(layer)) {
+    return false;
+  }
+  if (LayerDepth(layer) < options.bakeMinDepth ||
+      CountLayerEffects(layer) < options.bakeMinEffects) {
+    return false;
+  }
+  return IsStaticSubtree(layer, maskRefs, true) && !LayerReadsBackdrop(layer);
+}
+
+void CollectBakeCandidates(const std::vector<Layer*>& layers, bool parentHasLayout,
+                           const std::unordered_set<const Layer*>& maskRefs,
+                           const PAGXOptimizerOptions& options, std::vector<Layer*>& candidates) {
+  for (auto* layer : layers) {
+    if (!parentHasLayout && IsBakeCandidate(layer, maskRefs, options)) {
+      candidates.push_back(layer);
+      continue;
+    }
+    CollectBakeCandidates(layer->children, layer->layout != LayoutMode::None, maskRefs, options,
+                          candidates);
+  }
+}
+
+void ReplaceWithBakedImage(PAGXDocument* doc, Layer* layer, float left, float top, float width,
+                           float height, const std::shared_ptr<tgfx::Data>& png, float scale) {
+  auto* image = doc->makeNode<Image>();
+  image->data = Data::MakeWithCopy(png->data(), png->size());
+  auto* pattern = doc->makeNode<ImagePattern>();
+  pattern->image = image;
+  // The PNG origin sits at the top-left of the baked bounds in the layer's own coordinate space,
+  // with `scale` pixels per unit.
+  pattern->scaleMode = ScaleMode::None;
+  pattern->matrix = Matrix::Translate(left, top) * Matrix::Scale(1.0f / scale, 1.0f / scale);
+  auto* rect = doc->makeNode<Rectangle>();
+  rect->position = {left + width * 0.5f, top + height * 0.5f};
+  rect->size = {width, height};
+  auto* fill = doc->makeNode<Fill>();
+  fill->color = pattern;
+  layer->contents = {rect, fill};
+  layer->styles.clear();
+  layer->filters.clear();
+  layer->children.clear();
+}
+
+bool BakeStaticSubtrees(PAGXDocument* doc, const std::unordered_set<const Layer*>& maskRefs,
+                        const PAGXOptimizerOptions& options, PAGXOptimizer::Result* result) {
+  if (options.bakeScale <= 0) {
+    return false;
+  }
+  std::vector<Layer*> candidates = {};
+  CollectBakeCandidates(doc->layers, false, maskRefs, options, candidates);
+  if (candidates.empty()) {
+    return false;
+  }
+  // The structural rules may have rewritten the tree since any earlier layout, so the layout is
+  // always recomputed before the candidates are rendered.
+  doc->applyLayout();
+  auto buildResult = LayerBuilder::BuildWithMap(doc);
+  if (buildResult.root == nullptr) {
+    return false;
+  }
+  GPUContext gpu;
+  bool changed = false;
+  for (auto* layer : candidates) {
+    auto tgfxLayer = buildResult.getLayer(layer);
+    if (tgfxLayer == nullptr) {
+      continue;
+    }
+    auto bounds = ComputeRasterizedLayerBoundsInSpace(tgfxLayer, tgfxLayer.get());
+    if (bounds.isEmpty()) {
+      continue;
+    }
+    auto png = RenderMaskedLayer(&gpu, buildResult.root, tgfxLayer, tgfxLayer.get(),
+                                 options.bakeScale);
+    if (png == nullptr || png->size() == 0) {
+      continue;
+    }
+    // RenderMaskedLayer sizes the PNG by the rounded-up bounds, so the baked rectangle does too.
+    float width = std::ceil(bounds.width());
+    float height = std::ceil(bounds.height());
+    int drawCalls = EstimateDrawCalls(layer);
+    result->bakedLayers++;
+    result->estimatedDrawCallsSaved += drawCalls - 1;
+    result->estimatedOverdrawSaved += width * height * static_cast<float>(drawCalls - 1);
+    ReplaceWithBakedImage(doc, layer, bounds.left, bounds.top, width, height, png,
+                          options.bakeScale);
+    changed = true;
+  }
+  if (changed) {
+    doc->applyLayout();
+  }
+  return changed;
+}
+
 // ----------------------------------------------------------------------------
 // Resource dedup / prune passes.
 // Run AFTER per-layer rules so any references redirected by canonicalize/simplify
@@ -1772,6 +2525,18 @@ PAGXOptimizer::Result OptimizeWithOptions(PAGXDocument* doc, const PAGXOptimizer
     }
   }
 
+  // Geometry and rendering-level passes run on the final structure, so they see the final sibling
+  // order and leave the resources they orphan to the cleanup below.
+  if (options.simplifyPaths) {
+    SimplifyPaths(doc, options, &result);
+  }
+  if (options.cullOccludedLayers && CullOccludedLayers(doc, maskRefs, &result)) {
+    RecomputeMaskRefs(doc, maskRefs);
+  }
+  if (options.bakeStaticSubtrees) {
+    BakeStaticSubtrees(doc, maskRefs, options, &result);
+  }
+
   // Resource-level cleanup: deduplicate identical PathData resources first (so the prune pass
   // sees the redirected references), then drop anything no longer referenced.
   if (options.dedupPathData) {
@@ -50,6 +50,35 @@ struct PAGXOptimizerOptions {
   bool dedupPathData = true;
   /** Drop resources from `<Resources>` that no longer have any reference in the layer tree. */
   bool pruneUnreferencedResources = true;
+  /**
+   * Reduce the straight-line runs of PathData referenced by fixed-geometry Path elements to
+   * simpler polylines or fitted cubic Beziers, within `simplifyTolerance`. Meant for traced artwork
+   * from SVG / HTML imports. Off by default because the result is only exact up to the tolerance.
+   */
+  bool simplifyPaths = false;
+  /**
+   * Maximum distance, in device pixels at the document's own scale, that any original path vertex
+   * may end up from the simplified path. The transforms above each Path are accounted for.
+   */
+  float simplifyTolerance = 0.25f;
+  /**
+   * Remove static layers that are entirely covered by opaque, axis-aligned solid rectangles drawn
+   * above them in the same layer list. Off by default: it only pays off for documents that stack
+   * full backgrounds over hidden content.
+   */
+  bool cullOccludedLayers = false;
+  /**
+   * Replace deep, effect-heavy static layer subtrees with a single rectangle filled by a
+   * pre-rasterized image. Unlike the other rules, the result is only exact up to `bakeScale`, and
+   * the pass applies the document layout (re-applying it after baking). Off by default.
+   */
+  bool bakeStaticSubtrees = false;
+  /** Pixel density of baked images relative to document units. */
+  float bakeScale = 2.0f;
+  /** Minimum layer nesting depth, counting the subtree root, for a subtree to be baked. */
+  int bakeMinDepth = 3;
+  /** Minimum number of layer styles and filters in a subtree for it to be baked. */
+  int bakeMinEffects = 2;
   /**
    * Maximum number of iterations to run rules to a fixed point. In typical SVG import workloads
    * 2-3 iterations suffice; 8 is a generous upper bound to handle deeply nested structures.
@@ -42,12 +42,14 @@ void PathData::moveTo(float x, float y) {
   _verbs.push_back(PathVerb::Move);
   _points.push_back({x, y});
   _boundsDirty = true;
+  renderCache = nullptr;
 }
 
 void PathData::lineTo(float x, float y) {
   _verbs.push_back(PathVerb::Line);
   _points.push_back({x, y});
   _boundsDirty = true;
+  renderCache = nullptr;
 }
 
 void PathData::quadTo(float cx, float cy, float x, float y) {
@@ -55,6 +57,7 @@ void PathData::quadTo(float cx, float cy, float x, float y) {
   _points.push_back({cx, cy});
   _points.push_back({x, y});
   _boundsDirty = true;
+  renderCache = nullptr;
 }
 
 void PathData::cubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) {
@@ -63,10 +66,12 @@ void PathData::cubicTo(float c1x, float c1y, float c2x, float c2y, float x, floa
   _points.push_back({c2x, c2y});
   _points.push_back({x, y});
   _boundsDirty = true;
+  renderCache = nullptr;
 }
 
 void PathData::close() {
   _verbs.push_back(PathVerb::Close);
+  renderCache = nullptr;
 }
 
 PathData& PathData::operator=(const PathData& other) {
@@ -74,6 +79,7 @@ PathData& PathData::operator=(const PathData& other) {
     _verbs = other._verbs;
     _points = other._points;
     _boundsDirty = true;
+    renderCache = nullptr;
   }
   return *this;
 }
@@ -83,6 +89,7 @@ void PathData::transform(const Matrix& matrix) {
     point = matrix.mapPoint(point);
   }
   _boundsDirty = true;
+  renderCache = nullptr;
 }
 
 Rect PathData::getBounds() {
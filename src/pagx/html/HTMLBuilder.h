@@ -21,6 +21,7 @@
 #include <cstring>
 #include <string>
 #include <vector>
+#include "pagx/OutputSink.h"
 
 namespace pagx {
 
@@ -30,6 +31,14 @@ class HTMLBuilder {
     _buf.reserve(reserve);
   }
 
+  // Creates a streaming builder that writes its buffered text to the sink whenever it grows beyond
+  // FlushThreshold at the end of a line. Call finish() to write the remainder.
+  explicit HTMLBuilder(OutputSink* sink, int initialLevel = 0) : _sink(sink), _level(initialLevel) {
+    _buf.reserve(FlushThreshold + FlushThreshold / 4);
+  }
+
+  static constexpr size_t FlushThreshold = 64 * 1024;
+
   void openTag(const char* tag) {
     indent();
     _buf += '<';
@@ -194,6 +203,14 @@ class HTMLBuilder {
   }
 
   void addRawContent(const std::string& c) {
+    if (_sink != nullptr && c.size() >= FlushThreshold) {
+      // Large blocks go to the sink directly rather than being copied into the buffer first.
+      flushBuffer();
+      if (!_failed && !_sink->write(c)) {
+        _failed = true;
+      }
+      return;
+    }
     _buf += c;
   }
 
@@ -209,7 +226,22 @@ class HTMLBuilder {
     return std::move(_buf);
   }
 
+  // Writes the remaining buffered text to the sink and flushes it. Returns false if any write to
+  // the sink has failed. Does nothing and returns true if the builder has no sink.
+  bool finish() {
+    if (_sink == nullptr) {
+      return true;
+    }
+    flushBuffer();
+    if (!_failed && !_sink->flush()) {
+      _failed = true;
+    }
+    return !_failed;
+  }
+
  private:
+  OutputSink* _sink = nullptr;
+  bool _failed = false;
   std::string _buf = {};
   std::vector<const char*> _tags = {};
   int _level = 0;
@@ -223,6 +255,20 @@ class HTMLBuilder {
 
   void newline() {
     _buf += '\n';
+    if (_sink != nullptr && _buf.size() >= FlushThreshold) {
+      flushBuffer();
+    }
+  }
+
+  void flushBuffer() {
+    if (_buf.empty()) {
+      return;
+    }
+    // After a failed write the output is already truncated, so the rest is discarded.
+    if (!_failed && !_sink->write(_buf)) {
+      _failed = true;
+    }
+    _buf.clear();
   }
 
   static std::string EscapeAttr(const std::string& s) {
@@ -18,6 +18,7 @@
 
 #include "pagx/HTMLExporter.h"
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -26,6 +27,8 @@
 #include "pagx/html/HTMLStyleExtractor.h"
 #include "pagx/html/HTMLWriter.h"
 #include "pagx/nodes/Font.h"
+#include "pagx/utils/ExporterUtils.h"
+#include "pagx/utils/NumberCodec.h"
 #include "pagx/utils/StringParser.h"
 #include "pagx/utils/Woff2FontGenerator.h"
 
@@ -79,8 +82,8 @@ static std::string RoundPxInStyle(const std::string& style) {
       continue;
     }
 
-    std::string numStr = style.substr(numStart, j - numStart);
-    float value = static_cast<float>(std::atof(numStr.c_str()));
+    float value = 0.0f;
+    ParseFloat(std::string_view(style).substr(numStart, j - numStart), &value);
     auto rounded = CoordToString(value);
     result += rounded;
     if (rounded != "0") {
@@ -91,34 +94,68 @@ static std::string RoundPxInStyle(const std::string& style) {
   return result;
 }
 
-// Walks the generated HTML, finds every `style="..."` attribute, and applies RoundPxInStyle
-// to its contents. Leaves <script> bodies, SVG path data, transform matrix components, and
-// every attribute other than style untouched.
-static std::string RoundCoordinatesInHTML(const std::string& html) {
-  std::string result;
-  result.reserve(html.size());
-  size_t pos = 0;
-  while (pos < html.size()) {
-    size_t stylePos = html.find("style=\"", pos);
-    if (stylePos == std::string::npos) {
-      result += html.substr(pos);
-      break;
-    }
-    result += html.substr(pos, stylePos - pos);
-    size_t valueStart = stylePos + 7;
-    size_t valueEnd = html.find('"', valueStart);
-    if (valueEnd == std::string::npos) {
-      result += html.substr(stylePos);
-      break;
+// Walks the generated HTML as it streams through, finds every `style="..."` attribute, and
+// applies RoundPxInStyle to its contents before forwarding the text to the next sink. Leaves
+// <script> bodies, SVG path data, transform matrix components, and every attribute other than
+// style untouched. Text that may still be part of an incomplete style attribute is held back until
+// more input arrives or the sink is flushed.
+class RoundCoordinatesSink : public OutputSink {
+ public:
+  explicit RoundCoordinatesSink(OutputSink* next) : next(next) {
+  }
+
+  bool write(const void* data, size_t length) override {
+    pending.append(static_cast<const char*>(data), length);
+    return process(false);
+  }
+
+  bool flush() override {
+    return process(true) && next->flush();
+  }
+
+ private:
+  static constexpr const char* STYLE_PREFIX = "style=\"";
+  static constexpr size_t STYLE_PREFIX_LENGTH = 7;
+
+  OutputSink* next = nullptr;
+  std::string pending = {};
+
+  bool process(bool final) {
+    std::string result;
+    result.reserve(pending.size());
+    size_t pos = 0;
+    while (pos < pending.size()) {
+      size_t stylePos = pending.find(STYLE_PREFIX, pos);
+      if (stylePos == std::string::npos) {
+        // The tail may hold the beginning of a style prefix split across two writes.
+        size_t end = pending.size();
+        if (!final && end - pos >= STYLE_PREFIX_LENGTH) {
+          end -= STYLE_PREFIX_LENGTH - 1;
+        } else if (!final) {
+          end = pos;
+        }
+        result.append(pending, pos, end - pos);
+        pos = end;
+        break;
+      }
+      size_t valueStart = stylePos + STYLE_PREFIX_LENGTH;
+      size_t valueEnd = pending.find('"', valueStart);
+      if (valueEnd == std::string::npos) {
+        size_t end = final ? pending.size() : stylePos;
+        result.append(pending, pos, end - pos);
+        pos = end;
+        break;
+      }
+      result.append(pending, pos, stylePos - pos);
+      result += STYLE_PREFIX;
+      result += RoundPxInStyle(pending.substr(valueStart, valueEnd - valueStart));
+      result += '"';
+      pos = valueEnd + 1;
     }
-    std::string styleValue = html.substr(valueStart, valueEnd - valueStart);
-    result += "style=\"";
-    result += RoundPxInStyle(styleValue);
-    result += "\"";
-    pos = valueEnd + 1;
+    pending.erase(0, pos);
+    return result.empty() || next->write(result);
   }
-  return result;
-}
+};
 
 //==============================================================================
 // ToHTML / ToFile
@@ -127,18 +164,24 @@ static std::string RoundCoordinatesInHTML(const std::string& html) {
 static constexpr const char* GENERATED_COMMENT =
     "<!-- Generated by PAGX HTMLExporter. Do not edit. -->\n";
 
-static std::string WrapAsHTMLDocument(const std::string& fragment, float width, float height) {
+static constexpr const char* DOCUMENT_TAIL = "\n</body>\n</html>\n";
+
+// Returns the markup preceding the fragment when it is wrapped as a full HTML document. The
+// fragment is followed by DOCUMENT_TAIL.
+static std::string MakeDocumentHead(float width, float height) {
   auto w = CssFloatToString(width);
   auto h = CssFloatToString(height);
   std::string bodyStyle = "margin:0;padding:0;width:" + w + "px;height:" + h +
                           "px;overflow:hidden;font-family:sans-serif";
   return "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<style>\nbody { " + bodyStyle +
-         " }\n</style>\n</head>\n<body>\n" + fragment + "\n</body>\n</html>\n";
+         " }\n</style>\n</head>\n<body>\n";
 }
 
-std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceDir,
-                                 HTMLOutputMode mode, const Options& options,
-                                 std::string* errorMsg) {
+// Exports the document and writes the result to the sink piece by piece, so the final output is
+// never concatenated into a single string. Returns false on failure, in which case nothing has
+// been written to the sink unless the failure came from the sink itself.
+static bool WriteHTML(PAGXDocument& doc, const std::string& resourceDir, HTMLOutputMode mode,
+                      const HTMLExportOptions& options, std::string* errorMsg, OutputSink* sink) {
   if (resourceDir.empty()) {
     if (errorMsg) {
       *errorMsg = "resourceDir must not be empty.";
@@ -146,7 +189,7 @@ std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceD
     std::cerr << "HTMLExporter::ToHTML: resourceDir must not be empty. "
                  "Use HTMLExporter::ToFile for automatic resource-directory derivation."
               << std::endl;
-    return {};
+    return false;
   }
   if (!std::filesystem::path(resourceDir).is_absolute()) {
     if (errorMsg) {
@@ -154,7 +197,7 @@ std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceD
     }
     std::cerr << "HTMLExporter::ToHTML: resourceDir must be an absolute path, got '" << resourceDir
               << "'." << std::endl;
-    return {};
+    return false;
   }
   // Resolve symlinks to prevent path-traversal attacks via symlinked directories.
   std::error_code canonEc;
@@ -163,7 +206,7 @@ std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceD
     if (errorMsg) {
       *errorMsg = "resourceDir path cannot be resolved: " + canonEc.message();
     }
-    return {};
+    return false;
   }
   if (!doc.isLayoutApplied()) {
     doc.applyLayout();
@@ -177,7 +220,6 @@ std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceD
     urlPrefix += '/';
   }
 
-  HTMLBuilder html(0, 4096);
   HTMLBuilder defs(2, 4096);
   HTMLWriterContext ctx;
   ctx.docWidth = doc.width;
@@ -237,6 +279,20 @@ std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceD
 
   HTMLWriter writer(&defs, &ctx);
 
+  // Without style extraction the coordinates are rounded incrementally and the markup streams
+  // straight to the sink. Style extraction needs the whole document, so it stays buffered.
+  bool fullDocument = mode == HTMLOutputMode::FullDocument;
+  if (fullDocument && !sink->write(MakeDocumentHead(doc.width, doc.height))) {
+    return false;
+  }
+  if (!sink->write(GENERATED_COMMENT, strlen(GENERATED_COMMENT))) {
+    return false;
+  }
+  std::string nativeHTML = {};
+  auto bufferSink = OutputSink::MakeFromString(&nativeHTML);
+  RoundCoordinatesSink roundingSink(options.extractStyleSheet ? bufferSink.get() : sink);
+  HTMLBuilder html(&roundingSink, 0);
+
   // Root div
   std::string rootStyle = "position:relative;width:" + CssFloatToString(doc.width) +
                           "px;height:" + CssFloatToString(doc.height) + "px;overflow:hidden";
@@ -276,21 +332,48 @@ std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceD
 
   html.closeTag();  // </div>
 
-  std::string nativeHTML = RoundCoordinatesInHTML(html.release());
-
-  if (options.extractStyleSheet) {
-    nativeHTML = HTMLStyleExtractor::Extract(nativeHTML);
+  if (!html.finish()) {
+    return false;
   }
 
-  std::string result = std::string(GENERATED_COMMENT) + nativeHTML;
-
-  if (mode == HTMLOutputMode::FullDocument) {
-    result = WrapAsHTMLDocument(result, doc.width, doc.height);
+  if (options.extractStyleSheet && !sink->write(HTMLStyleExtractor::Extract(nativeHTML))) {
+    return false;
+  }
+  if (fullDocument && !sink->write(DOCUMENT_TAIL, strlen(DOCUMENT_TAIL))) {
+    return false;
   }
+  return sink->flush();
+}
 
+std::string HTMLExporter::ToHTML(PAGXDocument& doc, const std::string& resourceDir,
+                                 HTMLOutputMode mode, const Options& options,
+                                 std::string* errorMsg) {
+  std::string result = {};
+  auto sink = OutputSink::MakeFromString(&result);
+  if (!WriteHTML(doc, resourceDir, mode, options, errorMsg, sink.get())) {
+    return {};
+  }
   return result;
 }
 
+bool HTMLExporter::ToStream(PAGXDocument& document, const std::string& resourceDir,
+                            OutputSink* sink, HTMLOutputMode mode, const Options& options,
+                            std::string* errorMsg) {
+  if (sink == nullptr) {
+    if (errorMsg) {
+      *errorMsg = "sink must not be null.";
+    }
+    return false;
+  }
+  if (!WriteHTML(document, resourceDir, mode, options, errorMsg, sink)) {
+    if (errorMsg && errorMsg->empty()) {
+      *errorMsg = "failed to write HTML output.";
+    }
+    return false;
+  }
+  return true;
+}
+
 bool HTMLExporter::ToFile(PAGXDocument& document, const std::string& filePath,
                           const Options& options, std::string* errorMsg) {
   // Derive the resource directory as a sibling of the HTML file named after its stem:
@@ -308,15 +391,6 @@ bool HTMLExporter::ToFile(PAGXDocument& document, const std::string& filePath,
   auto parentDir = htmlPath.parent_path();
   auto resourceDir = parentDir / stem;
 
-  // ToFile always produces a full HTML document (standalone file needs DOCTYPE).
-  auto html =
-      ToHTML(document, resourceDir.string(), HTMLOutputMode::FullDocument, options, errorMsg);
-  if (html.empty()) {
-    if (errorMsg && errorMsg->empty()) {
-      *errorMsg = "document produced no HTML output.";
-    }
-    return false;
-  }
   if (!parentDir.empty() && !std::filesystem::exists(parentDir)) {
     std::error_code ec = {};
     std::filesystem::create_directories(parentDir, ec);
@@ -327,21 +401,26 @@ bool HTMLExporter::ToFile(PAGXDocument& document, const std::string& filePath,
       return false;
     }
   }
-  std::ofstream file(filePath, std::ios::binary);
-  if (!file) {
-    if (errorMsg) {
+  // ToFile always produces a full HTML document (standalone file needs DOCTYPE). The output is
+  // streamed to a temporary file rather than being assembled in memory first, and only replaces
+  // filePath once the whole document has been written.
+  bool opened = false;
+  std::string writeError = {};
+  auto success = WriteFileAtomically(filePath, [&](OutputSink* sink) {
+    opened = true;
+    return WriteHTML(document, resourceDir.string(), HTMLOutputMode::FullDocument, options,
+                     &writeError, sink);
+  });
+  if (!success && errorMsg) {
+    if (!opened) {
       *errorMsg = "failed to write file: " + filePath;
-    }
-    return false;
-  }
-  file.write(html.data(), static_cast<std::streamsize>(html.size()));
-  if (!file.good()) {
-    if (errorMsg) {
+    } else if (!writeError.empty()) {
+      *errorMsg = writeError;
+    } else {
       *errorMsg = "write error after opening file: " + filePath;
     }
-    return false;
   }
-  return true;
+  return success;
 }
 
 }  // namespace pagx
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "pagx/types/Color.h"
@@ -118,6 +119,11 @@ struct HTMLInheritedStyle {
   // document's FontConfig so per-glyph fallback in LayoutContext can pick them up.
   std::string primaryFontFamily = {};
   std::vector<std::string> fontFamilyChain = {};
+
+  // Identifies the cascade result this style was returned as by `resolveInheritedStyle`, so
+  // children of identically styled parents can share one resolved style. 0 means the style did
+  // not come straight out of the cascade; code that edits a returned style must reset it to 0.
+  uint32_t cascadeId = 0;
 };
 
 /**
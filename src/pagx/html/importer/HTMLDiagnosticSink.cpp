@@ -36,7 +36,18 @@ void HTMLDiagnosticSink::bindDocument(PAGXDocument* document) {
   _pending.clear();
 }
 
+void HTMLDiagnosticSink::beginCapture(std::vector<std::string>* captured) {
+  _captured = captured;
+}
+
+void HTMLDiagnosticSink::endCapture() {
+  _captured = nullptr;
+}
+
 void HTMLDiagnosticSink::warn(const std::string& message) {
+  if (_captured != nullptr) {
+    _captured->push_back(message);
+  }
   if (_strict) {
     hardError(message);
     return;
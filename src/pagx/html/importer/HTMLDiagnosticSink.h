@@ -46,6 +46,18 @@ class HTMLDiagnosticSink {
    */
   void bindDocument(PAGXDocument* document);
 
+  /**
+   * Starts copying every subsequent warning into `captured` until `endCapture()` is called. The
+   * warnings are still recorded as usual. Used by the style cascade to replay the diagnostics of
+   * a cached result for every element that shares it.
+   */
+  void beginCapture(std::vector<std::string>* captured);
+
+  /**
+   * Stops copying warnings into the vector passed to `beginCapture()`.
+   */
+  void endCapture();
+
   /**
    * Records a warning. In strict mode this is upgraded into a hard error.
    */
@@ -78,6 +90,7 @@ class HTMLDiagnosticSink {
   PAGXDocument* _document = nullptr;
   std::vector<std::string> _pending = {};
   bool _hadHardError = false;
+  std::vector<std::string>* _captured = nullptr;
 };
 
 }  // namespace pagx
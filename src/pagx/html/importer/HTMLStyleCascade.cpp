@@ -432,13 +432,32 @@ void HTMLStyleCascade::mergeClassRules(const std::string& classAttribute, Proper
   }
 }
 
-const HTMLStyleCascade::PropertyMap& HTMLStyleCascade::getResolvedStyle(
+const HTMLStyleCascade::ResolvedStyle& HTMLStyleCascade::resolveStyle(
     const std::shared_ptr<DOMNode>& node) {
   auto it = _resolvedCache.find(node.get());
   if (it != _resolvedCache.end()) {
-    return it->second;
+    return *it->second;
+  }
+  auto* classAttr = node->findAttribute("class");
+  auto* styleAttr = node->findAttribute("style");
+  // Tag names and attribute values never contain NUL, so it separates the key parts safely.
+  std::string key = node->name;
+  key += '\0';
+  if (classAttr) {
+    key += *classAttr;
   }
-  auto& slot = _resolvedCache[node.get()];
+  key += '\0';
+  if (styleAttr) {
+    key += *styleAttr;
+  }
+  auto& shared = _sharedStyles[key];
+  if (shared != nullptr) {
+    _resolvedCache[node.get()] = shared.get();
+    return *shared;
+  }
+  shared = std::make_unique<ResolvedStyle>();
+  shared->id = static_cast<uint32_t>(_sharedStyles.size());
+  auto& slot = shared->properties;
 
   // Priority: element defaults -> element rules from <style> -> class rules -> inline.
   const auto& tagDefaults = ParsedElementDefaults();
@@ -454,15 +473,19 @@ const HTMLStyleCascade::PropertyMap& HTMLStyleCascade::getResolvedStyle(
       slot[kv.first] = kv.second;
     }
   }
-  auto* classAttr = node->findAttribute("class");
   if (classAttr) {
     mergeClassRules(*classAttr, slot);
   }
-  auto* styleAttr = node->findAttribute("style");
   if (styleAttr) {
     ParseStyleString(*styleAttr, slot);
   }
-  return slot;
+  _resolvedCache[node.get()] = shared.get();
+  return *shared;
+}
+
+const HTMLStyleCascade::PropertyMap& HTMLStyleCascade::getResolvedStyle(
+    const std::shared_ptr<DOMNode>& node) {
+  return resolveStyle(node).properties;
 }
 
 std::string HTMLStyleCascade::getStyleProperty(const std::shared_ptr<DOMNode>& node,
@@ -476,8 +499,33 @@ std::string HTMLStyleCascade::getStyleProperty(const std::shared_ptr<DOMNode>& n
 
 HTMLInheritedStyle HTMLStyleCascade::resolveInheritedStyle(const std::shared_ptr<DOMNode>& element,
                                                            const HTMLInheritedStyle& parent) {
+  const auto& resolved = resolveStyle(element);
+  if (parent.cascadeId == 0) {
+    // A parent outside the cascade (the document root) cannot key the cache, but its result can.
+    auto style = computeInheritedStyle(resolved.properties, parent);
+    style.cascadeId = ++_lastCascadeId;
+    return style;
+  }
+  auto key = (static_cast<uint64_t>(resolved.id) << 32) | parent.cascadeId;
+  auto it = _inheritedStyles.find(key);
+  if (it != _inheritedStyles.end()) {
+    // Replays the diagnostics so a shared result reports exactly what an uncached call would.
+    for (const auto& warning : it->second.warnings) {
+      _diagnostics.warn(warning);
+    }
+    return it->second.style;
+  }
+  InheritedStyleEntry entry = {};
+  _diagnostics.beginCapture(&entry.warnings);
+  entry.style = computeInheritedStyle(resolved.properties, parent);
+  _diagnostics.endCapture();
+  entry.style.cascadeId = ++_lastCascadeId;
+  return _inheritedStyles.emplace(key, std::move(entry)).first->second.style;
+}
+
+HTMLInheritedStyle HTMLStyleCascade::computeInheritedStyle(const PropertyMap& props,
+                                                           const HTMLInheritedStyle& parent) {
   HTMLInheritedStyle out = parent;
-  const auto& props = getResolvedStyle(element);
   CopyProperty(props, "color", out.color);
   CopyProperty(props, "font-family", out.fontFamily);
   // Re-parse the CSS font-family stack only when the raw value actually changed at this
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -72,7 +73,8 @@ class HTMLStyleCascade {
   void collectStyles(const std::shared_ptr<DOMNode>& head);
 
   /** Returns the resolved property map for `node`, computing and caching it on first call.
-   *  Priority: element defaults → element-rule cascade → class-rule cascade → inline `style`. */
+   *  Priority: element defaults → element-rule cascade → class-rule cascade → inline `style`.
+   *  Elements with the same tag, `class` and `style` attributes share one resolved map. */
   const PropertyMap& getResolvedStyle(const std::shared_ptr<DOMNode>& node);
 
   /** Returns the value of `property` from the resolved style, or `fallback` when absent. */
@@ -81,7 +83,9 @@ class HTMLStyleCascade {
 
   /** Computes the inherited style for `element` based on `parent`. Mirrors the CSS cascade for
    *  text-related properties and pre-resolves the numeric forms (font-size, letter-spacing,
-   *  resolved text colour) so text-leaf conversion can read them without re-parsing. */
+   *  resolved text colour) so text-leaf conversion can read them without re-parsing. The result
+   *  is cached per (resolved style, parent cascade result) pair, so identically styled siblings
+   *  are resolved once. */
   HTMLInheritedStyle resolveInheritedStyle(const std::shared_ptr<DOMNode>& element,
                                            const HTMLInheritedStyle& parent);
 
@@ -90,6 +94,24 @@ class HTMLStyleCascade {
   HTMLBoxAttributes computeBoxAttributes(const std::shared_ptr<DOMNode>& element);
 
  private:
+  // A resolved property map shared by every element with the same tag, `class` and `style`
+  // attributes. `id` is the interned, non-zero identity used to key the inherited-style cache.
+  struct ResolvedStyle {
+    uint32_t id = 0;
+    PropertyMap properties = {};
+  };
+
+  // A cached `resolveInheritedStyle` result. The diagnostics raised while computing it are kept
+  // so every element sharing the entry still reports them, exactly as an uncached call would.
+  struct InheritedStyleEntry {
+    HTMLInheritedStyle style = {};
+    std::vector<std::string> warnings = {};
+  };
+
+  const ResolvedStyle& resolveStyle(const std::shared_ptr<DOMNode>& node);
+  HTMLInheritedStyle computeInheritedStyle(const PropertyMap& props,
+                                           const HTMLInheritedStyle& parent);
+
   void parseStyleBlock(const std::shared_ptr<DOMNode>& styleNode);
   void mergeClassRules(const std::string& classAttribute, PropertyMap& out);
 
@@ -127,15 +149,29 @@ class HTMLStyleCascade {
   // CSS element selectors (key = lower-case tag name). Same shape as `_classRules`.
   std::unordered_map<std::string, PropertyMap> _elementRules = {};
 
-  // Cached resolved style per DOM node. Each entry merges inline + class + element rules + tag
-  // defaults.
+  // Resolved styles shared by content. The key joins the tag name, `class` and `style`
+  // attributes, which are the only inputs of the cascade, so thousands of identically styled
+  // siblings resolve to a single entry.
+  std::unordered_map<std::string, std::unique_ptr<ResolvedStyle>> _sharedStyles = {};
+
+  // Cached `resolveInheritedStyle` results keyed by (ResolvedStyle::id << 32 | parent cascadeId).
+  // Only parents produced by the cascade (non-zero `cascadeId`) take part. Each entry's style
+  // carries its own fresh `cascadeId`, so sharing propagates down identically styled subtrees.
+  std::unordered_map<uint64_t, InheritedStyleEntry> _inheritedStyles = {};
+
+  // Resolved style per DOM node, pointing into `_sharedStyles`. The first resolution of a node
+  // sticks even if its attributes change later in the same parse.
   //
   // Lifetime: the raw `DOMNode*` keys are valid only for a single Parse cycle. The DOM is owned
   // by `HTMLParserContext` via `shared_ptr<XMLDOM>` and is not mutated mid-parse, so keys never
   // dangle within one cycle. If the cascade is ever reused across parses, this cache must be
   // cleared first; switching to `weak_ptr<DOMNode>` would express the constraint at the cost of
   // a hash-table indirection.
-  std::unordered_map<const DOMNode*, PropertyMap> _resolvedCache = {};
+  std::unordered_map<const DOMNode*, const ResolvedStyle*> _resolvedCache = {};
+
+  // Source of `HTMLInheritedStyle::cascadeId`. Pre-incremented, so 0 stays reserved for styles
+  // built outside the cascade.
+  uint32_t _lastCascadeId = 0;
 };
 
 }  // namespace pagx
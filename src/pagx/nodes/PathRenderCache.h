@@ -0,0 +1,37 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "tgfx/core/Path.h"
+
+namespace pagx {
+
+// Internal render-side cache attached to each PathData node. Defined in a private header so that
+// public consumers of pagx::PathData never see tgfx types in their include graph.
+//
+// Lifetime: owned by PathData; created lazily by PathPool on the first render and dropped when
+// the geometry of the PathData changes or the PathData is destroyed. Copies of a PathData share
+// the cache until either one is modified.
+struct PathRenderCache {
+  // The tgfx path shared through PathPool with every PathData of identical geometry.
+  std::shared_ptr<const tgfx::Path> path = nullptr;
+};
+
+}  // namespace pagx
@@ -22,7 +22,6 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
-#include <fstream>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -287,7 +286,7 @@ static std::string EncodeImageDataURI(const uint8_t* bytes, size_t size, bool* r
   std::string href = "data:";
   href += (mime != nullptr ? mime : "image/png");
   href += ";base64,";
-  href += Base64Encode(bytes, size);
+  Base64EncodeTo(bytes, size, &href);
   return href;
 }
 
@@ -817,8 +816,8 @@ std::string SVGWriter::writeImagePatternDef(const ImagePattern* pattern, const R
     auto tiledPng = RenderTiledPattern(&_gpu, pattern, w, h, offsetX, offsetY, pixelScale);
     if (tiledPng && tiledPng->size() > 0) {
       // Successfully baked the pattern to PNG - embed as data URI
-      std::string base64Data = Base64Encode(tiledPng->bytes(), tiledPng->size());
-      href = "data:image/png;base64," + base64Data;
+      href = "data:image/png;base64,";
+      Base64EncodeTo(tiledPng->bytes(), tiledPng->size(), &href);
 
       _defs->openElement("pattern");
       _defs->addAttribute("id", defId);
@@ -3030,9 +3029,8 @@ bool SVGWriter::rasterizeLayerAsImage(SVGBuilder& out, const Layer* layer) {
                "' produced no pixel data; falling back to vector emission.");
     return false;
   }
-  std::string href = "data:image/png;base64," + Base64Encode(pngData->bytes(), pngData->size());
   out.openElement("image");
-  out.addAttribute("href", href);
+  out.addDataURIAttribute("href", "image/png", pngData->bytes(), pngData->size());
   out.addRequiredAttribute("x", bounds.left);
   out.addRequiredAttribute("y", bounds.top);
   out.addRequiredAttribute("width", bounds.width());
@@ -3490,8 +3488,8 @@ std::string SVGWriter::writeScrollRectClipDef(const Layer* layer) {
 // Main Export function
 //==============================================================================
 
-std::string SVGExporter::ToSVG(PAGXDocument& doc, const Options& options,
-                               std::vector<std::string>* warnings) {
+static void WriteSVGDocument(SVGBuilder& svg, PAGXDocument& doc, const SVGExportOptions& options,
+                             std::vector<std::string>* warnings) {
   // Mirror PPTExporter: resolve renderPosition() for every layer/group so authored x/y/position
   // attributes flow into the matrix helpers (BuildLayerMatrix / BuildGroupMatrix).
   if (!doc.isLayoutApplied()) {
@@ -3503,7 +3501,6 @@ std::string SVGExporter::ToSVG(PAGXDocument& doc, const Options& options,
   // away from float→int implementation-defined behaviour on huge canvases. Range matches
   // HTMLExportOptions::rasterScale.
   float safeRasterScale = std::clamp(options.rasterScale, 0.01f, 4.0f);
-  SVGBuilder svg(true, options.indent);
   SVGBuilder defs(true, options.indent, 2);
   SVGWriterContext context;
   auto layoutContext = std::make_unique<LayoutContext>(options.fontConfig);
@@ -3543,7 +3540,7 @@ std::string SVGExporter::ToSVG(PAGXDocument& doc, const Options& options,
         continue;
       }
       result.relativeUrl = "data:font/woff2;base64,";
-      result.relativeUrl += Base64Encode(result.woff2Data.data(), result.woff2Data.size());
+      Base64EncodeTo(result.woff2Data.data(), result.woff2Data.size(), &result.relativeUrl);
       context.woff2Fonts[font] = std::move(result);
       context.woff2FontOrder.push_back(font);
     }
@@ -3608,22 +3605,29 @@ std::string SVGExporter::ToSVG(PAGXDocument& doc, const Options& options,
   svg.addRawContent(bodyContent.release());
 
   svg.closeElement();  // </svg>
+}
 
+std::string SVGExporter::ToSVG(PAGXDocument& doc, const Options& options,
+                               std::vector<std::string>* warnings) {
+  SVGBuilder svg(true, options.indent);
+  WriteSVGDocument(svg, doc, options, warnings);
   return svg.release();
 }
 
-bool SVGExporter::ToFile(PAGXDocument& document, const std::string& filePath,
-                         const Options& options, std::vector<std::string>* warnings) {
-  auto svgContent = ToSVG(document, options, warnings);
-  if (svgContent.empty()) {
-    return false;
-  }
-  std::ofstream file(filePath, std::ios::binary);
-  if (!file) {
+bool SVGExporter::ToStream(PAGXDocument& document, OutputSink* sink, const Options& options,
+                           std::vector<std::string>* warnings) {
+  if (sink == nullptr) {
     return false;
   }
-  file.write(svgContent.data(), static_cast<std::streamsize>(svgContent.size()));
-  return file.good();
+  SVGBuilder svg(sink, true, options.indent);
+  WriteSVGDocument(svg, document, options, warnings);
+  return svg.finish();
+}
+
+bool SVGExporter::ToFile(PAGXDocument& document, const std::string& filePath,
+                         const Options& options, std::vector<std::string>* warnings) {
+  return WriteFileAtomically(
+      filePath, [&](OutputSink* sink) { return ToStream(document, sink, options, warnings); });
 }
 
 }  // namespace pagx
@@ -30,6 +30,7 @@
 #include "pagx/svg/SVGPathParser.h"
 #include "pagx/types/TextBaseline.h"
 #include "pagx/utils/CSSFontStyle.h"
+#include "pagx/utils/NumberCodec.h"
 #include "pagx/utils/StringParser.h"
 #include "pagx/xml/XMLDOM.h"
 #include "renderer/ToTGFX.h"
@@ -2254,7 +2255,9 @@ static float ReadNumber(const char*& ptr, const char* end) {
   if (start == ptr) {
     return 0.0f;
   }
-  return strtof(start, nullptr);
+  float result = 0.0f;
+  ParseFloat(start, ptr, &result);
+  return result;
 }
 Matrix SVGParserContext::parseTransform(const std::string& value) {
   Matrix result = Matrix::Identity();
@@ -2388,8 +2391,8 @@ static Color ParseCSSColorFunction(const std::string& value) {
       ++ptr;
       continue;
     }
-    char* numEnd = nullptr;
-    float val = strtof(ptr, &numEnd);
+    float val = 0.0f;
+    auto numEnd = ParseFloat(ptr, endPtr, &val);
     if (numEnd == ptr) {
       break;
     }
@@ -2657,8 +2660,8 @@ float SVGParserContext::parseLength(const std::string& value, float containerSiz
     return 0;
   }
 
-  char* endPtr = nullptr;
-  float num = strtof(value.c_str(), &endPtr);
+  float num = 0.0f;
+  auto endPtr = ParseFloat(value.c_str(), value.c_str() + value.size(), &num);
   if (endPtr == value.c_str()) {
     return 0;
   }
@@ -2710,8 +2713,8 @@ float SVGParserContext::parseLengthEm(const std::string& value, float containerS
   if (value.empty()) {
     return 0;
   }
-  char* endPtr = nullptr;
-  float num = strtof(value.c_str(), &endPtr);
+  float num = 0.0f;
+  auto endPtr = ParseFloat(value.c_str(), value.c_str() + value.size(), &num);
   if (endPtr == value.c_str()) {
     return 0;
   }
@@ -2745,8 +2748,8 @@ PathData SVGParserContext::parsePoints(const std::string& value, bool closed) {
     if (ptr >= end) {
       break;
     }
-    char* numEnd = nullptr;
-    float num = strtof(ptr, &numEnd);
+    float num = 0.0f;
+    auto numEnd = ParseFloat(ptr, end, &num);
     if (numEnd == ptr) {
       break;
     }
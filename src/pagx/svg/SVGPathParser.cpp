@@ -19,15 +19,25 @@
 #include "pagx/svg/SVGPathParser.h"
 #include <cctype>
 #include <cmath>
-#include <cstdio>
-#include <cstdlib>
 #include <string>
 #include "base/utils/MathUtil.h"
+#include "pagx/utils/NumberCodec.h"
 
 namespace pagx {
 
 using pag::PI;
 
+static void AppendPoints(const Point* points, int count, std::string* output) {
+  for (int i = 0; i < count; i++) {
+    if (i > 0) {
+      *output += ' ';
+    }
+    AppendFloat(points[i].x, output);
+    *output += ' ';
+    AppendFloat(points[i].y, output);
+  }
+}
+
 std::string PathDataToSVGString(const PathData& pathData) {
   std::string result;
   size_t pointIndex = 0;
@@ -35,26 +45,24 @@ std::string PathDataToSVGString(const PathData& pathData) {
   const auto& points = pathData.points();
   result.reserve(verbs.size() * 24);
 
-  char buf[128] = {};
   for (auto verb : verbs) {
     const Point* pts = points.data() + pointIndex;
     switch (verb) {
       case PathVerb::Move:
-        snprintf(buf, sizeof(buf), "M%g %g", pts[0].x, pts[0].y);
-        result += buf;
+        result += 'M';
+        AppendPoints(pts, 1, &result);
         break;
       case PathVerb::Line:
-        snprintf(buf, sizeof(buf), "L%g %g", pts[0].x, pts[0].y);
-        result += buf;
+        result += 'L';
+        AppendPoints(pts, 1, &result);
         break;
       case PathVerb::Quad:
-        snprintf(buf, sizeof(buf), "Q%g %g %g %g", pts[0].x, pts[0].y, pts[1].x, pts[1].y);
-        result += buf;
+        result += 'Q';
+        AppendPoints(pts, 2, &result);
         break;
       case PathVerb::Cubic:
-        snprintf(buf, sizeof(buf), "C%g %g %g %g %g %g", pts[0].x, pts[0].y, pts[1].x, pts[1].y,
-                 pts[2].x, pts[2].y);
-        result += buf;
+        result += 'C';
+        AppendPoints(pts, 3, &result);
         break;
       case PathVerb::Close:
         result += "Z";
@@ -109,8 +117,7 @@ static bool ParseNumber(const char*& ptr, const char* end, float& result) {
     return false;
   }
 
-  char* endPtr = nullptr;
-  result = strtof(start, &endPtr);
+  ParseFloat(start, ptr, &result);
   return true;
 }
 
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Base64.h"
+#include <algorithm>
 #include <array>
 #include <memory>
 
@@ -100,23 +101,46 @@ std::shared_ptr<Data> DecodeBase64DataURI(const std::string& dataURI) {
   return Base64Decode(dataURI.substr(commaPos + 1));
 }
 
-std::string Base64Encode(const uint8_t* data, size_t length) {
+// Encodes `length` bytes into `output`, which must have room for (length + 2) / 3 * 4 characters.
+static void EncodeBlock(const uint8_t* data, size_t length, char* output) {
   static const char encodingTable[] =
       "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  std::string result;
-  result.reserve((length + 2) / 3 * 4);
-
   for (size_t i = 0; i < length; i += 3) {
     uint32_t val = (data[i] << 16);
     if (i + 1 < length) val += (data[i + 1] << 8);
     if (i + 2 < length) val += data[i + 2];
 
-    result += encodingTable[(val >> 18) & 0x3F];
-    result += encodingTable[(val >> 12) & 0x3F];
-    result += (i + 1 < length) ? encodingTable[(val >> 6) & 0x3F] : '=';
-    result += (i + 2 < length) ? encodingTable[val & 0x3F] : '=';
+    *output++ = encodingTable[(val >> 18) & 0x3F];
+    *output++ = encodingTable[(val >> 12) & 0x3F];
+    *output++ = (i + 1 < length) ? encodingTable[(val >> 6) & 0x3F] : '=';
+    *output++ = (i + 2 < length) ? encodingTable[val & 0x3F] : '=';
   }
+}
+
+std::string Base64Encode(const uint8_t* data, size_t length) {
+  std::string result;
+  Base64EncodeTo(data, length, &result);
   return result;
 }
 
+void Base64EncodeTo(const uint8_t* data, size_t length, std::string* output) {
+  auto offset = output->size();
+  output->resize(offset + (length + 2) / 3 * 4);
+  EncodeBlock(data, length, &(*output)[offset]);
+}
+
+bool Base64Encode(const uint8_t* data, size_t length, OutputSink* sink) {
+  // The chunk size is a multiple of 3, so padding can only appear after the last chunk.
+  static constexpr size_t ChunkInputSize = 3 * 1024;
+  char buffer[ChunkInputSize / 3 * 4];
+  for (size_t offset = 0; offset < length; offset += ChunkInputSize) {
+    auto chunkSize = std::min(ChunkInputSize, length - offset);
+    EncodeBlock(data + offset, chunkSize, buffer);
+    if (!sink->write(buffer, (chunkSize + 2) / 3 * 4)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace pagx
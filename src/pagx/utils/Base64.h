@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <string>
+#include "pagx/OutputSink.h"
 #include "pagx/types/Data.h"
 
 namespace pagx {
@@ -30,4 +31,15 @@ std::shared_ptr<Data> DecodeBase64DataURI(const std::string& dataURI);
 
 std::string Base64Encode(const uint8_t* data, size_t length);
 
+/**
+ * Appends the Base64 encoding of the specified bytes to the end of the output string.
+ */
+void Base64EncodeTo(const uint8_t* data, size_t length, std::string* output);
+
+/**
+ * Writes the Base64 encoding of the specified bytes to the sink in fixed-size chunks, so the
+ * encoded payload is never held in memory as a whole. Returns false if the sink fails.
+ */
+bool Base64Encode(const uint8_t* data, size_t length, OutputSink* sink);
+
 }  // namespace pagx
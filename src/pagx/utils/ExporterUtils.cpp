@@ -18,6 +18,8 @@
 
 #include "pagx/utils/ExporterUtils.h"
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
 #include "base/utils/MathUtil.h"
 
 namespace pagx {
@@ -182,4 +184,25 @@ void DecomposeScale(const Matrix& m, float* sx, float* sy) {
   *sy = (*sx > 0) ? std::abs(det) / *sx : 0;
 }
 
+bool WriteFileAtomically(const std::string& filePath,
+                         const std::function<bool(OutputSink* sink)>& write) {
+  auto tempPath = filePath + ".tmp";
+  auto sink = OutputSink::MakeFromFile(tempPath);
+  if (sink == nullptr) {
+    return false;
+  }
+  auto success = write(sink.get());
+  // Closes the temporary file before it is renamed or removed.
+  sink = nullptr;
+  if (success) {
+    std::error_code ec = {};
+    std::filesystem::rename(tempPath, filePath, ec);
+    success = !ec;
+  }
+  if (!success) {
+    std::remove(tempPath.c_str());
+  }
+  return success;
+}
+
 }  // namespace pagx
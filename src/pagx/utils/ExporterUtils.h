@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
+#include "pagx/OutputSink.h"
 #include "pagx/nodes/Element.h"
 #include "pagx/nodes/Fill.h"
 #include "pagx/nodes/Group.h"
@@ -88,4 +90,13 @@ FillRule DetectMaskFillRule(const Layer* maskLayer);
  */
 void DecomposeScale(const Matrix& m, float* sx, float* sy);
 
+/**
+ * Streams the output of `write` to a temporary file next to `filePath` and renames it over
+ * `filePath` only after `write` succeeds, so an export that fails halfway never truncates or
+ * replaces an existing file. Returns false and removes the temporary file if the file cannot be
+ * opened, `write` fails or the rename fails.
+ */
+bool WriteFileAtomically(const std::string& filePath,
+                         const std::function<bool(OutputSink* sink)>& write);
+
 }  // namespace pagx
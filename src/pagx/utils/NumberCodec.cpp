@@ -0,0 +1,308 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NumberCodec.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define PAGX_HAS_FLOAT_CHARCONV
+#else
+#include <clocale>
+#endif
+
+namespace pagx {
+
+static constexpr int MaxMantissaDigits = 19;
+
+static bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Converts mantissa * 10^exponent when it can be done exactly with at most one rounding step
+// (Clinger's fast path). Returns false for the inputs that need the slow path.
+static bool ConvertFast(uint64_t mantissa, int exponent, float* value) {
+  static constexpr float FloatPowers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                          1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+  static constexpr double DoublePowers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  if (mantissa == 0) {
+    *value = 0.0f;
+    return true;
+  }
+  // Both operands are exact floats, so the single multiplication or division rounds correctly.
+  if (mantissa <= (uint64_t(1) << 24) && exponent >= -10 && exponent <= 10) {
+    auto result = static_cast<float>(mantissa);
+    *value = exponent < 0 ? result / FloatPowers[-exponent] : result * FloatPowers[exponent];
+    return true;
+  }
+  if (mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+    return false;
+  }
+  auto result = static_cast<double>(mantissa);
+  result = exponent < 0 ? result / DoublePowers[-exponent] : result * DoublePowers[exponent];
+  // Rounding the correctly rounded double to float again is only wrong when the double lands
+  // exactly halfway between two floats. The magnitude here is always within the normal float
+  // range, so a float ulp is 2^29 double ulps.
+  uint64_t bits = 0;
+  memcpy(&bits, &result, sizeof(bits));
+  if ((bits & ((uint64_t(1) << 29) - 1)) == (uint64_t(1) << 28)) {
+    return false;
+  }
+  *value = static_cast<float>(result);
+  return true;
+}
+
+// Converts the unsigned number in [first, last), which has already been validated, with full
+// precision. decimalExponent is the power of ten of the leading digit, used to tell overflow from
+// underflow.
+static float ConvertSlow(const char* first, const char* last, int decimalExponent) {
+#ifdef PAGX_HAS_FLOAT_CHARCONV
+  float value = 0.0f;
+  auto result = std::from_chars(first, last, value, std::chars_format::general);
+  if (result.ec == std::errc::result_out_of_range) {
+    return decimalExponent > 0 ? std::numeric_limits<float>::infinity() : 0.0f;
+  }
+  return value;
+#else
+  // strtof() expects the radix character of the current locale.
+  (void)decimalExponent;
+  auto radix = localeconv()->decimal_point[0];
+  auto length = static_cast<size_t>(last - first);
+  char stackBuffer[MaxFloatChars];
+  std::string heapBuffer = {};
+  char* buffer = stackBuffer;
+  if (length >= sizeof(stackBuffer)) {
+    heapBuffer.resize(length + 1);
+    buffer = &heapBuffer[0];
+  }
+  for (size_t i = 0; i < length; i++) {
+    buffer[i] = first[i] == '.' ? radix : first[i];
+  }
+  buffer[length] = '\0';
+  return strtof(buffer, nullptr);
+#endif
+}
+
+const char* ParseFloat(const char* first, const char* last, float* value) {
+  *value = 0.0f;
+  auto p = first;
+  while (p < last && IsSpace(*p)) {
+    p++;
+  }
+  bool negative = false;
+  if (p < last && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    p++;
+  }
+  auto numberStart = p;
+  uint64_t mantissa = 0;
+  int digitCount = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool hasDigits = false;
+  bool inFraction = false;
+  while (p < last) {
+    if (*p == '.' && !inFraction) {
+      inFraction = true;
+      p++;
+      continue;
+    }
+    if (!IsDigit(*p)) {
+      break;
+    }
+    hasDigits = true;
+    int digit = *p - '0';
+    if (mantissa == 0 && digit == 0) {
+      // Leading zeros only shift the exponent of a fraction.
+      if (inFraction) {
+        exponent--;
+      }
+    } else if (digitCount < MaxMantissaDigits) {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(digit);
+      digitCount++;
+      if (inFraction) {
+        exponent--;
+      }
+    } else {
+      truncated = truncated || digit != 0;
+      if (!inFraction) {
+        exponent++;
+      }
+    }
+    p++;
+  }
+  if (!hasDigits) {
+    return first;
+  }
+  if (p < last && (*p == 'e' || *p == 'E')) {
+    auto q = p + 1;
+    bool negativeExponent = false;
+    if (q < last && (*q == '+' || *q == '-')) {
+      negativeExponent = *q == '-';
+      q++;
+    }
+    if (q < last && IsDigit(*q)) {
+      int exponentValue = 0;
+      while (q < last && IsDigit(*q)) {
+        // Saturates far outside the float range so that huge exponents cannot overflow.
+        if (exponentValue < 100000) {
+          exponentValue = exponentValue * 10 + (*q - '0');
+        }
+        q++;
+      }
+      exponent += negativeExponent ? -exponentValue : exponentValue;
+      p = q;
+    }
+  }
+  float result = 0.0f;
+  if (truncated || !ConvertFast(mantissa, exponent, &result)) {
+    result = ConvertSlow(numberStart, p, exponent + digitCount - 1);
+  }
+  *value = negative ? -result : result;
+  return p;
+}
+
+bool ParseFloat(std::string_view text, float* value) {
+  auto first = text.data();
+  auto last = first + text.size();
+  auto end = ParseFloat(first, last, value);
+  if (end == first || end != last) {
+    *value = 0.0f;
+    return false;
+  }
+  return true;
+}
+
+// Writes the digits of a number, with the decimal exponent of its leading digit, in fixed notation
+// with the trailing zeros of the fraction removed.
+static char* WriteFixed(const char* digits, int digitCount, int exponent, char* output) {
+  while (digitCount > 1 && digits[digitCount - 1] == '0') {
+    digitCount--;
+  }
+  if (exponent < 0) {
+    *output++ = '0';
+    *output++ = '.';
+    for (int i = exponent + 1; i < 0; i++) {
+      *output++ = '0';
+    }
+    memcpy(output, digits, static_cast<size_t>(digitCount));
+    return output + digitCount;
+  }
+  for (int i = 0; i <= exponent; i++) {
+    *output++ = i < digitCount ? digits[i] : '0';
+  }
+  if (digitCount > exponent + 1) {
+    *output++ = '.';
+    auto fractionCount = static_cast<size_t>(digitCount - exponent - 1);
+    memcpy(output, digits + exponent + 1, fractionCount);
+    output += fractionCount;
+  }
+  return output;
+}
+
+// Extracts the digits and the exponent from a number in scientific notation, and writes them in
+// fixed notation. Any radix character between the digits is skipped.
+static char* ScientificToFixed(const char* first, const char* last, char* output) {
+  char digits[16] = {};
+  int digitCount = 0;
+  auto p = first;
+  for (; p < last && *p != 'e' && *p != 'E'; p++) {
+    if (IsDigit(*p) && digitCount < static_cast<int>(sizeof(digits))) {
+      digits[digitCount++] = *p;
+    }
+  }
+  int exponent = 0;
+  if (p < last) {
+    p++;
+    bool negative = p < last && *p == '-';
+    if (p < last && (*p == '-' || *p == '+')) {
+      p++;
+    }
+    for (; p < last && IsDigit(*p); p++) {
+      exponent = exponent * 10 + (*p - '0');
+    }
+    exponent = negative ? -exponent : exponent;
+  }
+  return WriteFixed(digits, digitCount, exponent, output);
+}
+
+char* FormatFloat(float value, char* buffer) {
+  if (std::isnan(value)) {
+    memcpy(buffer, "nan", 3);
+    return buffer + 3;
+  }
+  if (std::isinf(value)) {
+    if (value < 0) {
+      memcpy(buffer, "-inf", 4);
+      return buffer + 4;
+    }
+    memcpy(buffer, "inf", 3);
+    return buffer + 3;
+  }
+  auto output = buffer;
+  if (std::signbit(value)) {
+    *output++ = '-';
+    value = -value;
+  }
+  // The shortest digits are taken in scientific notation and then laid out in fixed notation, so
+  // large integral values are written as "16777216" or "123456790000" rather than with all the
+  // exact digits of the binary value.
+  char scientific[32] = {};
+#ifdef PAGX_HAS_FLOAT_CHARCONV
+  auto result = std::to_chars(scientific, scientific + sizeof(scientific), value,
+                              std::chars_format::scientific);
+  return ScientificToFixed(scientific, result.ptr, output);
+#else
+  // Tries increasing precisions until the digits parse back to the same float, which yields the
+  // same digits as the shortest round-trip conversion.
+  char* end = output;
+  for (int precision = 1; precision <= 9; precision++) {
+    auto length = snprintf(scientific, sizeof(scientific), "%.*e", precision - 1,
+                           static_cast<double>(value));
+    end = ScientificToFixed(scientific, scientific + length, output);
+    float parsed = 0.0f;
+    ParseFloat(output, end, &parsed);
+    if (parsed == value) {
+      break;
+    }
+  }
+  return end;
+#endif
+}
+
+void AppendFloat(float value, std::string* output) {
+  char buffer[MaxFloatChars];
+  auto end = FormatFloat(value, buffer);
+  output->append(buffer, static_cast<size_t>(end - buffer));
+}
+
+}  // namespace pagx
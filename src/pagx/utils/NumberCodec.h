@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace pagx {
+
+/**
+ * The maximum number of characters FormatFloat() writes for any float value.
+ */
+static constexpr size_t MaxFloatChars = 64;
+
+/**
+ * Parses a decimal floating-point number at the beginning of [first, last). The syntax matches
+ * strtof() in the "C" locale regardless of the current locale: optional leading whitespace, an
+ * optional sign, digits with an optional fraction, and an optional exponent. Hexadecimal floats,
+ * "inf", and "nan" are not accepted. Out-of-range values become infinity or zero as with strtof().
+ * No memory is allocated and the input does not need to be null-terminated.
+ * @return The pointer past the last parsed character, or first if no number was found, in which
+ *         case the value is set to zero.
+ */
+const char* ParseFloat(const char* first, const char* last, float* value);
+
+/**
+ * Parses the whole text as one number using the syntax of ParseFloat(). Returns false if the text
+ * is empty or contains anything other than the number, in which case the value is set to zero.
+ */
+bool ParseFloat(std::string_view text, float* value);
+
+/**
+ * Writes the shortest decimal representation of the value that parses back to exactly the same
+ * float, in fixed notation (never scientific) and independent of the current locale. NaN and
+ * infinities are written as "nan", "inf", and "-inf". The buffer must hold at least MaxFloatChars
+ * characters; no null terminator is written.
+ * @return The pointer past the last written character.
+ */
+char* FormatFloat(float value, char* buffer);
+
+/**
+ * Appends the representation written by FormatFloat() to the end of the output string.
+ */
+void AppendFloat(float value, std::string* output);
+
+}  // namespace pagx
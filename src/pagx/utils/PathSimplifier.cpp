@@ -0,0 +1,449 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pagx/utils/PathSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "pagx/nodes/PathData.h"
+#include "pagx/svg/SVGPathParser.h"
+
+namespace pagx {
+
+namespace {
+
+// Newton iterations tried on a fit that is close to the tolerance before the range is split.
+constexpr int MAX_REPARAMETERIZE_ITERATIONS = 4;
+
+Point Add(const Point& a, const Point& b) {
+  return {a.x + b.x, a.y + b.y};
+}
+
+Point Subtract(const Point& a, const Point& b) {
+  return {a.x - b.x, a.y - b.y};
+}
+
+Point Scale(const Point& point, float scale) {
+  return {point.x * scale, point.y * scale};
+}
+
+float Dot(const Point& a, const Point& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+float DistanceSquared(const Point& a, const Point& b) {
+  auto delta = Subtract(a, b);
+  return Dot(delta, delta);
+}
+
+bool SamePoint(const Point& a, const Point& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+Point Normalize(const Point& vector) {
+  float length = std::sqrt(Dot(vector, vector));
+  return length > 0 ? Scale(vector, 1.0f / length) : Point{0, 0};
+}
+
+float SegmentDistanceSquared(const Point& point, const Point& start, const Point& end) {
+  auto segment = Subtract(end, start);
+  float lengthSquared = Dot(segment, segment);
+  if (lengthSquared == 0) {
+    return DistanceSquared(point, start);
+  }
+  float t = std::clamp(Dot(Subtract(point, start), segment) / lengthSquared, 0.0f, 1.0f);
+  return DistanceSquared(point, Add(start, Scale(segment, t)));
+}
+
+// Returns the indices of the points Ramer-Douglas-Peucker keeps, always including the first and
+// the last one. Uses an explicit stack because traced polylines can have thousands of points.
+std::vector<size_t> ReducePolyline(const std::vector<Point>& points, float toleranceSquared) {
+  std::vector<bool> keep(points.size(), false);
+  keep.front() = true;
+  keep.back() = true;
+  std::vector<std::pair<size_t, size_t>> ranges = {{0, points.size() - 1}};
+  while (!ranges.empty()) {
+    auto range = ranges.back();
+    ranges.pop_back();
+    float maxDistance = 0;
+    size_t split = range.first;
+    for (size_t i = range.first + 1; i < range.second; i++) {
+      float distance =
+          SegmentDistanceSquared(points[i], points[range.first], points[range.second]);
+      if (distance > maxDistance) {
+        maxDistance = distance;
+        split = i;
+      }
+    }
+    if (maxDistance > toleranceSquared) {
+      keep[split] = true;
+      ranges.emplace_back(range.first, split);
+      ranges.emplace_back(split, range.second);
+    }
+  }
+  std::vector<size_t> indices = {};
+  for (size_t i = 0; i < points.size(); i++) {
+    if (keep[i]) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
+struct CubicSegment {
+  Point control1 = {};
+  Point control2 = {};
+  Point end = {};
+};
+
+Point EvaluateCubic(const Point* bezier, float t) {
+  float mt = 1.0f - t;
+  float b0 = mt * mt * mt;
+  float b1 = 3.0f * mt * mt * t;
+  float b2 = 3.0f * mt * t * t;
+  float b3 = t * t * t;
+  return {b0 * bezier[0].x + b1 * bezier[1].x + b2 * bezier[2].x + b3 * bezier[3].x,
+          b0 * bezier[0].y + b1 * bezier[1].y + b2 * bezier[2].y + b3 * bezier[3].y};
+}
+
+/**
+ * Fits a chain of cubic Beziers through a polyline with Schneider's algorithm: a least-squares
+ * fit with fixed end tangents, refined by Newton reparameterization, and split at the point of
+ * largest error when it stays out of tolerance. Gives up as soon as the chain needs `maxPoints`
+ * points or more, since a polyline of that size would be no worse.
+ */
+class CubicFitter {
+ public:
+  CubicFitter(const std::vector<Point>& points, float toleranceSquared, size_t maxPoints)
+      : points(points), toleranceSquared(toleranceSquared), maxPoints(maxPoints) {
+  }
+
+  bool fit(std::vector<CubicSegment>* output) {
+    segments = output;
+    auto last = points.size() - 1;
+    auto tangent1 = Normalize(Subtract(points[1], points[0]));
+    auto tangent2 = Normalize(Subtract(points[last - 1], points[last]));
+    return fitRange(0, last, tangent1, tangent2);
+  }
+
+ private:
+  const std::vector<Point>& points;
+  float toleranceSquared = 0;
+  size_t maxPoints = 0;
+  std::vector<CubicSegment>* segments = nullptr;
+  std::vector<float> parameters = {};
+
+  bool emit(const Point* bezier) {
+    segments->push_back({bezier[1], bezier[2], bezier[3]});
+    return segments->size() * 3 < maxPoints;
+  }
+
+  bool fitRange(size_t first, size_t last, const Point& tangent1, const Point& tangent2) {
+    Point bezier[4] = {};
+    if (last - first == 1) {
+      float distance = std::sqrt(DistanceSquared(points[first], points[last])) / 3.0f;
+      bezier[0] = points[first];
+      bezier[1] = Add(points[first], Scale(tangent1, distance));
+      bezier[2] = Add(points[last], Scale(tangent2, distance));
+      bezier[3] = points[last];
+      return emit(bezier);
+    }
+    parameterizeByChordLength(first, last);
+    generateBezier(first, last, tangent1, tangent2, bezier);
+    size_t split = 0;
+    float error = computeMaxError(first, last, bezier, &split);
+    if (error <= toleranceSquared) {
+      return emit(bezier);
+    }
+    if (error <= toleranceSquared * 4.0f) {
+      for (int i = 0; i < MAX_REPARAMETERIZE_ITERATIONS; i++) {
+        reparameterize(first, last, bezier);
+        generateBezier(first, last, tangent1, tangent2, bezier);
+        error = computeMaxError(first, last, bezier, &split);
+        if (error <= toleranceSquared) {
+          return emit(bezier);
+        }
+      }
+    }
+    auto center = Normalize(Subtract(points[split - 1], points[split + 1]));
+    if (center.x == 0 && center.y == 0) {
+      center = Normalize(Subtract(points[split - 1], points[split]));
+    }
+    return fitRange(first, split, tangent1, center) &&
+           fitRange(split, last, Scale(center, -1.0f), tangent2);
+  }
+
+  void parameterizeByChordLength(size_t first, size_t last) {
+    parameters.assign(last - first + 1, 0.0f);
+    for (size_t i = first + 1; i <= last; i++) {
+      parameters[i - first] =
+          parameters[i - first - 1] + std::sqrt(DistanceSquared(points[i], points[i - 1]));
+    }
+    float total = parameters.back();
+    for (auto& parameter : parameters) {
+      parameter = total > 0 ? parameter / total : 0.0f;
+    }
+  }
+
+  void generateBezier(size_t first, size_t last, const Point& tangent1, const Point& tangent2,
+                      Point* bezier) const {
+    auto& start = points[first];
+    auto& end = points[last];
+    float c00 = 0, c01 = 0, c11 = 0, x0 = 0, x1 = 0;
+    for (size_t i = first; i <= last; i++) {
+      float t = parameters[i - first];
+      float mt = 1.0f - t;
+      float b0 = mt * mt * mt;
+      float b1 = 3.0f * mt * mt * t;
+      float b2 = 3.0f * mt * t * t;
+      float b3 = t * t * t;
+      auto a0 = Scale(tangent1, b1);
+      auto a1 = Scale(tangent2, b2);
+      c00 += Dot(a0, a0);
+      c01 += Dot(a0, a1);
+      c11 += Dot(a1, a1);
+      auto base = Add(Scale(start, b0 + b1), Scale(end, b2 + b3));
+      auto residual = Subtract(points[i], base);
+      x0 += Dot(a0, residual);
+      x1 += Dot(a1, residual);
+    }
+    float determinant = c00 * c11 - c01 * c01;
+    float alpha1 = determinant != 0 ? (x0 * c11 - x1 * c01) / determinant : 0.0f;
+    float alpha2 = determinant != 0 ? (c00 * x1 - c01 * x0) / determinant : 0.0f;
+    float chord = std::sqrt(DistanceSquared(start, end));
+    // Non-positive handle lengths flip the tangents; fall back to the Wu-Barsky heuristic.
+    float epsilon = 1e-6f * chord;
+    if (alpha1 < epsilon || alpha2 < epsilon) {
+      alpha1 = chord / 3.0f;
+      alpha2 = chord / 3.0f;
+    }
+    bezier[0] = start;
+    bezier[1] = Add(start, Scale(tangent1, alpha1));
+    bezier[2] = Add(end, Scale(tangent2, alpha2));
+    bezier[3] = end;
+  }
+
+  float computeMaxError(size_t first, size_t last, const Point* bezier, size_t* split) const {
+    float maxError = 0;
+    *split = (first + last) / 2;
+    for (size_t i = first + 1; i < last; i++) {
+      float error = DistanceSquared(EvaluateCubic(bezier, parameters[i - first]), points[i]);
+      if (error > maxError) {
+        maxError = error;
+        *split = i;
+      }
+    }
+    return maxError;
+  }
+
+  void reparameterize(size_t first, size_t last, const Point* bezier) {
+    Point velocityHull[3] = {};
+    Point accelerationHull[2] = {};
+    for (int i = 0; i < 3; i++) {
+      velocityHull[i] = Scale(Subtract(bezier[i + 1], bezier[i]), 3.0f);
+    }
+    for (int i = 0; i < 2; i++) {
+      accelerationHull[i] = Scale(Subtract(velocityHull[i + 1], velocityHull[i]), 2.0f);
+    }
+    for (size_t i = first; i <= last; i++) {
+      auto& t = parameters[i - first];
+      float mt = 1.0f - t;
+      auto point = EvaluateCubic(bezier, t);
+      Point derivative = {
+          mt * mt * velocityHull[0].x + 2 * mt * t * velocityHull[1].x + t * t * velocityHull[2].x,
+          mt * mt * velocityHull[0].y + 2 * mt * t * velocityHull[1].y + t * t * velocityHull[2].y};
+      Point secondDerivative = {mt * accelerationHull[0].x + t * accelerationHull[1].x,
+                                mt * accelerationHull[0].y + t * accelerationHull[1].y};
+      auto delta = Subtract(point, points[i]);
+      float denominator = Dot(derivative, derivative) + Dot(delta, secondDerivative);
+      if (denominator != 0) {
+        t = std::clamp(t - Dot(delta, derivative) / denominator, 0.0f, 1.0f);
+      }
+    }
+  }
+};
+
+/**
+ * Copies path verbs into `output`, buffering each run of Line verbs so it can be replaced by a
+ * simpler polyline or a cubic chain when the run ends.
+ */
+class RunSimplifier {
+ public:
+  RunSimplifier(PathData* output, float tolerance)
+      : output(output), toleranceSquared(tolerance * tolerance) {
+  }
+
+  bool changed = false;
+
+  void moveTo(const Point& point) {
+    flush(false);
+    output->moveTo(point.x, point.y);
+    run = {point};
+    current = point;
+    contourStart = point;
+    contourHasCurves = false;
+  }
+
+  void lineTo(const Point& point) {
+    if (run.empty()) {
+      run.push_back(current);
+    }
+    run.push_back(point);
+    current = point;
+  }
+
+  void quadTo(const Point& control, const Point& point) {
+    flush(false);
+    output->quadTo(control.x, control.y, point.x, point.y);
+    startRun(point);
+  }
+
+  void cubicTo(const Point& control1, const Point& control2, const Point& point) {
+    flush(false);
+    output->cubicTo(control1.x, control1.y, control2.x, control2.y, point.x, point.y);
+    startRun(point);
+  }
+
+  void close() {
+    flush(true);
+    output->close();
+    run = {contourStart};
+    current = contourStart;
+    contourHasCurves = false;
+  }
+
+  void finish() {
+    flush(false);
+  }
+
+ private:
+  PathData* output = nullptr;
+  float toleranceSquared = 0;
+  std::vector<Point> run = {};
+  Point current = {};
+  Point contourStart = {};
+  bool contourHasCurves = false;
+
+  void startRun(const Point& point) {
+    run = {point};
+    current = point;
+    contourHasCurves = true;
+  }
+
+  void flush(bool closing) {
+    if (run.size() < 2) {
+      return;
+    }
+    size_t originalPoints = run.size() - 1;
+    // A closed all-line contour is simplified as a ring, so its implicit closing edge takes part.
+    bool ring = closing && !contourHasCurves && SamePoint(run.front(), contourStart);
+    std::vector<Point> points = {run.front()};
+    for (size_t i = 1; i < run.size(); i++) {
+      if (!SamePoint(run[i], points.back())) {
+        points.push_back(run[i]);
+      }
+    }
+    bool appendedStart = false;
+    if (ring && points.size() > 1 && !SamePoint(points.back(), points.front())) {
+      points.push_back(points.front());
+      appendedStart = true;
+    }
+    std::vector<size_t> kept = {};
+    std::vector<CubicSegment> cubics = {};
+    bool useLines = false;
+    bool useCubics = false;
+    if (points.size() >= 3) {
+      size_t bestPoints = originalPoints;
+      kept = ReducePolyline(points, toleranceSquared);
+      size_t linePoints = kept.size() - (appendedStart ? 2 : 1);
+      // A ring needs at least two vertices besides its start to enclose any area.
+      if ((!ring || kept.size() >= 4) && linePoints < bestPoints) {
+        bestPoints = linePoints;
+        useLines = true;
+      }
+      if (points.size() >= 4) {
+        CubicFitter fitter(points, toleranceSquared, bestPoints);
+        if (fitter.fit(&cubics)) {
+          useLines = false;
+          useCubics = true;
+        }
+      }
+    }
+    if (useCubics) {
+      for (auto& cubic : cubics) {
+        output->cubicTo(cubic.control1.x, cubic.control1.y, cubic.control2.x, cubic.control2.y,
+                        cubic.end.x, cubic.end.y);
+      }
+    } else if (useLines) {
+      for (size_t i = 1; i < kept.size(); i++) {
+        if (appendedStart && kept[i] == points.size() - 1) {
+          continue;
+        }
+        output->lineTo(points[kept[i]].x, points[kept[i]].y);
+      }
+    } else {
+      for (size_t i = 1; i < run.size(); i++) {
+        output->lineTo(run[i].x, run[i].y);
+      }
+    }
+    changed |= useLines || useCubics;
+    run = {run.back()};
+  }
+};
+
+}  // namespace
+
+bool SimplifyPathData(PathData* path, float tolerance) {
+  if (path == nullptr || !(tolerance > 0) || path->isEmpty()) {
+    return false;
+  }
+  PathData result = PathDataFromSVGString("");
+  RunSimplifier simplifier(&result, tolerance);
+  auto& points = path->points();
+  size_t index = 0;
+  for (auto verb : path->verbs()) {
+    auto* pts = points.data() + index;
+    switch (verb) {
+      case PathVerb::Move:
+        simplifier.moveTo(pts[0]);
+        break;
+      case PathVerb::Line:
+        simplifier.lineTo(pts[0]);
+        break;
+      case PathVerb::Quad:
+        simplifier.quadTo(pts[0], pts[1]);
+        break;
+      case PathVerb::Cubic:
+        simplifier.cubicTo(pts[0], pts[1], pts[2]);
+        break;
+      case PathVerb::Close:
+        simplifier.close();
+        break;
+    }
+    index += static_cast<size_t>(PathData::PointsPerVerb(verb));
+  }
+  simplifier.finish();
+  if (!simplifier.changed) {
+    return false;
+  }
+  *path = result;
+  return true;
+}
+
+}  // namespace pagx
@@ -0,0 +1,36 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace pagx {
+
+class PathData;
+
+/**
+ * Simplifies the straight-line runs of `path` in place so that no input vertex moves farther than
+ * `tolerance` from the result. Each run of consecutive Line verbs is replaced by a
+ * Ramer-Douglas-Peucker reduced polyline or by a chain of least-squares fitted cubic Beziers,
+ * whichever needs fewer points, and only when that is fewer than the run already has. Quadratic
+ * and cubic segments, contour start points, contour direction and Close verbs are kept as they are,
+ * so closed contours stay closed and the fill rule of any painter keeps the same meaning. Returns
+ * true if the path was changed.
+ */
+bool SimplifyPathData(PathData* path, float tolerance);
+
+}  // namespace pagx
@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <unordered_map>
 #include "base/utils/Log.h"
+#include "pagx/utils/NumberCodec.h"
 
 namespace pagx {
 
@@ -285,14 +286,18 @@ static int FloatToHexByte(float v) {
 
 std::string ColorToHexString(const Color& color, bool withAlpha) {
   if (color.colorSpace == ColorSpace::DisplayP3) {
-    char buf[64] = {};
+    std::string result = "p3(";
+    AppendFloat(color.red, &result);
+    result += ", ";
+    AppendFloat(color.green, &result);
+    result += ", ";
+    AppendFloat(color.blue, &result);
     if (withAlpha && color.alpha < 1.0f) {
-      snprintf(buf, sizeof(buf), "p3(%g, %g, %g, %g)", color.red, color.green, color.blue,
-               color.alpha);
-    } else {
-      snprintf(buf, sizeof(buf), "p3(%g, %g, %g)", color.red, color.green, color.blue);
+      result += ", ";
+      AppendFloat(color.alpha, &result);
     }
-    return std::string(buf);
+    result += ')';
+    return result;
   }
   char buf[10] = {};
   int r = FloatToHexByte(color.red);
@@ -366,8 +371,8 @@ bool ConsumeNumber(const char*& ptr, const char* end, float& out) {
     ++ptr;
   }
   if (ptr >= end) return false;
-  char* numEnd = nullptr;
-  float v = std::strtof(ptr, &numEnd);
+  float v = 0.0f;
+  auto numEnd = ParseFloat(ptr, end, &v);
   if (numEnd == ptr) return false;
   ptr = numEnd;
   out = v;
@@ -559,8 +564,8 @@ std::vector<float> ParseFloatList(const std::string& str) {
     if (ptr >= end) {
       break;
     }
-    char* endPtr = nullptr;
-    float value = strtof(ptr, &endPtr);
+    float value = 0.0f;
+    auto endPtr = ParseFloat(ptr, end, &value);
     if (endPtr == ptr) {
       break;
     }
@@ -577,32 +582,14 @@ std::string FloatToString(float value) {
   if (value == 0.0f) {
     return "0";
   }
-  char buf[64] = {};
-  snprintf(buf, sizeof(buf), "%g", value);
-  std::string s(buf);
-  // %g may pick scientific notation for very large or very small magnitudes. Re-emit those
-  // in fixed form so the result always matches the schema's decimal patterns. We deliberately
-  // do NOT snap small magnitudes to zero here: even sub-pixel residuals (e.g. sin/cos of an
-  // angle that almost lines up with a multiple of pi/2) still round-trip through XML losslessly
-  // and changing them would alter rendered output for baseline-sensitive callers.
-  if (s.find('e') != std::string::npos || s.find('E') != std::string::npos) {
-    // Use 9 fractional digits: this matches FLT_DECIMAL_DIG, the minimum precision that
-    // guarantees every distinct float value serializes to a distinct decimal string and
-    // round-trips back to the same bit pattern. Fewer digits would collapse near-denormal
-    // values (e.g. 1e-30f) onto 0 after the scientific-notation branch is rewritten. Trailing
-    // zeros are stripped below so typical values stay short.
-    snprintf(buf, sizeof(buf), "%.9f", value);
-    s = buf;
-    auto dot = s.find('.');
-    if (dot != std::string::npos) {
-      auto last = s.find_last_not_of('0');
-      if (last == dot) {
-        last--;  // strip trailing dot
-      }
-      s = s.substr(0, last + 1);
-    }
-  }
-  return s;
+  // The shortest representation that parses back to the same float, always in fixed notation so
+  // the result matches the schema's decimal patterns. We deliberately do NOT snap small magnitudes
+  // to zero here: even sub-pixel residuals (e.g. sin/cos of an angle that almost lines up with a
+  // multiple of pi/2) still round-trip through XML losslessly and changing them would alter
+  // rendered output for baseline-sensitive callers.
+  std::string result = {};
+  AppendFloat(value, &result);
+  return result;
 }
 
 std::string CoordToString(float value) {
@@ -613,9 +600,9 @@ std::string CoordToString(float value) {
   if (rounded == 0.0f) {
     rounded = 0.0f;
   }
-  char buf[32] = {};
-  snprintf(buf, sizeof(buf), "%g", rounded);
-  return std::string(buf);
+  std::string result = {};
+  AppendFloat(rounded, &result);
+  return result;
 }
 
 std::string CssFloatToString(float value) {
@@ -625,6 +612,13 @@ std::string CssFloatToString(float value) {
   char buf[32] = {};
   snprintf(buf, sizeof(buf), "%.4f", value);
   std::string s(buf);
+  // The output only holds a sign, digits and the radix character, which may not be '.' in the
+  // current locale.
+  for (auto& c : s) {
+    if (c != '-' && !std::isdigit(static_cast<unsigned char>(c))) {
+      c = '.';
+    }
+  }
   if (s.find('.') != std::string::npos) {
     size_t lastNonZero = s.find_last_not_of('0');
     s.erase(lastNonZero + 1);
@@ -238,6 +238,11 @@ Matrix MatrixFromString(const std::string& str);
 // String parsing utilities
 //==============================================================================
 std::vector<float> ParseFloatList(const std::string& str);
+
+/**
+ * Formats a float with the shortest decimal digits that parse back to the same value, in fixed
+ * notation and independent of the current locale. NaN, infinities and zero are written as "0".
+ */
 std::string FloatToString(float value);
 
 /**
@@ -253,7 +258,7 @@ bool ParseCSSHSLColor(const std::string& value, Color& out);
 
 /**
  * Formats a float as a pixel coordinate or size with at most two decimal places. Unlike
- * FloatToString (which uses %g and preserves full float precision), this trims sub-pixel
+ * FloatToString (which preserves full float precision), this trims sub-pixel
  * noise that only adds visual clutter to HTML/CSS output. Use this for left/top/width/height
  * /translate/line-height-style numbers. Do not use for SVG path data, transform matrices,
  * color channels, or other precision-sensitive values.
@@ -262,9 +267,9 @@ std::string CoordToString(float value);
 
 /**
  * Formats a float for CSS/HTML output using at most three decimal places, with trailing
- * zeros and a bare trailing dot stripped. Unlike FloatToString (which uses %g and prints
- * up to 6 significant digits, producing inconsistent precision such as 0.0823529 next to
- * -1.90915 next to -11.31), this gives uniform fractional precision suitable for
+ * zeros and a bare trailing dot stripped. Unlike FloatToString (which prints the shortest
+ * round-trip digits, producing inconsistent precision such as 0.08235294 next to
+ * -1.9091501 next to -11.31), this gives uniform fractional precision suitable for
  * transform matrix coefficients, rotation degrees, scale factors, alpha values, gradient
  * stop percentages, SVG path data, and other CSS numerics. Px coordinates should still
  * use CoordToString (two decimal places). PAGX serialization and SVG export keep
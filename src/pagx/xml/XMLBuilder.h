@@ -21,10 +21,12 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <cstdio>
 #include <string>
 #include <vector>
 #include "base/utils/Log.h"
+#include "pagx/OutputSink.h"
+#include "pagx/utils/Base64.h"
+#include "pagx/utils/NumberCodec.h"
 
 namespace pagx {
 
@@ -36,6 +38,10 @@ namespace pagx {
  *  - Pretty-print mode (prettyPrint=true): indented output with newlines, suitable for
  *    human-readable XML (PAGX, SVG).
  *
+ * When constructed with an OutputSink, the builder streams its output: the buffered text is
+ * written to the sink whenever it grows beyond FlushThreshold at an element boundary, and
+ * finish() writes the remainder. Otherwise the output accumulates until release() is called.
+ *
  * All mutating methods return *this to allow chaining.
  */
 class XMLBuilder {
@@ -47,6 +53,18 @@ class XMLBuilder {
     _tags.reserve(32);
   }
 
+  XMLBuilder(OutputSink* sink, bool prettyPrint, int indentSpaces = 2, int initialIndentLevel = 0)
+      : _sink(sink), _prettyPrint(prettyPrint), _indentSpaces(indentSpaces),
+        _indent(initialIndentLevel) {
+    _buf.reserve(FlushThreshold + FlushThreshold / 4);
+    _tags.reserve(32);
+  }
+
+  /**
+   * The buffer size at which a streaming builder writes its buffered text to the sink.
+   */
+  static constexpr size_t FlushThreshold = 64 * 1024;
+
   //--- XML Declaration -------------------------------------------------------
 
   XMLBuilder& appendDeclaration(bool standalone = false) {
@@ -100,6 +118,27 @@ class XMLBuilder {
     return *this;
   }
 
+  // Writes the bytes as a base64 data URI. A streaming builder encodes the payload straight to the
+  // sink in fixed-size chunks instead of materializing the whole encoded string first.
+  XMLBuilder& addDataURIAttribute(const char* name, const char* mimeType, const uint8_t* data,
+                                  size_t length) {
+    _buf += ' ';
+    _buf += name;
+    _buf += "=\"data:";
+    escapeAttrTo(_buf, mimeType);
+    _buf += ";base64,";
+    if (_sink != nullptr) {
+      flushBuffer();
+      if (!_failed && !Base64Encode(data, length, _sink)) {
+        _failed = true;
+      }
+    } else {
+      Base64EncodeTo(data, length, &_buf);
+    }
+    _buf += '"';
+    return *this;
+  }
+
   //--- Conditional Attributes (skip when value == default) -------------------
 
   XMLBuilder& addAttribute(const char* name, const char* value) {
@@ -186,6 +225,7 @@ class XMLBuilder {
       _buf += '\n';
       _indent++;
     }
+    flushIfNeeded();
     return *this;
   }
 
@@ -201,6 +241,7 @@ class XMLBuilder {
       return *this;
     }
     _tags.pop_back();
+    flushIfNeeded();
     return *this;
   }
 
@@ -222,6 +263,7 @@ class XMLBuilder {
       _buf += '\n';
     }
     _tags.pop_back();
+    flushIfNeeded();
     return *this;
   }
 
@@ -241,6 +283,7 @@ class XMLBuilder {
       _buf += '\n';
     }
     _tags.pop_back();
+    flushIfNeeded();
     return *this;
   }
 
@@ -248,11 +291,21 @@ class XMLBuilder {
 
   XMLBuilder& addTextContent(const std::string& t) {
     escapeTextTo(_buf, t);
+    flushIfNeeded();
     return *this;
   }
 
   XMLBuilder& addRawContent(const std::string& s) {
+    if (_sink != nullptr && s.size() >= FlushThreshold) {
+      // Large blocks go to the sink directly rather than being copied into the buffer first.
+      flushBuffer();
+      if (!_failed && !_sink->write(s)) {
+        _failed = true;
+      }
+      return *this;
+    }
     _buf += s;
+    flushIfNeeded();
     return *this;
   }
 
@@ -279,6 +332,7 @@ class XMLBuilder {
       }
       start = end + 1;
     }
+    flushIfNeeded();
     return *this;
   }
 
@@ -292,6 +346,7 @@ class XMLBuilder {
     if (_prettyPrint) {
       _buf += '\n';
     }
+    flushIfNeeded();
     return *this;
   }
 
@@ -301,7 +356,24 @@ class XMLBuilder {
     return std::move(_buf);
   }
 
+  /**
+   * Writes the remaining buffered text to the sink and flushes it. Returns false if any write to
+   * the sink has failed. Does nothing and returns true if the builder has no sink.
+   */
+  bool finish() {
+    if (_sink == nullptr) {
+      return true;
+    }
+    flushBuffer();
+    if (!_failed && !_sink->flush()) {
+      _failed = true;
+    }
+    return !_failed;
+  }
+
  private:
+  OutputSink* _sink = nullptr;
+  bool _failed = false;
   std::string _buf;
   std::vector<std::string> _tags;
   bool _prettyPrint;
@@ -321,6 +393,23 @@ class XMLBuilder {
     return attr(name, val.c_str());
   }
 
+  void flushIfNeeded() {
+    if (_sink != nullptr && _buf.size() >= FlushThreshold) {
+      flushBuffer();
+    }
+  }
+
+  void flushBuffer() {
+    if (_buf.empty()) {
+      return;
+    }
+    // After a failed write the output is already truncated, so the rest is discarded.
+    if (!_failed && !_sink->write(_buf)) {
+      _failed = true;
+    }
+    _buf.clear();
+  }
+
   void writeIndent() {
     DEBUG_ASSERT(_indent >= 0);
     if (_indent <= 0) {
@@ -380,9 +469,9 @@ class XMLBuilder {
   }
 
   static std::string formatFloat(float value) {
-    char buf[32] = {};
-    snprintf(buf, sizeof(buf), "%g", value);
-    return buf;
+    char buf[MaxFloatChars];
+    auto end = FormatFloat(value, buf);
+    return std::string(buf, end);
   }
 };
 
@@ -20,7 +20,9 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include "PathPool.h"
 #include "ToTGFX.h"
+#include "base/utils/ImagePool.h"
 #include "base/utils/Log.h"
 #include "pagx/PAGXDocument.h"
 #include "pagx/TextLayout.h"
@@ -292,7 +294,7 @@ static std::shared_ptr<tgfx::Image> ImageFromDataURI(const std::string& dataURI)
   if (!data) {
     return nullptr;
   }
-  return tgfx::Image::MakeFromEncoded(ToTGFXData(data));
+  return pag::ImagePool::MakeFromEncoded(ToTGFXData(data));
 }
 
 // Build context that maintains state during layer tree construction. Designed so the same
@@ -1337,13 +1339,13 @@ class LayerBuilderContext {
     return polystar;
   }
 
-  tgfx::Path getScaledPath(const PathData* pathData, float scale) {
+  tgfx::Path getScaledPath(PathData* pathData, float scale) {
     PathCacheKey key = {pathData, scale};
     auto it = _scaledPathCache.find(key);
     if (it != _scaledPathCache.end()) {
       return it->second;
     }
-    auto path = ToTGFX(*pathData);
+    auto path = *PathPool::Get(pathData);
     if (scale != 1.0f) {
       path.transform(tgfx::Matrix::MakeScale(scale));
     }
@@ -1900,7 +1902,8 @@ class LayerBuilderContext {
     //      allocate a parallel mipmapped texture and copy the pixels. Use as-is.
     //   2. CPU-decoded images (encoded data, file path, data URI): produced lazily by tgfx
     //      codecs. Wrap with makeMipmapped(true) so subsequent sampling at non-1:1 scales does
-    //      not re-decode at every zoom level.
+    //      not re-decode at every zoom level. They come from the process-wide ImagePool, so
+    //      documents embedding the same bytes or file share one decoded image.
     std::shared_ptr<tgfx::Image> image = nullptr;
     // Priority 1: a host-supplied ready image on the node (PAGXDocument::loadFileData(path, image)).
     auto runtimeImage = LayerBuilder::GetNodeRuntimeImage(imageNode);
@@ -1910,15 +1913,15 @@ class LayerBuilderContext {
     // Priority 2: fallback to standard decoding chain.
     if (!image) {
       if (imageNode->data) {
-        image = tgfx::Image::MakeFromEncoded(ToTGFXData(imageNode->data));
+        image = pag::ImagePool::MakeFromEncoded(ToTGFXData(imageNode->data));
       } else if (imageNode->filePath.find("data:") == 0) {
         image = ImageFromDataURI(imageNode->filePath);
       } else if (!imageNode->filePath.empty()) {
-        image = tgfx::Image::MakeFromFile(imageNode->filePath);
+        image = pag::ImagePool::MakeFromFile(imageNode->filePath);
       }
     }
     if (image && !image->isTextureBacked()) {
-      image = image->makeMipmapped(true);
+      image = pag::ImagePool::MakeMipmapped(std::move(image));
     }
     // Only memoize successful results. A null entry would cache the absence of a host-provided
     // image forever, so a later loadFileData() update would never take effect after invalidation.
@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PathPool.h"
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ToTGFX.h"
+#include "pagx/nodes/PathRenderCache.h"
+
+namespace pagx {
+using PathMap = std::unordered_multimap<size_t, std::weak_ptr<const tgfx::Path>>;
+
+// Heap-allocated and never destroyed, since pooled paths may still be released by other static
+// objects at exit.
+static std::mutex& locker = *new std::mutex();
+static PathMap& pathMap = *new PathMap();
+
+static size_t HashPathData(const PathData& pathData) {
+  auto& verbs = pathData.verbs();
+  auto& points = pathData.points();
+  auto verbHash = std::hash<std::string_view>()(std::string_view(
+      reinterpret_cast<const char*>(verbs.data()), verbs.size() * sizeof(PathVerb)));
+  auto pointHash = std::hash<std::string_view>()(std::string_view(
+      reinterpret_cast<const char*>(points.data()), points.size() * sizeof(Point)));
+  return verbHash ^ (pointHash + 0x9e3779b9 + (verbHash << 6) + (verbHash >> 2));
+}
+
+static void RemoveExpiredPaths(size_t hash) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto range = pathMap.equal_range(hash);
+  for (auto item = range.first; item != range.second;) {
+    item = item->second.expired() ? pathMap.erase(item) : std::next(item);
+  }
+}
+
+static std::shared_ptr<const tgfx::Path> FindOrAddPath(size_t hash, tgfx::Path path) {
+  // Mismatched paths are released after the locker, since the last release of a pooled path locks
+  // it again to remove the entry.
+  std::vector<std::shared_ptr<const tgfx::Path>> candidates = {};
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto range = pathMap.equal_range(hash);
+  for (auto item = range.first; item != range.second; ++item) {
+    auto cachedPath = item->second.lock();
+    if (cachedPath != nullptr && *cachedPath == path) {
+      return cachedPath;
+    }
+    candidates.push_back(std::move(cachedPath));
+  }
+  std::shared_ptr<const tgfx::Path> sharedPath(new tgfx::Path(std::move(path)),
+                                               [hash](const tgfx::Path* path) {
+                                                 RemoveExpiredPaths(hash);
+                                                 delete path;
+                                               });
+  pathMap.emplace(hash, sharedPath);
+  return sharedPath;
+}
+
+std::shared_ptr<const tgfx::Path> PathPool::Get(PathData* pathData) {
+  if (pathData->renderCache != nullptr) {
+    return pathData->renderCache->path;
+  }
+  auto path = ToTGFX(*pathData);
+  auto renderCache = std::make_shared<PathRenderCache>();
+  if (pathData->isEmpty()) {
+    renderCache->path = std::make_shared<const tgfx::Path>(std::move(path));
+  } else {
+    renderCache->path = FindOrAddPath(HashPathData(*pathData), std::move(path));
+  }
+  pathData->renderCache = renderCache;
+  return renderCache->path;
+}
+}  // namespace pagx
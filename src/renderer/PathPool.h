@@ -0,0 +1,41 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "pagx/nodes/PathData.h"
+#include "tgfx/core/Path.h"
+
+namespace pagx {
+/**
+ * PathPool shares converted tgfx paths process-wide between all PAGX documents, so PathData
+ * resources with identical geometry, such as the same logo or font glyphs used by many templates,
+ * share one path storage and the caches tgfx builds for it. Paths are matched by their verbs and
+ * points. The pool only holds weak references: each PathData keeps its shared path until its
+ * geometry changes or it is destroyed, and a pooled path is removed once no PathData uses it.
+ */
+class PathPool {
+ public:
+  /**
+   * Returns the tgfx path of the specified PathData, shared with every live path that has identical
+   * geometry. The result is cached on the PathData, so later calls skip the conversion.
+   */
+  static std::shared_ptr<const tgfx::Path> Get(PathData* pathData);
+};
+}  // namespace pagx
@@ -19,6 +19,10 @@
 #include "CompositionReader.h"
 
 namespace pag {
+// The number of offscreen surfaces rendered in turn by readFrames(). Three surfaces allow one frame
+// to be recorded while the previous one is executed by the GPU and the one before is read back.
+static constexpr size_t READBACK_RING_SIZE = 3;
+
 std::shared_ptr<CompositionReader> CompositionReader::Make(int width, int height,
                                                            void* sharedContext) {
   if (width <= 0 || height <= 0) {
@@ -58,6 +62,47 @@ bool CompositionReader::readFrame(double progress, std::shared_ptr<BitmapBuffer>
   return renderFrame(progress);
 }
 
+bool CompositionReader::readFrames(const std::vector<double>& progresses,
+                                   std::shared_ptr<BitmapBuffer> bitmap,
+                                   const std::function<bool(size_t index)>& callback) {
+  if (bitmap == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  drawable->setBitmap(nullptr);
+  auto colorType = bitmap->info().colorType() == tgfx::ColorType::BGRA_8888
+                       ? tgfx::ColorType::BGRA_8888
+                       : tgfx::ColorType::RGBA_8888;
+  drawable->setReadbackRingSize(READBACK_RING_SIZE, colorType);
+  size_t readIndex = 0;
+  auto readNextFrame = [&]() {
+    if (!drawable->readSubmittedFrame(bitmap)) {
+      return false;
+    }
+    return callback(readIndex++);
+  };
+  auto success = true;
+  for (auto progress : progresses) {
+    if (drawable->pendingFrames() >= READBACK_RING_SIZE - 1 && !readNextFrame()) {
+      success = false;
+      break;
+    }
+    auto pendingFrames = drawable->pendingFrames();
+    pagPlayer->setProgress(progress);
+    pagPlayer->flush();
+    if (drawable->pendingFrames() == pendingFrames) {
+      success = false;
+      break;
+    }
+  }
+  while (success && drawable->pendingFrames() > 0) {
+    success = readNextFrame();
+  }
+  // Discards the frames left in flight and releases the ring surfaces.
+  drawable->setReadbackRingSize(1);
+  return success;
+}
+
 bool CompositionReader::renderFrame(double progress) {
   pagPlayer->setProgress(progress);
   pagPlayer->flush();
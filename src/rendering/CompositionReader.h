@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <functional>
 #include "pag/pag.h"
 #include "rendering/drawables/BitmapDrawable.h"
 #include "rendering/utils/BitmapBuffer.h"
@@ -44,6 +45,16 @@ class CompositionReader {
 
   bool readFrame(double progress, std::shared_ptr<BitmapBuffer> bitmap);
 
+  /**
+   * Renders the frames at the specified progresses in order and copies their pixels into the bitmap
+   * one after another. The callback is invoked with the index of each frame once its pixels are
+   * ready in the bitmap. Up to READBACK_RING_SIZE frames are kept in flight, so a frame is rendered
+   * and submitted while the pixels of the previous one are still being read back. Returns false if
+   * any frame fails to render or read, or the callback returns false to stop reading.
+   */
+  bool readFrames(const std::vector<double>& progresses, std::shared_ptr<BitmapBuffer> bitmap,
+                  const std::function<bool(size_t index)>& callback);
+
  private:
   std::mutex locker = {};
   PAGPlayer* pagPlayer = nullptr;
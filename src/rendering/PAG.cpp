@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "pag/pag.h"
+#include "base/utils/Tracer.h"
 
 namespace pag {
 
@@ -25,4 +26,12 @@ static const char sdkVersion[] = "4.0.0";
 std::string PAG::SDKVersion() {
   return sdkVersion;
 }
+
+void PAG::SetTraceEnabled(bool enabled) {
+  Tracer::SetEnabled(enabled);
+}
+
+bool PAG::DumpTrace(const std::string& filePath) {
+  return Tracer::DumpJSON(filePath, true);
+}
 }  // namespace pag
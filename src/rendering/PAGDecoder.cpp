@@ -20,12 +20,14 @@
 #include "base/utils/Log.h"
 #include "base/utils/TGFXCast.h"
 #include "base/utils/TimeUtil.h"
+#include "base/utils/Tracer.h"
 #include "pag/pag.h"
 #include "rendering/CompositionReader.h"
 #include "rendering/caches/DiskCache.h"
 #include "rendering/layers/ContentVersion.h"
 #include "rendering/utils/BitmapBuffer.h"
 #include "rendering/utils/LockGuard.h"
+#include "tgfx/core/Buffer.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 
 namespace pag {
@@ -181,6 +183,7 @@ bool PAGDecoder::readFrame(int index, HardwareBufferRef hardwareBuffer) {
 }
 
 bool PAGDecoder::readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitmap) {
+  TRACE_SCOPE_ID("PAGDecoder::readFrame", index);
   if (bitmap == nullptr) {
     LOGE("PAGDecoder::readFrame() The specified bitmap buffer is invalid!");
     return false;
@@ -204,24 +207,92 @@ bool PAGDecoder::readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitm
       }
     }
   }
-  if (sequenceFile->isComplete() && composition != nullptr) {
-    if (reader != nullptr) {
-      reader = nullptr;
-      if (composition.use_count() != 1) {
-        container->addLayer(composition);
-      }
-    } else if (composition.use_count() <= 2) {
-      container->removeAllLayers();
-    }
-  }
+  checkComplete(composition);
   if (success) {
     lastReadIndex = index;
   }
   return success;
 }
 
+int PAGDecoder::readFrames(
+    int startIndex, int count,
+    std::function<bool(int index, const void* pixels, size_t rowBytes)> callback,
+    ColorType colorType, AlphaType alphaType) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  TRACE_SCOPE_ID("PAGDecoder::readFrames", startIndex);
+  if (callback == nullptr) {
+    return 0;
+  }
+  auto composition = getComposition();
+  checkCompositionChange(composition);
+  if (startIndex < 0 || startIndex >= _numFrames || count <= 0) {
+    LOGE("PAGDecoder::readFrames() The index is out of range!");
+    return 0;
+  }
+  auto endIndex = std::min(startIndex + count, _numFrames);
+  auto rowBytes = static_cast<size_t>(_width) * 4;
+  auto info =
+      tgfx::ImageInfo::Make(_width, _height, ToTGFX(colorType), ToTGFX(alphaType), rowBytes);
+  tgfx::Buffer pixelBuffer(info.byteSize());
+  auto bitmap = BitmapBuffer::Wrap(info, pixelBuffer.bytes());
+  if (bitmap == nullptr || !checkSequenceFile(composition, info)) {
+    return 0;
+  }
+  int numFrames = 0;
+  auto deliverFrame = [&](int index) {
+    numFrames++;
+    lastReadIndex = index;
+    return callback(index, pixelBuffer.bytes(), rowBytes);
+  };
+  auto index = startIndex;
+  while (index < endIndex) {
+    if (sequenceFile->hasFrame(index)) {
+      if (!sequenceFile->readFrame(index, bitmap) || !deliverFrame(index)) {
+        break;
+      }
+      index++;
+      continue;
+    }
+    // Renders the whole run of uncached frames in one pipeline.
+    auto runEnd = index + 1;
+    while (runEnd < endIndex && !sequenceFile->hasFrame(runEnd)) {
+      runEnd++;
+    }
+    if (!checkReader(composition)) {
+      break;
+    }
+    std::vector<double> progresses = {};
+    for (auto i = index; i < runEnd; i++) {
+      progresses.push_back(FrameToProgress(static_cast<Frame>(i), _numFrames));
+    }
+    auto runStart = index;
+    auto success = reader->readFrames(progresses, bitmap, [&](size_t offset) {
+      auto frameIndex = runStart + static_cast<int>(offset);
+      // Frames in the same static time range share one entry of the sequence file.
+      if (!sequenceFile->hasFrame(frameIndex) && !sequenceFile->writeFrame(frameIndex, bitmap)) {
+        LOGE("PAGDecoder::readFrames() Failed to write frame to SequenceFile!");
+      }
+      index = frameIndex + 1;
+      return deliverFrame(frameIndex);
+    });
+    if (!success) {
+      break;
+    }
+  }
+  checkComplete(composition);
+  return numFrames;
+}
+
 bool PAGDecoder::renderFrame(std::shared_ptr<PAGComposition> composition, int index,
                              std::shared_ptr<BitmapBuffer> bitmap) {
+  if (!checkReader(composition)) {
+    return false;
+  }
+  auto progress = FrameToProgress(static_cast<Frame>(index), _numFrames);
+  return reader->readFrame(progress, bitmap);
+}
+
+bool PAGDecoder::checkReader(std::shared_ptr<PAGComposition> composition) {
   if (composition == nullptr) {
     reader = nullptr;
     LOGE(
@@ -237,8 +308,21 @@ bool PAGDecoder::renderFrame(std::shared_ptr<PAGComposition> composition, int in
     }
     reader->setComposition(composition);
   }
-  auto progress = FrameToProgress(static_cast<Frame>(index), _numFrames);
-  return reader->readFrame(progress, bitmap);
+  return true;
+}
+
+void PAGDecoder::checkComplete(const std::shared_ptr<PAGComposition>& composition) {
+  if (sequenceFile == nullptr || !sequenceFile->isComplete() || composition == nullptr) {
+    return;
+  }
+  if (reader != nullptr) {
+    reader = nullptr;
+    if (composition.use_count() != 1) {
+      container->addLayer(composition);
+    }
+  } else if (composition.use_count() <= 2) {
+    container->removeAllLayers();
+  }
 }
 
 bool PAGDecoder::checkSequenceFile(std::shared_ptr<PAGComposition> composition,
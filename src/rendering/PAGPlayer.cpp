@@ -18,12 +18,16 @@
 
 #include "base/utils/TGFXCast.h"
 #include "base/utils/TimeUtil.h"
+#include "base/utils/Tracer.h"
 #include "pag/file.h"
 #include "rendering/FileReporter.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/caches/TextContentCache.h"
 #include "rendering/drawables/Drawable.h"
 #include "rendering/layers/PAGStage.h"
+#include "rendering/renderers/TextRenderer.h"
 #include "rendering/utils/ApplyScaleMode.h"
+#include "rendering/utils/DamageTracker.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/ScopedLock.h"
 #include "tgfx/core/Clock.h"
@@ -40,6 +44,7 @@ PAGPlayer::~PAGPlayer() {
   setSurface(nullptr);
   stage->removeAllLayers();
   delete reporter;
+  delete damageTracker;
 }
 
 std::shared_ptr<PAGComposition> PAGPlayer::getComposition() {
@@ -100,6 +105,7 @@ void PAGPlayer::setSurfaceInternal(std::shared_ptr<PAGSurface> newSurface) {
   if (pagSurface) {
     pagSurface->pagPlayer = this;
     pagSurface->contentVersion = 0;
+    pagSurface->lastSurface.reset();
     std::atomic_store(&pagSurface->rootLocker, rootLocker);
     updateStageSize();
   } else {
@@ -137,6 +143,16 @@ void PAGPlayer::setUseDiskCache(bool value) {
   renderCache->setUseDiskCache(value);
 }
 
+bool PAGPlayer::imageDownsampling() {
+  LockGuard autoLock(rootLocker);
+  return renderCache->imageDownsampling();
+}
+
+void PAGPlayer::setImageDownsampling(bool value) {
+  LockGuard autoLock(rootLocker);
+  renderCache->setImageDownsampling(value);
+}
+
 float PAGPlayer::cacheScale() {
   LockGuard autoLock(rootLocker);
   return stage->cacheScale();
@@ -145,6 +161,26 @@ float PAGPlayer::cacheScale() {
 void PAGPlayer::setCacheScale(float value) {
   LockGuard autoLock(rootLocker);
   stage->setCacheScale(value);
+  if (damageTracker) {
+    damageTracker->invalidate();
+  }
+}
+
+float PAGPlayer::filterQuality() {
+  LockGuard autoLock(rootLocker);
+  return renderCache->filterQuality();
+}
+
+void PAGPlayer::setFilterQuality(float value) {
+  LockGuard autoLock(rootLocker);
+  if (renderCache->filterQuality() == value) {
+    return;
+  }
+  renderCache->setFilterQuality(value);
+  stage->notifyModified(true);
+  if (damageTracker) {
+    damageTracker->invalidate();
+  }
 }
 
 float PAGPlayer::maxFrameRate() {
@@ -259,6 +295,32 @@ void PAGPlayer::setAutoClear(bool value) {
   }
   _autoClear = value;
   stage->notifyModified(true);
+  if (damageTracker) {
+    damageTracker->invalidate();
+  }
+}
+
+bool PAGPlayer::partialRedraw() {
+  LockGuard autoLock(rootLocker);
+  return damageTracker != nullptr;
+}
+
+void PAGPlayer::setPartialRedraw(bool value) {
+  LockGuard autoLock(rootLocker);
+  if (value == (damageTracker != nullptr)) {
+    return;
+  }
+  if (value) {
+    damageTracker = new DamageTracker();
+  } else {
+    delete damageTracker;
+    damageTracker = nullptr;
+  }
+}
+
+std::vector<Rect> PAGPlayer::getDirtyRegion() {
+  LockGuard autoLock(rootLocker);
+  return pagSurface ? pagSurface->dirtyRegion : std::vector<Rect>{};
 }
 
 void PAGPlayer::prepare() {
@@ -270,6 +332,46 @@ void PAGPlayer::prepare() {
   renderCache->prepareLayers();
 }
 
+int PAGPlayer::prewarmFilters(std::shared_ptr<PAGFile> file) {
+  if (file == nullptr) {
+    return 0;
+  }
+  LockGuard autoLock(rootLocker);
+  if (pagSurface == nullptr) {
+    return 0;
+  }
+  return pagSurface->prewarmFilters(renderCache, file->getFile());
+}
+
+int PAGPlayer::prewarmGlyphs(std::shared_ptr<PAGFile> file) {
+  if (file == nullptr) {
+    return 0;
+  }
+  std::vector<std::shared_ptr<TextContentCache>> textContentCaches = {};
+  {
+    // Replaced texts have their own content caches, so the text layers are collected from the
+    // PAGFile rather than from the File it was created from.
+    LockGuard autoLock(file->rootLocker);
+    auto textLayers = file->getLayersBy(
+        [](PAGLayer* pagLayer) -> bool { return pagLayer->layerType() == LayerType::Text; });
+    for (auto& layer : textLayers) {
+      auto textLayer = static_cast<PAGTextLayer*>(layer.get());
+      textContentCaches.push_back(textLayer->getTextContentCache());
+    }
+  }
+  // Shapes the texts without holding any locker, so the CPU work doesn't block rendering or
+  // editing on other threads.
+  auto textBlocks = CollectTextBlocks(textContentCaches);
+  if (textBlocks.empty()) {
+    return 0;
+  }
+  LockGuard autoLock(rootLocker);
+  if (pagSurface == nullptr) {
+    return 0;
+  }
+  return pagSurface->prewarmGlyphs(renderCache, textBlocks);
+}
+
 void PAGPlayer::prepareInternal() {
   renderCache->beginFrame();
   auto result = updateStageSize();
@@ -278,6 +380,9 @@ void PAGPlayer::prepareInternal() {
     Recorder recorder = {};
     stage->draw(&recorder);
     lastGraphic = recorder.makeGraphic();
+    if (damageTracker) {
+      damageTracker->update(stage.get());
+    }
   }
 }
 
@@ -303,10 +408,19 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
   if (pagSurface == nullptr) {
     return false;
   }
+  TRACE_SCOPE("PAGPlayer::flush");
   tgfx::Clock clock = {};
   prepareInternal();
   clock.mark("rendering");
-  if (!pagSurface->draw(renderCache, lastGraphic, signalSemaphore, _autoClear)) {
+  const std::vector<tgfx::Rect>* damageRects = nullptr;
+  if (damageTracker && !damageTracker->isFullDamage()) {
+    damageRects = &damageTracker->damageRects();
+  }
+  if (!pagSurface->draw(renderCache, lastGraphic, signalSemaphore, _autoClear, damageRects)) {
+    if (damageTracker && pagSurface->contentVersion != renderCache->getContentVersion()) {
+      // The surface missed this frame, so the next damage must be computed from scratch.
+      damageTracker->invalidate();
+    }
     return false;
   }
   clock.mark("presenting");
@@ -17,11 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "base/utils/TGFXCast.h"
+#include "base/utils/Tracer.h"
 #include "pag/file.h"
 #include "pag/pag.h"
+#include "rendering/caches/MaskPathCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/drawables/Drawable.h"
 #include "rendering/graphics/Recorder.h"
+#include "rendering/renderers/FilterRenderer.h"
+#include "rendering/renderers/TextRenderer.h"
 #include "rendering/utils/GLRestorer.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/shaper/TextShaper.h"
@@ -58,6 +62,7 @@ int PAGSurface::height() {
 void PAGSurface::updateSize() {
   LockGuard autoLock(rootLocker);
   TextShaper::PurgeCaches();
+  MaskPathCache::Get()->clear();
   if (pagPlayer) {
     pagPlayer->renderCache->releaseAll();
   }
@@ -72,6 +77,7 @@ void PAGSurface::freeCache() {
 
 void PAGSurface::onFreeCache() {
   TextShaper::PurgeCaches();
+  MaskPathCache::Get()->clear();
   if (pagPlayer) {
     pagPlayer->renderCache->releaseAll();
   }
@@ -95,6 +101,7 @@ bool PAGSurface::clearAll() {
     return false;
   }
   contentVersion = 0;  // 清空画布后 contentVersion 还原为初始值 0.
+  lastSurface.reset();  // 画布已被清空，下一帧不能再局部重绘。
   auto canvas = surface->getCanvas();
   canvas->clear();
   context->flush();
@@ -204,7 +211,10 @@ bool PAGSurface::readPixels(ColorType colorType, AlphaType alphaType, void* dstP
 }
 
 bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
-                      BackendSemaphore* signalSemaphore, bool autoClear) {
+                      BackendSemaphore* signalSemaphore, bool autoClear,
+                      const std::vector<tgfx::Rect>* damageRects) {
+  TRACE_SCOPE("PAGSurface::draw");
+  dirtyRegion.clear();
   auto context = lockContext();
   if (!context) {
     return false;
@@ -222,13 +232,41 @@ bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
     unlockContext();
     return false;
   }
+  // 只有内容在帧间保持不变的同一块 surface 才能局部重绘，否则需要整体重绘。
+  auto partial = damageRects != nullptr && autoClear && drawable->retainsContent() &&
+                 lastSurface.lock() == surface;
+  if (partial && damageRects->empty()) {
+    contentVersion = cache->getContentVersion();
+    unlockContext();
+    return false;
+  }
   contentVersion = cache->getContentVersion();
+  lastSurface = surface;
   cache->attachToContext(context);
   auto canvas = surface->getCanvas();
-  if (autoClear) {
-    canvas->clear();
+  if (partial) {
+    auto dirtyBounds = tgfx::Rect::MakeEmpty();
+    for (auto& rect : *damageRects) {
+      dirtyBounds.join(rect);
+      dirtyRegion.push_back(ToPAG(rect));
+    }
+    // 使用矩形裁剪（scissor）只重绘合并后的脏区域，区域外保留上一帧的内容。
+    canvas->save();
+    canvas->clipRect(dirtyBounds);
+    tgfx::Paint paint = {};
+    paint.setColor(tgfx::Color::Transparent());
+    paint.setBlendMode(tgfx::BlendMode::Src);
+    canvas->drawRect(dirtyBounds, paint);
+  } else {
+    if (autoClear) {
+      canvas->clear();
+    }
+    dirtyRegion.push_back(Rect::MakeWH(surface->width(), surface->height()));
   }
   onDraw(graphic, surface, cache);
+  if (partial) {
+    canvas->restore();
+  }
   std::unique_ptr<tgfx::Recording> recording = nullptr;
   if (signalSemaphore == nullptr) {
     recording = context->flush();
@@ -278,6 +316,31 @@ bool PAGSurface::prepare(RenderCache* cache, std::shared_ptr<Graphic> graphic) {
   return true;
 }
 
+int PAGSurface::prewarmFilters(RenderCache* cache, std::shared_ptr<File> file) {
+  auto context = lockContext();
+  if (!context) {
+    return 0;
+  }
+  cache->attachToContext(context, false);
+  auto count = FilterRenderer::PrewarmFilters(cache, context->gpu(), file.get());
+  cache->detachFromContext();
+  unlockContext();
+  return count;
+}
+
+int PAGSurface::prewarmGlyphs(RenderCache* cache,
+                              const std::vector<std::shared_ptr<TextBlock>>& textBlocks) {
+  auto context = lockContext();
+  if (!context) {
+    return 0;
+  }
+  cache->attachToContext(context, false);
+  auto count = PrewarmGlyphs(cache, textBlocks);
+  cache->detachFromContext();
+  unlockContext();
+  return count;
+}
+
 bool PAGSurface::hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y) {
   if (cache == nullptr || graphic == nullptr) {
     return false;
@@ -24,16 +24,25 @@ std::string Performance::getPerformanceString() const {
   char buffer[300];
   snprintf(buffer, 300,
            "%6.1fms[Render] %6.1fms[Image] %6.1fms[Video]"
-           " %6.1fms[Texture] %6.1fms[Program] %6.1fms[Present] ",
+           " %6.1fms[Texture] %6.1fms[Program] %6.1fms[Present] %5.1f%%[Matte] ",
            static_cast<double>(renderingTime) / 1000.0,
            static_cast<double>(imageDecodingTime) / 1000.0,
            static_cast<double>(softwareDecodingTime + hardwareDecodingTime) / 1000.0,
            static_cast<double>(textureUploadingTime) / 1000.0,
            static_cast<double>(programCompilingTime) / 1000.0,
-           static_cast<double>(presentingTime) / 1000.0);
+           static_cast<double>(presentingTime) / 1000.0,
+           static_cast<double>(trackMatteCacheHitRate()) * 100.0);
   return buffer;
 }
 
+float Performance::trackMatteCacheHitRate() const {
+  auto total = trackMatteCacheHits + trackMatteCacheMisses;
+  if (total == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(trackMatteCacheHits) / static_cast<float>(total);
+}
+
 void Performance::printPerformance(Frame currentFrame) const {
   auto performance = getPerformanceString();
   LOGI("%4d | %6.1fms :%s", currentFrame, static_cast<double>(totalTime) / 1000.0,
@@ -52,5 +61,7 @@ void Performance::resetPerformance() {
   hardwareDecodingInitialTime = 0;
   softwareDecodingInitialTime = 0;
   totalTime = 0;
+  trackMatteCacheHits = 0;
+  trackMatteCacheMisses = 0;
 }
 }  // namespace pag
@@ -40,6 +40,16 @@ class Performance {
   int64_t softwareDecodingInitialTime = 0;
   int64_t totalTime = 0;
 
+  // ======= track matte caches ==========
+  int trackMatteCacheHits = 0;
+  int trackMatteCacheMisses = 0;
+
+  /**
+   * Returns the ratio of the track mattes reused from the caches in the current frame, ranges from
+   * 0.0 to 1.0. Returns 0.0 if no track matte is rendered.
+   */
+  float trackMatteCacheHitRate() const;
+
   /**
    * Returns the formatted  string which contains the performance data.
    */
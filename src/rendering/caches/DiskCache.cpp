@@ -39,6 +39,26 @@ static void RemoveFileTask(std::string path) {
   }
 }
 
+// The types of the journal records.
+static constexpr uint8_t RECORD_ADD = 1;
+static constexpr uint8_t RECORD_REMOVE = 2;
+static constexpr uint8_t RECORD_TOUCH = 3;
+// A record starts with type(1) + fileID(4) + keyLength(4), followed by the key and a checksum(4).
+static constexpr size_t RECORD_HEAD_SIZE = 9;
+static constexpr size_t RECORD_CHECKSUM_SIZE = 4;
+// The journal is compacted once it has more records than the cached files plus this value.
+static constexpr size_t MIN_COMPACTION_RECORDS = 256;
+
+static uint32_t RecordChecksum(const uint8_t* bytes, size_t length) {
+  // FNV-1a, only used to detect the torn or corrupted records.
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
 void DiskCache::RemoveFileAsync(const std::string& filePath) {
   if (filePath.empty()) {
     return;
@@ -83,17 +103,12 @@ std::string DiskCache::getCacheDir() {
 
 void DiskCache::setCacheDir(const std::string& dir) {
   std::lock_guard<std::mutex> autoLock(locker);
-  customCacheDir = dir;
-  // Update cache paths
-  auto cacheDir = dir.empty() ? Platform::Current()->getCacheDir() : dir;
-  if (!cacheDir.empty()) {
-    configPath = Directory::JoinPath(cacheDir, "cache.cfg");
-    cacheFolder = Directory::JoinPath(cacheDir, "files");
-    if (!readConfig()) {
-      Directory::VisitFiles(cacheFolder,
-                            [](const std::string& path, size_t) { RemoveFileAsync(path); });
-    }
+  if (!pendingRecords.empty()) {
+    // Writes the unsaved changes into the config of the previous cache directory.
+    saveConfig();
   }
+  customCacheDir = dir;
+  loadCacheDir(getCacheDir());
 }
 
 DiskCache* DiskCache::GetInstance() {
@@ -115,15 +130,23 @@ bool DiskCache::WriteFile(const std::string& key, std::shared_ptr<tgfx::Data> da
   return GetInstance()->writeFile(key, data);
 }
 
-DiskCache::DiskCache() {
-  auto cacheDir = getCacheDir();
-  if (!cacheDir.empty()) {
-    configPath = Directory::JoinPath(cacheDir, "cache.cfg");
-    cacheFolder = Directory::JoinPath(cacheDir, "files");
-    if (!readConfig()) {
-      Directory::VisitFiles(cacheFolder,
-                            [](const std::string& path, size_t) { RemoveFileAsync(path); });
-    }
+DiskCache::DiskCache(const std::string& cacheDir) : customCacheDir(cacheDir) {
+  loadCacheDir(getCacheDir());
+}
+
+void DiskCache::loadCacheDir(const std::string& cacheDir) {
+  if (cacheDir.empty()) {
+    return;
+  }
+  configPath = Directory::JoinPath(cacheDir, "cache.cfg");
+  journalPath = Directory::JoinPath(cacheDir, "cache.journal");
+  cacheFolder = Directory::JoinPath(cacheDir, "files");
+  pendingRecords.clear();
+  journalRecordCount = 0;
+  journalGeneration++;
+  if (!readConfig()) {
+    Directory::VisitFiles(cacheFolder,
+                          [](const std::string& path, size_t) { RemoveFileAsync(path); });
   }
 }
 
@@ -138,9 +161,7 @@ void DiskCache::setMaxDiskSize(size_t size) {
     return;
   }
   maxDiskSize = size;
-  if (checkDiskSpace(maxDiskSize)) {
-    saveConfig();
-  }
+  checkDiskSpace(maxDiskSize);
 }
 
 void DiskCache::removeAll() {
@@ -177,6 +198,7 @@ std::shared_ptr<SequenceFile> DiskCache::openSequence(
     if (sequenceFile != nullptr) {
       if (sequenceFile->compatible(info, frameCount, frameRate, staticTimeRanges)) {
         moveToFront(cachedFileInfos[fileID]);
+        appendRecord(RECORD_TOUCH, fileID);
         return sequenceFile;
       }
       changeToTemporary(fileID);
@@ -198,9 +220,10 @@ std::shared_ptr<SequenceFile> DiskCache::openSequence(
       totalDiskSize += fileSize - oldFileInfo->fileSize;
       oldFileInfo->fileSize = fileSize;
       moveToFront(oldFileInfo);
+      appendRecord(RECORD_TOUCH, fileID);
     } else {
       addToCachedFiles(std::make_shared<FileInfo>(key, fileID, 0));
-      saveConfig();
+      appendRecord(RECORD_ADD, fileID, key);
     }
   }
   return sequenceFile;
@@ -230,11 +253,8 @@ bool DiskCache::writeFile(const std::string& key, std::shared_ptr<tgfx::Data> da
   if (cacheFolder.empty() || key.empty() || data == nullptr) {
     return false;
   }
-  auto changed = checkDiskSpace(maxDiskSize - data->size());
+  checkDiskSpace(maxDiskSize - data->size());
   if (totalDiskSize + data->size() > maxDiskSize) {
-    if (changed) {
-      saveConfig();
-    }
     return false;
   }
   auto fileID = getFileID(key);
@@ -254,15 +274,13 @@ bool DiskCache::writeFile(const std::string& key, std::shared_ptr<tgfx::Data> da
   if (fileInfo) {
     totalDiskSize -= fileInfo->fileSize;
     fileInfo->fileSize = data->size();
+    appendRecord(RECORD_TOUCH, fileID);
   } else {
     addToCachedFiles(std::make_shared<FileInfo>(key, fileID, data->size()));
     fileInfo = cachedFileInfos[fileID];
-    changed = true;
+    appendRecord(RECORD_ADD, fileID, key);
   }
   moveToBeforeOpenedFiles(fileInfo);
-  if (changed) {
-    saveConfig();
-  }
   return true;
 }
 
@@ -281,6 +299,7 @@ bool DiskCache::checkDiskSpace(size_t maxSize) {
     RemoveFileAsync(filePath);
     totalDiskSize -= fileInfo->fileSize;
     removeFromCachedFiles(fileInfo);
+    appendRecord(RECORD_REMOVE, fileInfo->fileID);
     changed = true;
   }
   return changed;
@@ -319,34 +338,38 @@ void DiskCache::moveToBeforeOpenedFiles(std::shared_ptr<FileInfo> fileInfo) {
 }
 
 bool DiskCache::readConfig() {
+  auto hasConfig = false;
   auto file = fopen(configPath.c_str(), "rb");
-  if (file == nullptr) {
-    return false;
-  }
-  fseek(file, 0, SEEK_END);
-  auto size = ftell(file);
-  if (size == 0) {
+  if (file != nullptr) {
+    fseek(file, 0, SEEK_END);
+    auto size = ftell(file);
+    if (size > 0) {
+      hasConfig = true;
+      fseek(file, 0, SEEK_SET);
+      tgfx::Buffer buffer(size);
+      auto length = fread(buffer.data(), 1, size, file);
+      tgfx::DataView dataView(buffer.bytes(), length);
+      size_t pos = 0;
+      while (pos + 8 < dataView.size()) {
+        auto fileID = dataView.getUint32(pos);
+        auto keyLength = dataView.getUint32(pos + 4);
+        pos += 8;
+        if (pos + keyLength > dataView.size()) {
+          break;
+        }
+        auto cacheKey =
+            std::string(reinterpret_cast<const char*>(dataView.bytes()) + pos, keyLength);
+        pos += keyLength;
+        fileIDCount = std::max(fileIDCount, fileID + 1);
+        addToCachedFiles(std::make_shared<FileInfo>(cacheKey, fileID, 0));
+        cachedFileIDs[cacheKey] = fileID;
+      }
+    }
     fclose(file);
-    return false;
   }
-  fseek(file, 0, SEEK_SET);
-  tgfx::Buffer buffer(size);
-  auto length = fread(buffer.data(), 1, size, file);
-  fclose(file);
-  tgfx::DataView dataView(buffer.bytes(), length);
-  size_t pos = 0;
-  while (pos + 8 < dataView.size()) {
-    auto fileID = dataView.getUint32(pos);
-    auto keyLength = dataView.getUint32(pos + 4);
-    pos += 8;
-    if (pos + keyLength > dataView.size()) {
-      break;
-    }
-    auto cacheKey = std::string(reinterpret_cast<const char*>(dataView.bytes()) + pos, keyLength);
-    pos += keyLength;
-    fileIDCount = std::max(fileIDCount, fileID + 1);
-    addToCachedFiles(std::make_shared<FileInfo>(cacheKey, fileID, 0));
-    cachedFileIDs[cacheKey] = fileID;
+  auto hasJournal = replayJournal();
+  if (!hasConfig && !hasJournal) {
+    return false;
   }
   Directory::VisitFiles(cacheFolder, [&](const std::string& path, size_t fileSize) {
     auto fileID = filePathToID(path);
@@ -368,38 +391,93 @@ bool DiskCache::readConfig() {
   for (auto& item : expiredFiles) {
     removeFromCachedFiles(item);
   }
-  if (checkDiskSpace(maxDiskSize) || !expiredFiles.empty()) {
+  if (checkDiskSpace(maxDiskSize) || !expiredFiles.empty() || hasJournal) {
+    // Compacts the replayed journal into the config.
     saveConfig();
   }
   return true;
 }
 
+bool DiskCache::replayJournal() {
+  auto file = fopen(journalPath.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  fseek(file, 0, SEEK_END);
+  auto size = ftell(file);
+  if (size <= 0) {
+    fclose(file);
+    return false;
+  }
+  fseek(file, 0, SEEK_SET);
+  tgfx::Buffer buffer(size);
+  auto length = fread(buffer.data(), 1, size, file);
+  fclose(file);
+  tgfx::DataView dataView(buffer.bytes(), length);
+  size_t pos = 0;
+  while (pos + RECORD_HEAD_SIZE + RECORD_CHECKSUM_SIZE <= dataView.size()) {
+    auto type = dataView.getUint8(pos);
+    auto fileID = dataView.getUint32(pos + 1);
+    auto keyLength = dataView.getUint32(pos + 5);
+    auto checksumPos = pos + RECORD_HEAD_SIZE + keyLength;
+    if (checksumPos + RECORD_CHECKSUM_SIZE > dataView.size() ||
+        dataView.getUint32(checksumPos) != RecordChecksum(dataView.bytes() + pos, checksumPos - pos)) {
+      // The app exited in the middle of writing this record, the following bytes are discarded.
+      break;
+    }
+    auto result = cachedFileInfos.find(fileID);
+    if (type == RECORD_ADD) {
+      if (result == cachedFileInfos.end()) {
+        auto cacheKey = std::string(
+            reinterpret_cast<const char*>(dataView.bytes()) + pos + RECORD_HEAD_SIZE, keyLength);
+        fileIDCount = std::max(fileIDCount, fileID + 1);
+        addToCachedFiles(std::make_shared<FileInfo>(cacheKey, fileID, 0));
+        cachedFileIDs[cacheKey] = fileID;
+      } else {
+        moveToFront(result->second);
+      }
+    } else if (result != cachedFileInfos.end()) {
+      auto fileInfo = result->second;
+      if (type == RECORD_REMOVE) {
+        cachedFileIDs.erase(fileInfo->cacheKey);
+        removeFromCachedFiles(fileInfo);
+      } else if (type == RECORD_TOUCH) {
+        moveToFront(fileInfo);
+      }
+    }
+    pos = checksumPos + RECORD_CHECKSUM_SIZE;
+  }
+  if (pos < dataView.size()) {
+    LOGE("The journal of the disk cache is truncated at %zu of %zu bytes!", pos, dataView.size());
+  }
+  return true;
+}
+
 void DiskCache::saveConfig() {
+  // All the changes are included in the new config, the pending records of the older generation are
+  // dropped, and the journal is truncated after the new config has been written.
+  pendingRecords.clear();
+  journalRecordCount = 0;
+  journalGeneration++;
   // Serialize the config data in memory while still holding the lock (caller holds locker).
   size_t bufferSize = 0;
   for (auto& item : cachedFiles) {
     bufferSize += 8 + item->cacheKey.size();
   }
-  // If there's nothing to save, write an empty config file synchronously (it's fast).
-  if (bufferSize == 0) {
-    Directory::CreateRecursively(Directory::GetParentDirectory(configPath));
-    auto file = fopen(configPath.c_str(), "wb");
-    if (file != nullptr) {
-      fclose(file);
+  std::shared_ptr<tgfx::Buffer> data = nullptr;
+  if (bufferSize > 0) {
+    data = std::make_shared<tgfx::Buffer>(bufferSize);
+    tgfx::DataView dataView(data->bytes(), data->size());
+    size_t pos = 0;
+    for (auto item = cachedFiles.rbegin(); item != cachedFiles.rend(); item++) {
+      auto& fileInfo = *item;
+      auto& cacheKey = fileInfo->cacheKey;
+      dataView.setUint32(pos, fileInfo->fileID);
+      dataView.setUint32(pos + 4, static_cast<uint32_t>(cacheKey.size()));
+      pos += 8;
+      memcpy(dataView.writableBytes() + pos, cacheKey.data(), cacheKey.size());
+      pos += cacheKey.size();
     }
-    return;
-  }
-  auto data = std::make_shared<tgfx::Buffer>(bufferSize);
-  tgfx::DataView dataView(data->bytes(), data->size());
-  size_t pos = 0;
-  for (auto item = cachedFiles.rbegin(); item != cachedFiles.rend(); item++) {
-    auto& fileInfo = *item;
-    auto& cacheKey = fileInfo->cacheKey;
-    dataView.setUint32(pos, fileInfo->fileID);
-    dataView.setUint32(pos + 4, static_cast<uint32_t>(cacheKey.size()));
-    pos += 8;
-    memcpy(dataView.writableBytes() + pos, cacheKey.data(), cacheKey.size());
-    pos += cacheKey.size();
   }
   // Increment the version to coalesce multiple rapid saves. If a newer save is queued
   // before this one executes, skip this write entirely.
@@ -409,14 +487,45 @@ void DiskCache::saveConfig() {
   // Include PID in temp filename to avoid conflicts when multiple processes share the cache dir.
   auto path = configPath;
   auto tempPath = configPath + ".tmp." + std::to_string(getpid());
+  // The config path is used as the coalescing key, a pending write of an older version is replaced
+  // in the queue instead of being executed and skipped later.
   DiskIOWorker::GetInstance()->submit(
-      std::bind(&DiskCache::WriteConfigTask, path, tempPath, data, currentVersion));
+      std::bind(&DiskCache::WriteConfigTask, this, path, tempPath, journalPath, data,
+                currentVersion),
+      path);
 }
 
-void DiskCache::WriteConfigTask(const std::string& path, const std::string& tempPath,
+void DiskCache::appendRecord(uint8_t type, uint32_t fileID, const std::string& cacheKey) {
+  if (journalPath.empty()) {
+    return;
+  }
+  auto recordSize = RECORD_HEAD_SIZE + cacheKey.size() + RECORD_CHECKSUM_SIZE;
+  auto offset = pendingRecords.size();
+  pendingRecords.resize(offset + recordSize);
+  tgfx::DataView dataView(pendingRecords.data() + offset, recordSize);
+  dataView.setUint8(0, type);
+  dataView.setUint32(1, fileID);
+  dataView.setUint32(5, static_cast<uint32_t>(cacheKey.size()));
+  memcpy(dataView.writableBytes() + RECORD_HEAD_SIZE, cacheKey.data(), cacheKey.size());
+  auto checksumPos = recordSize - RECORD_CHECKSUM_SIZE;
+  dataView.setUint32(checksumPos, RecordChecksum(dataView.bytes(), checksumPos));
+  journalRecordCount++;
+  if (journalRecordCount > cachedFiles.size() + MIN_COMPACTION_RECORDS) {
+    saveConfig();
+    return;
+  }
+  // All the records appended before the task runs are written by the same task. The generation is
+  // part of the key, so the task is never queued before a compaction that was requested earlier.
+  auto key = journalPath + "#" + std::to_string(journalGeneration);
+  DiskIOWorker::GetInstance()->submit(
+      std::bind(&DiskCache::AppendJournalTask, this, journalPath, journalGeneration), key);
+}
+
+void DiskCache::WriteConfigTask(DiskCache* cache, const std::string& path,
+                                const std::string& tempPath, const std::string& journalPath,
                                 std::shared_ptr<tgfx::Buffer> data, uint32_t currentVersion) {
   // Skip this write if a newer version has been queued.
-  if (currentVersion != GetInstance()->configSaveVersion.load(std::memory_order_acquire)) {
+  if (currentVersion != cache->configSaveVersion.load(std::memory_order_acquire)) {
     return;
   }
   Directory::CreateRecursively(Directory::GetParentDirectory(path));
@@ -425,19 +534,51 @@ void DiskCache::WriteConfigTask(const std::string& path, const std::string& temp
     LOGE("Failed to open config file for writing: %s", tempPath.c_str());
     return;
   }
-  auto written = fwrite(data->data(), 1, data->size(), file);
+  auto size = data ? data->size() : 0;
+  auto written = size > 0 ? fwrite(data->data(), 1, size, file) : 0;
   fclose(file);
-  if (written == data->size()) {
-    // Atomic rename to replace the config file.
-    rename(tempPath.c_str(), path.c_str());
+  if (written == size) {
+    // Atomic rename to replace the config file. The journal is only removed after the new config
+    // is in place, replaying an old journal on top of the new config is harmless.
+    if (rename(tempPath.c_str(), path.c_str()) == 0) {
+      remove(journalPath.c_str());
+    }
   } else {
     // Write failed, remove the incomplete temp file.
     LOGE("Failed to write config file: %s (written %zu of %zu bytes)", tempPath.c_str(), written,
-         data->size());
+         size);
     remove(tempPath.c_str());
   }
 }
 
+void DiskCache::AppendJournalTask(DiskCache* cache, const std::string& path, uint32_t generation) {
+  std::vector<uint8_t> records = {};
+  {
+    std::lock_guard<std::mutex> autoLock(cache->locker);
+    // The records have been written into the config by a later compaction.
+    if (generation != cache->journalGeneration) {
+      return;
+    }
+    records.swap(cache->pendingRecords);
+  }
+  if (records.empty()) {
+    return;
+  }
+  Directory::CreateRecursively(Directory::GetParentDirectory(path));
+  auto file = fopen(path.c_str(), "ab");
+  if (file == nullptr) {
+    LOGE("Failed to open journal file for appending: %s", path.c_str());
+    return;
+  }
+  auto written = fwrite(records.data(), 1, records.size(), file);
+  fclose(file);
+  if (written != records.size()) {
+    // The torn record at the end is discarded when the journal is replayed.
+    LOGE("Failed to append journal file: %s (written %zu of %zu bytes)", path.c_str(), written,
+         records.size());
+  }
+}
+
 void DiskCache::CloseFileTask(FILE* fileToClose, DiskCache* cache, uint32_t id) {
   if (fileToClose != nullptr) {
     fclose(fileToClose);
@@ -470,6 +611,7 @@ void DiskCache::changeToTemporary(uint32_t fileID) {
   cachedFileInfos.erase(fileID);
   totalDiskSize -= fileInfo->fileSize;
   cachedFileIDs.erase(fileInfo->cacheKey);
+  appendRecord(RECORD_REMOVE, fileID);
 }
 
 std::string DiskCache::fileIDToPath(uint32_t fileID) {
@@ -494,9 +636,9 @@ void DiskCache::notifyFileClosed(uint32_t fileID) {
   } else {
     auto fileInfo = result->second;
     moveToBeforeOpenedFiles(fileInfo);
-    if (checkDiskSpace(maxDiskSize)) {
-      saveConfig();
-    }
+    // No file is opened when the journal is replayed, so a touch record is enough here.
+    appendRecord(RECORD_TOUCH, fileID);
+    checkDiskSpace(maxDiskSize);
   }
 }
 
@@ -506,9 +648,7 @@ void DiskCache::notifyFileSizeChanged(uint32_t fileID, size_t fileSize) {
   if (result != cachedFileInfos.end()) {
     totalDiskSize += fileSize - result->second->fileSize;
     result->second->fileSize = fileSize;
-    if (checkDiskSpace(maxDiskSize)) {
-      saveConfig();
-    }
+    checkDiskSpace(maxDiskSize);
   }
 }
 
@@ -22,6 +22,7 @@
 #include <list>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 #include "DiskIOWorker.h"
 #include "SequenceFile.h"
 #include "pag/types.h"
@@ -64,13 +65,21 @@ class DiskCache {
   std::unordered_map<uint32_t, std::shared_ptr<FileInfo>> cachedFileInfos = {};
   std::list<std::shared_ptr<FileInfo>> cachedFiles = {};
   std::unordered_map<uint32_t, std::weak_ptr<SequenceFile>> openedFiles = {};
+  std::string journalPath;
+  // The encoded journal records that are waiting to be appended to the journal file.
+  std::vector<uint8_t> pendingRecords = {};
+  // The number of records in the journal file since the last compaction.
+  size_t journalRecordCount = 0;
+  // Incremented on each compaction, the records of older generations are included in the config.
+  uint32_t journalGeneration = 0;
 
   static DiskCache* GetInstance();
 
   std::string getCacheDir();
   void setCacheDir(const std::string& dir);
 
-  DiskCache();
+  explicit DiskCache(const std::string& cacheDir = "");
+  void loadCacheDir(const std::string& cacheDir);
   size_t getMaxDiskSize();
   void setMaxDiskSize(size_t size);
   void removeAll();
@@ -86,7 +95,18 @@ class DiskCache {
   void moveToFront(std::shared_ptr<FileInfo> fileInfo);
   void moveToBeforeOpenedFiles(std::shared_ptr<FileInfo> fileInfo);
   bool readConfig();
+  bool replayJournal();
+
+  /**
+   * Writes all the cached file entries into the config file and truncates the journal.
+   */
   void saveConfig();
+
+  /**
+   * Appends a record of the specified change to the journal. The record is written to the disk
+   * asynchronously, and the journal is compacted once it has grown larger than the config.
+   */
+  void appendRecord(uint8_t type, uint32_t fileID, const std::string& cacheKey = "");
   uint32_t getFileID(const std::string& key);
   void changeToTemporary(uint32_t fileID);
   std::string fileIDToPath(uint32_t fileID);
@@ -100,9 +120,12 @@ class DiskCache {
    */
   static void RemoveFileAsync(const std::string& filePath);
 
-  static void WriteConfigTask(const std::string& path, const std::string& tempPath,
+  static void WriteConfigTask(DiskCache* cache, const std::string& path,
+                              const std::string& tempPath, const std::string& journalPath,
                               std::shared_ptr<tgfx::Buffer> data, uint32_t currentVersion);
 
+  static void AppendJournalTask(DiskCache* cache, const std::string& path, uint32_t generation);
+
   static void CloseFileTask(FILE* fileToClose, DiskCache* cache, uint32_t id);
 
   /**
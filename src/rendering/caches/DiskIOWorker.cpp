@@ -42,13 +42,24 @@ DiskIOWorker::~DiskIOWorker() {
   }
 }
 
-void DiskIOWorker::submit(std::function<void()> task) {
+void DiskIOWorker::submit(std::function<void()> task, const std::string& key) {
   if (task == nullptr) {
     return;
   }
   {
     std::lock_guard<std::mutex> lock(locker);
-    tasks.push(std::move(task));
+    if (!key.empty()) {
+      auto result = keyedTasks.find(key);
+      if (result != keyedTasks.end()) {
+        // The pending task is obsolete, replace it in place.
+        result->second->run = std::move(task);
+        return;
+      }
+    }
+    tasks.push_back({key, std::move(task)});
+    if (!key.empty()) {
+      keyedTasks[key] = std::prev(tasks.end());
+    }
   }
   condition.notify_one();
 }
@@ -68,12 +79,18 @@ void DiskIOWorker::runLoop() {
       if (stopped && tasks.empty()) {
         return;
       }
-      task = std::move(tasks.front());
-      tasks.pop();
+      auto& front = tasks.front();
+      if (!front.key.empty()) {
+        keyedTasks.erase(front.key);
+      }
+      task = std::move(front.run);
+      tasks.pop_front();
       executing = true;
     }
     if (task) {
       task();
+      // Releases the captured objects before the worker is reported idle.
+      task = nullptr;
     }
     {
       std::lock_guard<std::mutex> lock(locker);
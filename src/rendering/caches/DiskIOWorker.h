@@ -21,15 +21,19 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <list>
 #include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
+#include <unordered_map>
 
 namespace pag {
 
 /**
  * A dedicated background worker thread that executes disk IO tasks serially.
- * Tasks are queued and executed in order on a single thread, avoiding main thread blocking.
+ * Tasks are queued and executed in order on a single thread, avoiding main thread blocking. A task
+ * submitted with a key replaces the pending task with the same key, so repeated saves of the same
+ * file only write it once.
  *
  * Lock ordering: DiskIOWorker::locker must be acquired BEFORE DiskCache::locker.
  * IMPORTANT: Never call waitAll() while holding DiskCache::locker, as tasks executed by
@@ -42,9 +46,11 @@ class DiskIOWorker {
   ~DiskIOWorker();
 
   /**
-   * Submits a task for asynchronous execution on the background thread.
+   * Submits a task for asynchronous execution on the background thread. If the key is not empty
+   * and a task with the same key is still pending, the pending task is replaced by the new one and
+   * keeps its position in the queue.
    */
-  void submit(std::function<void()> task);
+  void submit(std::function<void()> task, const std::string& key = "");
 
   /**
    * Waits for all pending tasks to complete. Useful during app shutdown.
@@ -52,6 +58,11 @@ class DiskIOWorker {
   void waitAll();
 
  private:
+  struct Task {
+    std::string key;
+    std::function<void()> run;
+  };
+
   DiskIOWorker();
 
   void runLoop();
@@ -59,7 +70,8 @@ class DiskIOWorker {
   std::mutex locker = {};
   std::condition_variable condition = {};
   std::condition_variable idleCondition = {};
-  std::queue<std::function<void()>> tasks = {};
+  std::list<Task> tasks = {};
+  std::unordered_map<std::string, std::list<Task>::iterator> keyedTasks = {};
   std::thread workerThread = {};
   std::atomic<bool> stopped{false};
   // Tracks if a task is currently being executed. Always accessed under locker, no atomic needed.
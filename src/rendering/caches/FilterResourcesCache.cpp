@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FilterResourcesCache.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace pag {
+struct FilterResourcesKey {
+  uint32_t contextID = 0;
+  ID filterType = 0;
+  size_t shaderHash = 0;
+
+  bool operator==(const FilterResourcesKey& other) const {
+    return contextID == other.contextID && filterType == other.filterType &&
+           shaderHash == other.shaderHash;
+  }
+};
+
+struct FilterResourcesKeyHasher {
+  size_t operator()(const FilterResourcesKey& key) const {
+    size_t hash = key.shaderHash;
+    hash ^= key.contextID + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= key.filterType + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
+static std::unordered_map<FilterResourcesKey, std::weak_ptr<FilterResources>,
+                          FilterResourcesKeyHasher>
+    FilterResourcesMap = {};
+static std::mutex locker = {};
+
+std::shared_ptr<FilterResources> FilterResourcesCache::Find(uint32_t contextID, ID filterType,
+                                                            size_t shaderHash) {
+  if (contextID == 0) {
+    return nullptr;
+  }
+  FilterResourcesKey key = {contextID, filterType, shaderHash};
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = FilterResourcesMap.find(key);
+  if (result == FilterResourcesMap.end()) {
+    return nullptr;
+  }
+  auto resources = result->second.lock();
+  if (resources == nullptr) {
+    FilterResourcesMap.erase(result);
+  }
+  return resources;
+}
+
+void FilterResourcesCache::Add(uint32_t contextID, ID filterType, size_t shaderHash,
+                               std::shared_ptr<FilterResources> resources) {
+  if (contextID == 0 || resources == nullptr) {
+    return;
+  }
+  FilterResourcesKey key = {contextID, filterType, shaderHash};
+  std::lock_guard<std::mutex> autoLock(locker);
+  for (auto iter = FilterResourcesMap.begin(); iter != FilterResourcesMap.end();) {
+    if (iter->second.expired()) {
+      iter = FilterResourcesMap.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+  FilterResourcesMap[key] = resources;
+}
+}  // namespace pag
@@ -0,0 +1,46 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "rendering/filters/RuntimeFilter.h"
+
+namespace pag {
+/**
+ * FilterResourcesCache shares the compiled pipelines of RuntimeFilters between all RenderCaches
+ * that render to the same GPU context, so a newly created PAGPlayer doesn't have to compile the
+ * shaders that another player has already compiled. Entries are held weakly and expire once the
+ * last RenderCache that references them is released.
+ */
+class FilterResourcesCache {
+ public:
+  /**
+   * Returns the FilterResources previously added for the specified context, filter type and
+   * shader source hash. Returns nullptr if there is no live entry.
+   */
+  static std::shared_ptr<FilterResources> Find(uint32_t contextID, ID filterType,
+                                               size_t shaderHash);
+
+  /**
+   * Adds the FilterResources to the cache, and removes all expired entries at the same time.
+   */
+  static void Add(uint32_t contextID, ID filterType, size_t shaderHash,
+                  std::shared_ptr<FilterResources> resources);
+};
+}  // namespace pag
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FilterResultCache.h"
+
+namespace pag {
+size_t FilterResultKeyHasher::operator()(const FilterResultKey& key) const {
+  size_t hash = std::hash<ID>()(key.layerID);
+  auto combine = [&hash](size_t value) {
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+  combine(std::hash<Frame>()(key.layerFrame));
+  combine(std::hash<int>()(key.scaleLevel));
+  combine(std::hash<float>()(key.clipBounds.left));
+  combine(std::hash<float>()(key.clipBounds.top));
+  combine(std::hash<float>()(key.clipBounds.right));
+  combine(std::hash<float>()(key.clipBounds.bottom));
+  return hash;
+}
+
+static size_t GetImageMemoryUsage(const tgfx::Image* image) {
+  return static_cast<size_t>(image->width()) * static_cast<size_t>(image->height()) * 4;
+}
+
+const FilterResult* FilterResultCache::find(const FilterResultKey& key) {
+  auto position = positions.find(key);
+  if (position == positions.end()) {
+    return nullptr;
+  }
+  entries.splice(entries.begin(), entries, position->second);
+  return &position->second->result;
+}
+
+void FilterResultCache::add(const FilterResultKey& key, FilterResult result) {
+  if (result.image == nullptr) {
+    return;
+  }
+  auto memoryUsage = GetImageMemoryUsage(result.image.get());
+  if (memoryUsage > _memoryBudget) {
+    return;
+  }
+  auto position = positions.find(key);
+  if (position != positions.end()) {
+    _memoryUsage -= position->second->memoryUsage;
+    entries.erase(position->second);
+    positions.erase(position);
+  }
+  purgeToFit(_memoryBudget - memoryUsage);
+  entries.push_front({key, std::move(result), memoryUsage});
+  positions[key] = entries.begin();
+  _memoryUsage += memoryUsage;
+}
+
+void FilterResultCache::setMemoryBudget(size_t value) {
+  _memoryBudget = value;
+  purgeToFit(_memoryBudget);
+}
+
+void FilterResultCache::removeLayers(const std::unordered_set<ID>& layerIDs) {
+  for (auto entry = entries.begin(); entry != entries.end();) {
+    if (layerIDs.count(entry->key.layerID) == 0) {
+      ++entry;
+      continue;
+    }
+    _memoryUsage -= entry->memoryUsage;
+    positions.erase(entry->key);
+    entry = entries.erase(entry);
+  }
+}
+
+void FilterResultCache::clear() {
+  entries.clear();
+  positions.clear();
+  _memoryUsage = 0;
+}
+
+void FilterResultCache::purgeToFit(size_t budget) {
+  while (_memoryUsage > budget && !entries.empty()) {
+    auto& entry = entries.back();
+    _memoryUsage -= entry.memoryUsage;
+    positions.erase(entry.key);
+    entries.pop_back();
+  }
+}
+}  // namespace pag
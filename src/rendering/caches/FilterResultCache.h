@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include "pag/types.h"
+#include "tgfx/core/Image.h"
+#include "tgfx/core/Rect.h"
+
+namespace pag {
+/**
+ * Identifies a filtered result of a layer. The filter parameters of a layer are fully determined by
+ * its layer frame, so the frame stands in for the animated parameters. The content scale is
+ * quantized to the same steps that FilterRenderer snaps it to.
+ */
+struct FilterResultKey {
+  ID layerID = 0;
+  Frame layerFrame = 0;
+  int scaleLevel = 0;
+  tgfx::Rect clipBounds = tgfx::Rect::MakeEmpty();
+
+  bool operator==(const FilterResultKey& other) const {
+    return layerID == other.layerID && layerFrame == other.layerFrame &&
+           scaleLevel == other.scaleLevel && clipBounds == other.clipBounds;
+  }
+};
+
+struct FilterResultKeyHasher {
+  size_t operator()(const FilterResultKey& key) const;
+};
+
+/**
+ * The output image of a filter chain and its offset relative to the content bounds.
+ */
+struct FilterResult {
+  std::shared_ptr<tgfx::Image> image = nullptr;
+  tgfx::Point offset = tgfx::Point::Zero();
+};
+
+/**
+ * FilterResultCache keeps the filtered results of layers with animated filters, so a looping
+ * animation replays them from the cache on its second cycle instead of running the filter chain
+ * again. Entries are evicted in least-recently-used order once the total memory exceeds the budget.
+ */
+class FilterResultCache {
+ public:
+  explicit FilterResultCache(size_t memoryBudget) : _memoryBudget(memoryBudget) {
+  }
+
+  /**
+   * Returns the cached result of the specified key, or nullptr if there is none.
+   */
+  const FilterResult* find(const FilterResultKey& key);
+
+  /**
+   * Adds the specified result to the cache, evicting the least recently used entries to keep the
+   * memory usage within budget. Results larger than the budget are ignored.
+   */
+  void add(const FilterResultKey& key, FilterResult result);
+
+  /**
+   * Removes the cached results of the specified layers.
+   */
+  void removeLayers(const std::unordered_set<ID>& layerIDs);
+
+  /**
+   * Returns the memory used by all cached results in bytes. The results are GPU textures, so the
+   * memory is also counted by the GPU context they were created on.
+   */
+  size_t memoryUsage() const {
+    return _memoryUsage;
+  }
+
+  size_t memoryBudget() const {
+    return _memoryBudget;
+  }
+
+  /**
+   * Sets the memory budget in bytes and evicts entries that no longer fit.
+   */
+  void setMemoryBudget(size_t value);
+
+  void clear();
+
+ private:
+  struct Entry {
+    FilterResultKey key = {};
+    FilterResult result = {};
+    size_t memoryUsage = 0;
+  };
+
+  size_t _memoryBudget = 0;
+  size_t _memoryUsage = 0;
+  std::list<Entry> entries = {};
+  std::unordered_map<FilterResultKey, std::list<Entry>::iterator, FilterResultKeyHasher>
+      positions = {};
+
+  void purgeToFit(size_t budget);
+};
+}  // namespace pag
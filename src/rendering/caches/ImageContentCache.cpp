@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ImageContentCache.h"
+#include "base/utils/ImagePool.h"
 #include "rendering/graphics/Picture.h"
 
 namespace pag {
@@ -32,9 +33,8 @@ ImageBytesCache* ImageBytesCache::Get(ImageBytes* imageBytes) {
     return static_cast<ImageBytesCache*>(imageBytes->cache);
   }
   auto cache = new ImageBytesCache();
-  auto fileBytes =
-      tgfx::Data::MakeWithCopy(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
-  auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
+  auto image =
+      ImagePool::MakeFromEncoded(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
   auto picture = Picture::MakeFrom(imageBytes->uniqueID, image);
   auto matrix = tgfx::Matrix::MakeScale(1 / imageBytes->scaleFactor);
   matrix.postTranslate(static_cast<float>(-imageBytes->anchorX),
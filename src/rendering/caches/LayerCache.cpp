@@ -106,6 +106,13 @@ Content* LayerCache::getContent(Frame contentFrame) {
   return contentCache->getCache(contentFrame);
 }
 
+TextContentCache* LayerCache::getTextContentCache() const {
+  if (layer->type() != LayerType::Text) {
+    return nullptr;
+  }
+  return static_cast<TextContentCache*>(contentCache);
+}
+
 Layer* LayerCache::getLayer() const {
   return layer;
 }
@@ -25,6 +25,8 @@
 #include "rendering/graphics/Modifier.h"
 
 namespace pag {
+class TextContentCache;
+
 class LayerCache : public Cache {
  public:
   static LayerCache* Get(Layer* layer);
@@ -33,12 +35,21 @@ class LayerCache : public Cache {
 
   Transform* getTransform(Frame contentFrame);
 
+  TransformCache* getTransformCache() const {
+    return transformCache;
+  }
+
   tgfx::Path* getMasks(Frame contentFrame);
 
   std::shared_ptr<Modifier> getFeatherMask(Frame contentFrame);
 
   Content* getContent(Frame contentFrame);
 
+  /**
+   * Returns the content cache of the layer if it is a text layer, or nullptr otherwise.
+   */
+  TextContentCache* getTextContentCache() const;
+
   Layer* getLayer() const;
 
   std::pair<tgfx::Point, tgfx::Point> getScaleFactor() const;
@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MaskPathCache.h"
+#include "base/utils/UniqueID.h"
+#include "rendering/utils/MemoryCalculator.h"
+
+namespace pag {
+static constexpr size_t MAX_MASK_PATH_MEMORY = 16777216;  // 16M
+
+static void HashCombine(size_t* hash, size_t value) {
+  *hash ^= value + 0x9e3779b9 + (*hash << 6) + (*hash >> 2);
+}
+
+bool MaskInput::operator==(const MaskInput& other) const {
+  if (hash != other.hash || expansion != other.expansion || opacity != other.opacity ||
+      feather != other.feather || mode != other.mode || inverted != other.inverted) {
+    return false;
+  }
+  return path.verbs == other.path.verbs && path.points == other.path.points;
+}
+
+MaskInput MakeMaskInput(MaskData* mask, Frame layerFrame) {
+  MaskInput input = {};
+  auto path = mask->maskPath->getValueAt(layerFrame);
+  if (path != nullptr) {
+    input.path = *path;
+  }
+  input.expansion = mask->maskExpansion->getValueAt(layerFrame);
+  input.opacity = mask->maskOpacity->getValueAt(layerFrame);
+  if (mask->maskFeather != nullptr) {
+    input.feather = mask->maskFeather->getValueAt(layerFrame);
+  }
+  input.mode = mask->maskMode;
+  input.inverted = mask->inverted;
+  size_t hash = 0;
+  HashCombine(&hash, input.path.verbs.size());
+  for (auto& verb : input.path.verbs) {
+    HashCombine(&hash, static_cast<size_t>(verb));
+  }
+  for (auto& point : input.path.points) {
+    HashCombine(&hash, std::hash<float>()(point.x));
+    HashCombine(&hash, std::hash<float>()(point.y));
+  }
+  HashCombine(&hash, std::hash<float>()(input.expansion));
+  HashCombine(&hash, input.opacity);
+  HashCombine(&hash, std::hash<float>()(input.feather.x));
+  HashCombine(&hash, std::hash<float>()(input.feather.y));
+  HashCombine(&hash, static_cast<size_t>(input.mode));
+  HashCombine(&hash, input.inverted);
+  input.hash = hash;
+  return input;
+}
+
+size_t MaskPathKeyHasher::operator()(const MaskPathKey& key) const {
+  auto hash = key.mask.hash;
+  HashCombine(&hash, std::hash<ID>()(key.previousID));
+  return hash;
+}
+
+MaskPathCache* MaskPathCache::Get() {
+  static auto& cache = *new MaskPathCache(MAX_MASK_PATH_MEMORY);
+  return &cache;
+}
+
+ID MaskPathCache::find(const MaskPathKey& key, tgfx::Path* path) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto position = positions.find(key);
+  if (position == positions.end()) {
+    return 0;
+  }
+  entries.splice(entries.begin(), entries, position->second);
+  *path = position->second->path;
+  return position->second->id;
+}
+
+ID MaskPathCache::add(const MaskPathKey& key, const tgfx::Path& path) {
+  auto id = UniqueID::Next();
+  auto memoryUsage =
+      MemoryCalculator::GetPathMemory(path) + MemoryCalculator::GetPathDataMemory(key.mask.path);
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (memoryUsage > _memoryBudget) {
+    // The result is still returned with a new ID, the masks after it are just not cached either.
+    return id;
+  }
+  auto position = positions.find(key);
+  if (position != positions.end()) {
+    _memoryUsage -= position->second->memoryUsage;
+    entries.erase(position->second);
+    positions.erase(position);
+  }
+  purgeToFit(_memoryBudget - memoryUsage);
+  entries.push_front({key, id, path, memoryUsage});
+  positions[key] = entries.begin();
+  _memoryUsage += memoryUsage;
+  return id;
+}
+
+size_t MaskPathCache::memoryUsage() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _memoryUsage;
+}
+
+size_t MaskPathCache::memoryBudget() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _memoryBudget;
+}
+
+void MaskPathCache::setMemoryBudget(size_t value) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  _memoryBudget = value;
+  purgeToFit(_memoryBudget);
+}
+
+void MaskPathCache::purgeUntilMemoryTo(size_t bytesLimit) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  purgeToFit(bytesLimit);
+}
+
+void MaskPathCache::clear() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  entries.clear();
+  positions.clear();
+  _memoryUsage = 0;
+}
+
+void MaskPathCache::purgeToFit(size_t budget) {
+  while (_memoryUsage > budget && !entries.empty()) {
+    auto& entry = entries.back();
+    _memoryUsage -= entry.memoryUsage;
+    positions.erase(entry.key);
+    entries.pop_back();
+  }
+}
+}  // namespace pag
@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "pag/file.h"
+#include "tgfx/core/Path.h"
+
+namespace pag {
+/**
+ * The values of a mask at a frame. Masks with equal inputs produce the same mask path, no matter
+ * which frame or layer they come from. The path is copied, so a cached input never keeps the path
+ * data of a released file alive.
+ */
+struct MaskInput {
+  PathData path = {};
+  float expansion = 0;
+  Opacity opacity = Opaque;
+  Point feather = Point::Zero();
+  MaskMode mode = MaskMode::None;
+  bool inverted = false;
+  // The hash of the values above, which is computed once by MakeMaskInput().
+  size_t hash = 0;
+
+  bool operator==(const MaskInput& other) const;
+};
+
+MaskInput MakeMaskInput(MaskData* mask, Frame layerFrame);
+
+/**
+ * Identifies the combined path of a chain of masks. The masks before the last one are represented
+ * by the ID of their cached result, so each entry only needs to compare the values of one mask.
+ */
+struct MaskPathKey {
+  ID previousID = 0;
+  MaskInput mask = {};
+
+  bool operator==(const MaskPathKey& other) const {
+    return previousID == other.previousID && mask == other.mask;
+  }
+};
+
+struct MaskPathKeyHasher {
+  size_t operator()(const MaskPathKey& key) const;
+};
+
+/**
+ * MaskPathCache keeps the combined paths of masks by their values. When only some masks of a layer
+ * are animated, the results of the static masks before them are looked up from the cache, and only
+ * the path operations from the first changed mask onwards are evaluated again. Entries are evicted
+ * in least-recently-used order once the total memory exceeds the budget.
+ */
+class MaskPathCache {
+ public:
+  /**
+   * Returns the cache shared by all layers. The instance is never destroyed, since masks may still
+   * be rendered while other static objects are destroyed at exit.
+   */
+  static MaskPathCache* Get();
+
+  explicit MaskPathCache(size_t memoryBudget) : _memoryBudget(memoryBudget) {
+  }
+
+  /**
+   * Finds the cached path of the specified key. Returns the ID of the result, or 0 if there is
+   * none.
+   */
+  ID find(const MaskPathKey& key, tgfx::Path* path);
+
+  /**
+   * Adds the path of the specified key to the cache and returns the ID of the new result.
+   */
+  ID add(const MaskPathKey& key, const tgfx::Path& path);
+
+  /**
+   * Returns the memory used by all cached paths and the mask paths in their keys, in bytes.
+   */
+  size_t memoryUsage();
+
+  size_t memoryBudget();
+
+  void setMemoryBudget(size_t value);
+
+  /**
+   * Evicts the least recently used entries until the memory usage is no more than the specified
+   * bytes. The budget is not changed, so the cache can grow again afterward.
+   */
+  void purgeUntilMemoryTo(size_t bytesLimit);
+
+  void clear();
+
+ private:
+  struct Entry {
+    MaskPathKey key = {};
+    ID id = 0;
+    tgfx::Path path = {};
+    size_t memoryUsage = 0;
+  };
+
+  std::mutex locker = {};
+  size_t _memoryBudget = 0;
+  size_t _memoryUsage = 0;
+  std::list<Entry> entries = {};
+  std::unordered_map<MaskPathKey, std::list<Entry>::iterator, MaskPathKeyHasher> positions = {};
+
+  void purgeToFit(size_t budget);
+};
+}  // namespace pag
@@ -18,10 +18,12 @@
 
 #include "RenderCache.h"
 #include <functional>
+#include "base/utils/ImagePool.h"
 #include "base/utils/TimeUtil.h"
 #include "base/utils/UniqueID.h"
 #include "rendering/caches/ImageContentCache.h"
 #include "rendering/caches/LayerCache.h"
+#include "rendering/caches/MaskPathCache.h"
 #include "rendering/editing/ImageReplacement.h"
 #include "rendering/renderers/FilterRenderer.h"
 #include "rendering/sequences/SequenceImageProxy.h"
@@ -33,11 +35,15 @@ namespace pag {
 static constexpr int MAX_GRAPHICS_MEMORY = 314572800;
 static constexpr int PURGEABLE_GRAPHICS_MEMORY = 20971520;  // 20M
 static constexpr int PURGEABLE_EXPIRED_FRAME = 10;
+// 动画滤镜结果的缓存上限，足够缓存中等尺寸图层一个循环周期内的所有帧。
+static constexpr size_t MAX_FILTER_RESULT_MEMORY = 67108864;  // 64M
 static constexpr float SCALE_FACTOR_PRECISION = 0.001f;
 static constexpr float MIPMAP_ENABLED_THRESHOLD = 0.4f;
+static constexpr float MIN_DECODE_SCALE = 0.125f;
 static constexpr int64_t DECODING_VISIBLE_DISTANCE = 500000;  // 提前 500ms 开始解码。
 
-RenderCache::RenderCache(PAGStage* stage) : _uniqueID(UniqueID::Next()), stage(stage) {
+RenderCache::RenderCache(PAGStage* stage)
+    : _uniqueID(UniqueID::Next()), stage(stage), filterResultCache(MAX_FILTER_RESULT_MEMORY) {
 }
 
 RenderCache::~RenderCache() {
@@ -60,6 +66,10 @@ void RenderCache::setVideoEnabled(bool value) {
   clearAllSequenceCaches();
 }
 
+float RenderCache::getAssetMaxScale(ID assetID) {
+  return stage->getAssetMaxScale(assetID);
+}
+
 void RenderCache::prepareLayers() {
   int64_t timeDistance = DECODING_VISIBLE_DISTANCE;
 #ifdef PAG_BUILD_FOR_WEB
@@ -150,10 +160,23 @@ void RenderCache::setSnapshotEnabled(bool value) {
   clearAllSnapshots();
 }
 
+void RenderCache::setFilterQuality(float value) {
+  value = std::max(0.0f, std::min(value, 1.0f));
+  if (_filterQuality == value) {
+    return;
+  }
+  _filterQuality = value;
+  // The cached filter outputs are rendered at the previous working resolutions.
+  clearAllSnapshots();
+  filterResultCache.clear();
+}
+
 void RenderCache::beginFrame() {
   usedAssets = {};
   usedSequences = {};
   resetPerformance();
+  stage->trackMatteCacheHits = 0;
+  stage->trackMatteCacheMisses = 0;
 }
 
 void RenderCache::attachToContext(tgfx::Context* current, bool forDrawing) {
@@ -173,9 +196,14 @@ void RenderCache::attachToContext(tgfx::Context* current, bool forDrawing) {
   for (auto assetID : removedAssets) {
     removeSnapshot(assetID);
     assetImages.erase(assetID);
+    assetImageScales.erase(assetID);
     decodedAssetImages.erase(assetID);
     clearSequenceCache(assetID);
   }
+  // 滤镜结果以 Layer 的 uniqueID 为键，图层离开舞台后它们不会再被命中。
+  if (!removedAssets.empty()) {
+    filterResultCache.removeLayers(removedAssets);
+  }
 }
 
 void RenderCache::releaseAll() {
@@ -183,6 +211,7 @@ void RenderCache::releaseAll() {
   graphicsMemory = 0;
   clearAllSequenceCaches();
   filterResourcesMap.clear();
+  filterResultCache.clear();
   contextID = 0;
 }
 
@@ -199,11 +228,14 @@ void RenderCache::detachFromContext() {
     // Always purge recycled resources that haven't been used in 1 frame.
     context->purgeResourcesNotUsedSince(timestamps.back());
   }
-  if (context->memoryUsage() + graphicsMemory > PURGEABLE_GRAPHICS_MEMORY &&
+  if (context->memoryUsage() + memoryUsage() > PURGEABLE_GRAPHICS_MEMORY &&
       timestamps.size() == PURGEABLE_EXPIRED_FRAME) {
     // Purge all types of resources that haven't been used in 10 frames when the total memory usage
     // is over 20M.
     context->purgeResourcesNotUsedSince(timestamps.front());
+    // The mask paths shared by all layers are trimmed to half of their budget at the same time.
+    auto maskPathCache = MaskPathCache::Get();
+    maskPathCache->purgeUntilMemoryTo(maskPathCache->memoryBudget() / 2);
   }
   timestamps.push(std::chrono::steady_clock::now());
   while (timestamps.size() > PURGEABLE_EXPIRED_FRAME) {
@@ -346,21 +378,54 @@ std::shared_ptr<tgfx::Image> RenderCache::getAssetImage(ID assetID, const ImageP
   return getAssetImageInternal(assetID, proxy);
 }
 
+/**
+ * Returns the power-of-two fraction of the original size to decode an image at, which is the
+ * smallest one that still covers the max scale. Most codecs can downscale by these fractions
+ * natively during decoding.
+ */
+static float GetDecodeScale(float maxScale) {
+  auto decodeScale = 1.0f;
+  if (maxScale <= 0 || maxScale >= 1.0f) {
+    return decodeScale;
+  }
+  while (decodeScale * 0.5f >= maxScale && decodeScale > MIN_DECODE_SCALE) {
+    decodeScale *= 0.5f;
+  }
+  return decodeScale;
+}
+
 std::shared_ptr<tgfx::Image> RenderCache::getAssetImageInternal(ID assetID,
                                                                 const ImageProxy* proxy) {
-  auto image = assetImages[assetID];
-  if (image != nullptr) {
-    return image;
+  auto decodeScale = 1.0f;
+  if (_imageDownsampling && proxy->isScalable()) {
+    decodeScale = GetDecodeScale(stage->getAssetMaxScale(assetID));
+  }
+  auto result = assetImages.find(assetID);
+  // Only decodes the image again when the max scale has grown beyond the decoded size.
+  if (result != assetImages.end() && result->second != nullptr &&
+      assetImageScales[assetID] >= decodeScale) {
+    return result->second;
   }
-  image = proxy->makeImage(this);
+  auto image = proxy->makeImage(this);
   if (image == nullptr) {
     return nullptr;
   }
-  auto scaleFactor = stage->getAssetMinScale(assetID);
+  if (decodeScale < 1.0f) {
+    auto width = static_cast<int>(ceilf(static_cast<float>(image->width()) * decodeScale));
+    auto height = static_cast<int>(ceilf(static_cast<float>(image->height()) * decodeScale));
+    auto scaledImage = image->makeScaled(width, height);
+    if (scaledImage != nullptr) {
+      image = scaledImage;
+    } else {
+      decodeScale = 1.0f;
+    }
+  }
+  auto scaleFactor = stage->getAssetMinScale(assetID) / decodeScale;
   if (scaleFactor < MIPMAP_ENABLED_THRESHOLD) {
-    image = image->makeMipmapped(true);
+    image = ImagePool::MakeMipmapped(std::move(image));
   }
   assetImages[assetID] = image;
+  assetImageScales[assetID] = decodeScale;
   return image;
 }
 
@@ -510,6 +575,8 @@ std::shared_ptr<File> RenderCache::getFileByAssetID(ID assetID) {
 }
 
 void RenderCache::recordPerformance() {
+  trackMatteCacheHits = stage->trackMatteCacheHits;
+  trackMatteCacheMisses = stage->trackMatteCacheMisses;
   for (auto& item : sequenceCaches) {
     for (auto& queue : item.second) {
       queue->reportPerformance(this);
@@ -537,10 +604,18 @@ FilterResources* RenderCache::findFilterResources(ID type) {
   return nullptr;
 }
 
-void RenderCache::addFilterResources(ID type, std::unique_ptr<FilterResources> resources) {
+void RenderCache::addFilterResources(ID type, std::shared_ptr<FilterResources> resources) {
   if (resources == nullptr) {
     return;
   }
   filterResourcesMap[type] = std::move(resources);
 }
+
+const FilterResult* RenderCache::findFilterResult(const FilterResultKey& key) {
+  return filterResultCache.find(key);
+}
+
+void RenderCache::addFilterResult(const FilterResultKey& key, FilterResult result) {
+  filterResultCache.add(key, std::move(result));
+}
 }  // namespace pag
@@ -22,6 +22,7 @@
 #include <memory>
 #include <queue>
 #include <unordered_set>
+#include "FilterResultCache.h"
 #include "TextBlock.h"
 #include "pag/file.h"
 #include "pag/pag.h"
@@ -71,6 +72,12 @@ class RenderCache : public Performance {
     return context;
   }
 
+  /**
+   * Returns the maximum scale factor of the specified asset on the stage of this cache, or 0 if the
+   * asset is not displayed on the stage.
+   */
+  float getAssetMaxScale(ID assetID);
+
   /**
    * Prepares the nearly visible layers for the upcoming drawings, which collects all CPU tasks and
    * runs them asynchronously in parallel.
@@ -94,6 +101,19 @@ class RenderCache : public Performance {
     return snapshotCaches.count(assetID) > 0;
   }
 
+  /**
+   * Returns the quality of the blur-like filters, ranges from 0.0 to 1.0. See
+   * PAGPlayer::filterQuality() for details.
+   */
+  float filterQuality() const {
+    return _filterQuality;
+  }
+
+  /**
+   * Set the value of filterQuality property.
+   */
+  void setFilterQuality(float value);
+
   /**
    * If set to true, PAG will cache the associated rendering data into a disk file, such as the
    * decoded image frames of video compositions. This can help reduce memory usage and improve
@@ -110,6 +130,21 @@ class RenderCache : public Performance {
     _useDiskCache = value;
   }
 
+  /**
+   * If set to true, scalable asset images are decoded at a smaller size when they are only
+   * displayed downscaled. Images decoded smaller are decoded again at full size once it is off.
+   */
+  bool imageDownsampling() const {
+    return _imageDownsampling;
+  }
+
+  /**
+   * Set the value of imageDownsampling property.
+   */
+  void setImageDownsampling(bool value) {
+    _imageDownsampling = value;
+  }
+
   /**
    * Returns a snapshot cache of specified asset id. Returns null if there is no associated cache
    * available. This is a read-only query which is used usually during hit testing.
@@ -161,7 +196,32 @@ class RenderCache : public Performance {
 
   FilterResources* findFilterResources(ID type);
 
-  void addFilterResources(ID type, std::unique_ptr<FilterResources> resources);
+  void addFilterResources(ID type, std::shared_ptr<FilterResources> resources);
+
+  /**
+   * Returns the cached filtered result of the specified key, or nullptr if there is none.
+   */
+  const FilterResult* findFilterResult(const FilterResultKey& key);
+
+  /**
+   * Caches the filtered result of the specified key within the filter result memory budget.
+   */
+  void addFilterResult(const FilterResultKey& key, FilterResult result);
+
+  /**
+   * Returns the maximum memory in bytes that the cached filtered results can use.
+   */
+  size_t filterResultMemoryBudget() const {
+    return filterResultCache.memoryBudget();
+  }
+
+  /**
+   * Sets the maximum memory in bytes that the cached filtered results can use. Set it to 0 to
+   * disable the filter result caching.
+   */
+  void setFilterResultMemoryBudget(size_t value) {
+    filterResultCache.setMemoryBudget(value);
+  }
 
   void releaseAll();
 
@@ -176,11 +236,15 @@ class RenderCache : public Performance {
   bool _videoEnabled = true;
   bool _snapshotEnabled = true;
   bool _useDiskCache = false;
+  bool _imageDownsampling = false;
+  float _filterQuality = 1.0f;
   std::unordered_set<ID> usedAssets = {};
   std::unordered_map<ID, Snapshot*> snapshotCaches = {};
   std::list<Snapshot*> snapshotLRU = {};
   std::unordered_map<Snapshot*, std::list<Snapshot*>::iterator> snapshotPositions = {};
   std::unordered_map<ID, std::shared_ptr<tgfx::Image>> assetImages = {};
+  // The scales the asset images are decoded at, relative to the sizes of their proxies.
+  std::unordered_map<ID, float> assetImageScales = {};
   std::unordered_map<ID, std::shared_ptr<tgfx::Image>> decodedAssetImages = {};
   std::unordered_map<ID, std::vector<SequenceImageQueue*>> sequenceCaches = {};
   std::unordered_map<ID, std::unordered_map<Frame, SequenceImageQueue*>> usedSequences = {};
@@ -210,7 +274,10 @@ class RenderCache : public Performance {
   void recordPerformance();
 
   // filter resources cache:
-  std::unordered_map<ID, std::unique_ptr<FilterResources>> filterResourcesMap = {};
+  std::unordered_map<ID, std::shared_ptr<FilterResources>> filterResourcesMap = {};
+
+  // filter result cache:
+  FilterResultCache filterResultCache;
 
   friend class PAGPlayer;
 };
@@ -17,9 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ShapeContentCache.h"
-#include "rendering/renderers/ShapeRenderer.h"
 
 namespace pag {
+static constexpr size_t MAX_CACHED_GEOMETRIES = 4;
+
 ShapeContentCache::ShapeContentCache(ShapeLayer* layer) : ContentCache(layer) {
 }
 
@@ -30,8 +31,24 @@ void ShapeContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRanges)
 }
 
 GraphicContent* ShapeContentCache::createContent(Frame layerFrame) const {
-  auto graphic =
-      RenderShapes(layer->uniqueID, static_cast<ShapeLayer*>(layer)->contents, layerFrame);
+  auto& contents = static_cast<ShapeLayer*>(layer)->contents;
+  auto key = MakeShapeGeometryKey(contents, layerFrame);
+  std::shared_ptr<GroupElement> geometry = nullptr;
+  for (auto iter = geometries.begin(); iter != geometries.end(); ++iter) {
+    if (iter->first == key) {
+      geometry = iter->second;
+      geometries.splice(geometries.begin(), geometries, iter);
+      break;
+    }
+  }
+  if (geometry == nullptr) {
+    geometry = RenderShapeGeometry(contents, layerFrame);
+    geometries.emplace_front(std::move(key), geometry);
+    if (geometries.size() > MAX_CACHED_GEOMETRIES) {
+      geometries.pop_back();
+    }
+  }
+  auto graphic = RenderShapePaints(layer->uniqueID, geometry.get(), layerFrame);
   return new GraphicContent(graphic);
 }
 }  // namespace pag
@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include <list>
 #include "ContentCache.h"
+#include "rendering/renderers/ShapeRenderer.h"
 
 namespace pag {
 class ShapeContentCache : public ContentCache {
@@ -28,5 +30,12 @@ class ShapeContentCache : public ContentCache {
  protected:
   void excludeVaryingRanges(std::vector<TimeRange>* timeRanges) const override;
   GraphicContent* createContent(Frame layerFrame) const override;
+
+ private:
+  // The most recently built shape geometries, so frames that only differ in paints, such as
+  // animated colors or opacities, skip all the path operations. Only a few entries are kept, a
+  // geometry that changes every frame then costs a short list instead of growing with the frames.
+  // It is only accessed in createContent(), which is already guarded by the lock of FrameCache.
+  mutable std::list<std::pair<ShapeGeometryKey, std::shared_ptr<GroupElement>>> geometries = {};
 };
 }  // namespace pag
@@ -78,27 +78,57 @@ static float GetMaxScale(std::vector<TextAnimator*>* animators) {
 }
 
 void TextContentCache::initTextGlyphs(const std::vector<std::vector<GlyphHandle>>* glyphLines) {
-  auto scale = GetMaxScale(animators);
+  maxScale = GetMaxScale(animators);
   if (glyphLines) {
-    textBlock = std::make_shared<TextBlock>(getCacheID(), *glyphLines, scale);
+    textBlock = std::make_shared<TextBlock>(getCacheID(), *glyphLines, maxScale);
     return;
   }
-  auto addFunc = [&](TextDocument* textDocument, TextPathOptions* pathOptions) {
-    auto [lines, bounds] = GetLines(textDocument, pathOptions);
-    textBlocks[textDocument] = std::make_shared<TextBlock>(getCacheID(), lines, scale, &bounds);
-  };
-  if (sourceText->animatable()) {
-    for (Frame frame = layer->startTime; frame < layer->startTime + layer->duration; frame++) {
-      auto textDocument = sourceText->getValueAt(frame).get();
-      if (textBlocks.find(textDocument) == textBlocks.end()) {
-        addFunc(textDocument, pathOption);
+  if (!sourceText->animatable()) {
+    textBlocks[sourceText->getValueAt(0).get()] = nullptr;
+    return;
+  }
+  // 文本属性只有 Hold 类型的关键帧，因此直接从关键帧中找出图层时间范围内所有不同的 TextDocument，
+  // 无需逐帧求值。
+  auto& keyframes = static_cast<AnimatableProperty<TextDocumentHandle>*>(sourceText)->keyframes;
+  auto startTime = layer->startTime;
+  auto endTime = layer->startTime + layer->duration;
+  if (startTime < keyframes.front()->startTime) {
+    textBlocks[keyframes.front()->startValue.get()] = nullptr;
+  }
+  for (size_t i = 0; i < keyframes.size(); i++) {
+    auto keyframe = keyframes[i];
+    if (keyframe->startTime < endTime && keyframe->endTime > startTime) {
+      textBlocks[keyframe->startValue.get()] = nullptr;
+    }
+    // 关键帧之间的空隙及最后一个关键帧之后，取前一关键帧的结束值或后一关键帧的起始值。
+    auto gapEndTime = i + 1 < keyframes.size() ? keyframes[i + 1]->startTime : endTime;
+    if (keyframe->endTime < gapEndTime && keyframe->endTime < endTime &&
+        gapEndTime > startTime) {
+      textBlocks[keyframe->endValue.get()] = nullptr;
+      if (i + 1 < keyframes.size()) {
+        textBlocks[keyframes[i + 1]->startValue.get()] = nullptr;
       }
     }
-  } else {
-    addFunc(sourceText->getValueAt(0).get(), pathOption);
   }
 }
 
+std::shared_ptr<TextBlock> TextContentCache::getTextBlock(TextDocument* textDocument) const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto iter = textBlocks.find(textDocument);
+  if (iter == textBlocks.end()) {
+    return nullptr;
+  }
+  if (iter->second == nullptr) {
+    iter->second = makeTextBlock(textDocument);
+  }
+  return iter->second;
+}
+
+std::shared_ptr<TextBlock> TextContentCache::makeTextBlock(TextDocument* textDocument) const {
+  auto [lines, bounds] = GetLines(textDocument, pathOption);
+  return std::make_shared<TextBlock>(getCacheID(), lines, maxScale, &bounds);
+}
+
 void TextContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRanges) const {
   sourceText->excludeVaryingRanges(timeRanges);
   if (pathOption) {
@@ -112,6 +142,22 @@ void TextContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRanges)
   }
 }
 
+std::vector<std::shared_ptr<TextBlock>> TextContentCache::getTextBlocks() const {
+  if (textBlock != nullptr) {
+    return {textBlock};
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  std::vector<std::shared_ptr<TextBlock>> result = {};
+  result.reserve(textBlocks.size());
+  for (auto& item : textBlocks) {
+    if (item.second == nullptr) {
+      item.second = makeTextBlock(item.first);
+    }
+    result.push_back(item.second);
+  }
+  return result;
+}
+
 ID TextContentCache::getCacheID() const {
   return cacheID > 0 ? cacheID : layer->uniqueID;
 }
@@ -154,13 +200,9 @@ std::pair<std::vector<GlyphHandle>, std::vector<GlyphHandle>> GetGlyphs(
 
 GraphicContent* TextContentCache::createContent(Frame layerFrame) const {
   auto textDocument = sourceText->getValueAt(layerFrame).get();
-  auto block = textBlock;
+  auto block = textBlock != nullptr ? textBlock : getTextBlock(textDocument);
   if (block == nullptr) {
-    auto iter = textBlocks.find(textDocument);
-    if (iter == textBlocks.end()) {
-      return nullptr;
-    }
-    block = iter->second;
+    return nullptr;
   }
   auto glyphLines = CopyLines(block);
   bool toCalculateBounds = false;
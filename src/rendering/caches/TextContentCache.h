@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 #include "ContentCache.h"
 #include "TextBlock.h"
@@ -30,6 +31,12 @@ class TextContentCache : public ContentCache {
   TextContentCache(TextLayer* layer, ID cacheID,
                    const std::vector<std::vector<GlyphHandle>>& lines);
 
+  /**
+   * Returns all the text blocks shaped from the source text of the layer. The text blocks that have
+   * not been used yet are shaped immediately.
+   */
+  std::vector<std::shared_ptr<TextBlock>> getTextBlocks() const;
+
  protected:
   void excludeVaryingRanges(std::vector<TimeRange>* timeRanges) const override;
   ID getCacheID() const override;
@@ -37,13 +44,18 @@ class TextContentCache : public ContentCache {
 
  private:
   void initTextGlyphs(const std::vector<std::vector<GlyphHandle>>* glyphLines = nullptr);
+  std::shared_ptr<TextBlock> getTextBlock(TextDocument* textDocument) const;
+  std::shared_ptr<TextBlock> makeTextBlock(TextDocument* textDocument) const;
 
   ID cacheID = 0;
   Property<TextDocumentHandle>* sourceText;
   TextPathOptions* pathOption;
   TextMoreOptions* moreOption;
   std::vector<TextAnimator*>* animators;
-  std::unordered_map<TextDocument*, std::shared_ptr<TextBlock>> textBlocks;
+  float maxScale = 1.0f;
+  mutable std::mutex locker = {};
+  // The distinct text documents of the source text, their text blocks are shaped on first use.
+  mutable std::unordered_map<TextDocument*, std::shared_ptr<TextBlock>> textBlocks;
   std::shared_ptr<TextBlock> textBlock;
 };
 }  // namespace pag
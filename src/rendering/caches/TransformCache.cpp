@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TransformCache.h"
+#include "rendering/caches/LayerCache.h"
 #include "rendering/renderers/TransformRenderer.h"
 
 namespace pag {
@@ -51,12 +52,32 @@ Transform* TransformCache::createCache(Frame layerFrame) {
   }
   RenderTransform(transform, layer->transform, layerFrame);
   auto parent = layer->parent;
-  while (parent != nullptr && parent->transform != nullptr) {
-    Transform parentTransform = {};
-    RenderTransform(&parentTransform, parent->transform, layerFrame);
-    transform->matrix.postConcat(parentTransform.matrix);
-    parent = parent->parent;
+  if (parent != nullptr && parent->transform != nullptr) {
+    auto parentCache = LayerCache::Get(parent)->getTransformCache();
+    transform->matrix.postConcat(parentCache->getParentMatrix(layerFrame));
   }
   return transform;
 }
+
+tgfx::Matrix TransformCache::getParentMatrix(Frame layerFrame) {
+  {
+    std::lock_guard<std::mutex> autoLock(parentLocker);
+    auto result = parentMatrices.find(layerFrame);
+    if (result != parentMatrices.end()) {
+      return result->second;
+    }
+  }
+  // The parents are evaluated outside the lock, since they lock their own caches in turn.
+  Transform transform = {};
+  RenderTransform(&transform, layer->transform, layerFrame);
+  auto matrix = transform.matrix;
+  auto parent = layer->parent;
+  if (parent != nullptr && parent->transform != nullptr) {
+    auto parentCache = LayerCache::Get(parent)->getTransformCache();
+    matrix.postConcat(parentCache->getParentMatrix(layerFrame));
+  }
+  std::lock_guard<std::mutex> autoLock(parentLocker);
+  parentMatrices[layerFrame] = matrix;
+  return matrix;
+}
 }  // namespace pag
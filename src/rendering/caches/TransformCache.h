@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
 #include "FrameCache.h"
 #include "rendering/utils/Transform.h"
 
@@ -26,10 +28,20 @@ class TransformCache : public FrameCache<Transform> {
  public:
   explicit TransformCache(Layer* layer);
 
+  /**
+   * Returns the matrix of the layer at the specified layer frame, concatenated with the matrices
+   * of all its parents. Unlike getCache(), the frame is not clamped to the duration of the layer,
+   * because the children of the layer query it with their own frames. The results are memoized,
+   * so all children sharing this layer as their parent evaluate its transform only once per frame.
+   */
+  tgfx::Matrix getParentMatrix(Frame layerFrame);
+
  protected:
   Transform* createCache(Frame layerFrame) override;
 
  private:
   Layer* layer = nullptr;
+  std::mutex parentLocker = {};
+  std::unordered_map<Frame, tgfx::Matrix> parentMatrices = {};
 };
 }  // namespace pag
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BitmapDrawable.h"
+#include <algorithm>
 #include "tgfx/gpu/opengl/GLDevice.h"
 
 namespace pag {
@@ -47,7 +48,51 @@ void BitmapDrawable::setBitmap(std::shared_ptr<BitmapBuffer> buffer) {
   freeSurface();
 }
 
+void BitmapDrawable::setReadbackRingSize(size_t size, tgfx::ColorType colorType) {
+  size = std::max(size, static_cast<size_t>(1));
+  if (ringSize == size && ringColorType == colorType && pendingSlots.empty()) {
+    return;
+  }
+  ringSize = size;
+  ringColorType = colorType;
+  ringSurfaces.clear();
+  ringSurfaces.resize(ringSize > 1 ? ringSize : 0);
+  nextSlot = 0;
+  pendingSlots.clear();
+  freeSurface();
+}
+
+bool BitmapDrawable::readSubmittedFrame(std::shared_ptr<BitmapBuffer> buffer) {
+  if (pendingSlots.empty() || buffer == nullptr) {
+    return false;
+  }
+  auto slot = pendingSlots.front();
+  pendingSlots.pop_front();
+  auto pixels = buffer->lockPixels();
+  if (pixels == nullptr) {
+    return false;
+  }
+  auto context = device->lockContext();
+  if (context == nullptr) {
+    buffer->unlockPixels();
+    return false;
+  }
+  auto ringSurface = ringSurfaces[slot];
+  auto result = ringSurface != nullptr && ringSurface->readPixels(buffer->info(), pixels);
+  device->unlock();
+  buffer->unlockPixels();
+  return result;
+}
+
 void BitmapDrawable::present(tgfx::Context* context) {
+  if (ringSize > 1) {
+    // The frame has been submitted by the caller already, reading its pixels is deferred until the
+    // following frames are submitted. Moves on to the next surface of the ring.
+    pendingSlots.push_back(nextSlot);
+    nextSlot = (nextSlot + 1) % ringSize;
+    surface = nullptr;
+    return;
+  }
   if (bitmap == nullptr) {
     return;
   }
@@ -68,6 +113,13 @@ void BitmapDrawable::present(tgfx::Context* context) {
 }
 
 std::shared_ptr<tgfx::Surface> BitmapDrawable::onCreateSurface(tgfx::Context* context) {
+  if (ringSize > 1) {
+    auto& ringSurface = ringSurfaces[nextSlot];
+    if (ringSurface == nullptr) {
+      ringSurface = tgfx::Surface::Make(context, _width, _height, ringColorType);
+    }
+    return ringSurface;
+  }
   if (bitmap == nullptr) {
     return nullptr;
   }
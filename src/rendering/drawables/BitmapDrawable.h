@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <deque>
 #include "Drawable.h"
 #include "rendering/utils/BitmapBuffer.h"
 
@@ -46,6 +47,36 @@ class BitmapDrawable : public Drawable {
     return pixelCopied;
   }
 
+  /**
+   * Sets the number of offscreen surfaces that frames are rendered to in turn. With a size greater
+   * than 1, present() only submits the frame to the GPU instead of copying its pixels into the
+   * bitmap, and the next frame is rendered to the next surface of the ring. The pixels of the
+   * submitted frames are copied later by readSubmittedFrame(), so the rendering of the following
+   * frames overlaps the pixel copying. Setting the size discards all the submitted frames that have
+   * not been read. The default size is 1.
+   */
+  void setReadbackRingSize(size_t size, tgfx::ColorType colorType = tgfx::ColorType::RGBA_8888);
+
+  /**
+   * Returns the number of offscreen surfaces in the readback ring.
+   */
+  size_t readbackRingSize() const {
+    return ringSize;
+  }
+
+  /**
+   * Returns the number of submitted frames whose pixels have not been read yet.
+   */
+  size_t pendingFrames() const {
+    return pendingSlots.size();
+  }
+
+  /**
+   * Copies the pixels of the earliest submitted frame into the specified bitmap and removes the
+   * frame from the ring. Returns false if there is no pending frame or the copy fails.
+   */
+  bool readSubmittedFrame(std::shared_ptr<BitmapBuffer> buffer);
+
  protected:
   std::shared_ptr<tgfx::Surface> onCreateSurface(tgfx::Context* context) override;
 
@@ -56,6 +87,11 @@ class BitmapDrawable : public Drawable {
   std::shared_ptr<tgfx::Surface> offscreenSurface = nullptr;
   std::shared_ptr<BitmapBuffer> bitmap = nullptr;
   bool pixelCopied = false;
+  size_t ringSize = 1;
+  tgfx::ColorType ringColorType = tgfx::ColorType::RGBA_8888;
+  std::vector<std::shared_ptr<tgfx::Surface>> ringSurfaces = {};
+  size_t nextSlot = 0;
+  std::deque<size_t> pendingSlots = {};
 
   BitmapDrawable(int width, int height, std::shared_ptr<tgfx::Device> device);
 };
@@ -45,6 +45,14 @@ class Drawable {
 
   virtual void updateSize();
 
+  /**
+   * Returns true if the content of the surface is kept unchanged between frames, so that only the
+   * changed areas need to be redrawn. The default value is false.
+   */
+  virtual bool retainsContent() const {
+    return false;
+  }
+
  protected:
   std::shared_ptr<tgfx::Surface> surface = nullptr;
 
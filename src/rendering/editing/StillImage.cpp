@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "StillImage.h"
+#include "base/utils/ImagePool.h"
 #include "base/utils/TGFXCast.h"
 #include "base/utils/UniqueID.h"
 #include "pag/pag.h"
@@ -27,14 +28,13 @@
 
 namespace pag {
 std::shared_ptr<PAGImage> PAGImage::FromPath(const std::string& filePath) {
-  auto image = tgfx::Image::MakeFromFile(filePath);
-  return StillImage::MakeFrom(std::move(image));
+  auto image = ImagePool::MakeFromFile(filePath);
+  return StillImage::MakeFrom(std::move(image), true);
 }
 
 std::shared_ptr<PAGImage> PAGImage::FromBytes(const void* bytes, size_t length) {
-  auto fileBytes = tgfx::Data::MakeWithCopy(bytes, length);
-  auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
-  return StillImage::MakeFrom(std::move(image));
+  auto image = ImagePool::MakeFromEncoded(bytes, length);
+  return StillImage::MakeFrom(std::move(image), true);
 }
 
 std::shared_ptr<PAGImage> PAGImage::FromPixels(const void* pixels, int width, int height,
@@ -47,12 +47,13 @@ std::shared_ptr<PAGImage> PAGImage::FromPixels(const void* pixels, int width, in
   return StillImage::MakeFrom(image);
 }
 
-std::shared_ptr<StillImage> StillImage::MakeFrom(std::shared_ptr<tgfx::Image> image) {
+std::shared_ptr<StillImage> StillImage::MakeFrom(std::shared_ptr<tgfx::Image> image,
+                                                bool scalable) {
   if (image == nullptr) {
     return nullptr;
   }
   auto pagImage = std::shared_ptr<StillImage>(new StillImage(image->width(), image->height()));
-  auto picture = Picture::MakeFrom(pagImage->uniqueID(), image);
+  auto picture = Picture::MakeFrom(pagImage->uniqueID(), image, scalable);
   if (!picture) {
     return nullptr;
   }
@@ -26,7 +26,12 @@ namespace pag {
 
 class StillImage : public PAGImage {
  public:
-  static std::shared_ptr<StillImage> MakeFrom(std::shared_ptr<tgfx::Image> image);
+  /**
+   * Creates a StillImage from the specified image. If scalable is true, the image may be decoded at
+   * a smaller size when it is only displayed downscaled.
+   */
+  static std::shared_ptr<StillImage> MakeFrom(std::shared_ptr<tgfx::Image> image,
+                                              bool scalable = false);
 
  protected:
   std::shared_ptr<Graphic> getGraphic(int64_t) const override {
@@ -28,17 +28,24 @@ TextReplacement::TextReplacement(PAGTextLayer* pagLayer) : pagLayer(pagLayer) {
 }
 
 TextReplacement::~TextReplacement() {
-  delete textContentCache;
+  textContentCache = nullptr;
   delete sourceText;
 }
 
 Content* TextReplacement::getContent(Frame contentFrame) {
+  return getContentCache()->getCache(contentFrame);
+}
+
+std::shared_ptr<TextContentCache> TextReplacement::getContentCache() {
   if (textContentCache == nullptr) {
     auto textLayer = static_cast<TextLayer*>(pagLayer->layer);
-    textContentCache = new TextContentCache(textLayer, pagLayer->uniqueID(), sourceText);
+    auto textDocument = sourceText->value;
+    textContentCache = std::shared_ptr<TextContentCache>(
+        new TextContentCache(textLayer, pagLayer->uniqueID(), sourceText),
+        [textDocument](TextContentCache* cache) { delete cache; });
     textContentCache->update();
   }
-  return textContentCache->getCache(contentFrame);
+  return textContentCache;
 }
 
 TextDocument* TextReplacement::getTextDocument() {
@@ -46,7 +53,11 @@ TextDocument* TextReplacement::getTextDocument() {
 }
 
 void TextReplacement::clearCache() {
-  delete textContentCache;
+  if (textContentCache == nullptr) {
+    return;
+  }
   textContentCache = nullptr;
+  // 被释放的缓存可能仍在其他线程上排版当前的文本，因此后续修改写入一份拷贝。
+  sourceText->value = std::make_shared<TextDocument>(*sourceText->value);
 }
 }  // namespace pag
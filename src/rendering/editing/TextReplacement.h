@@ -28,12 +28,18 @@ class TextReplacement {
 
   Content* getContent(Frame contentFrame);
 
+  /**
+   * Returns the content cache of the replaced text, creating it if necessary. The cache keeps its
+   * text document alive, so it can still be used on another thread after the text is edited.
+   */
+  std::shared_ptr<TextContentCache> getContentCache();
+
   TextDocument* getTextDocument();
 
   void clearCache();
 
  private:
-  TextContentCache* textContentCache = nullptr;
+  std::shared_ptr<TextContentCache> textContentCache = nullptr;
   Property<TextDocumentHandle>* sourceText = nullptr;
   PAGTextLayer* pagLayer = nullptr;
 };
@@ -22,12 +22,27 @@
 #include "rendering/renderers/FilterRenderer.h"
 
 namespace pag {
+static bool HasDisplacementMap(const Layer* layer) {
+  for (auto* effect : layer->effects) {
+    if (effect->type() == EffectType::DisplacementMap) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::shared_ptr<FilterModifier> FilterModifier::Make(PAGLayer* pagLayer) {
   if (pagLayer == nullptr || pagLayer->contentFrame < 0 ||
       pagLayer->contentFrame >= pagLayer->layer->duration) {
     return nullptr;
   }
   auto modifier = Make(pagLayer->layer, pagLayer->layer->startTime + pagLayer->contentFrame);
+  if (modifier != nullptr && (pagLayer->contentModified() ||
+                              pagLayer->layerType() == LayerType::PreCompose)) {
+    // Edited contents and the contents of PAGCompositions, which depend on their child PAGLayers,
+    // are not determined by the layer frame alone.
+    modifier->cacheResult = false;
+  }
   return modifier;
 }
 
@@ -41,6 +56,7 @@ std::shared_ptr<FilterModifier> FilterModifier::Make(Layer* layer, Frame layerFr
   auto modifier = std::shared_ptr<FilterModifier>(new FilterModifier());
   modifier->layer = layer;
   modifier->layerFrame = layerFrame;
+  modifier->cacheResult = !HasDisplacementMap(layer);
   return modifier;
 }
 
@@ -65,5 +65,8 @@ class FilterModifier : public Modifier {
 
   Layer* layer = nullptr;
   Frame layerFrame = 0;
+  // Whether the filtered result is fully determined by the layer and its frame, which allows it to
+  // be reused from the filter result cache of RenderCache.
+  bool cacheResult = false;
 };
 }  // namespace pag
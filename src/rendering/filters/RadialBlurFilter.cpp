@@ -18,6 +18,8 @@
 
 #include "RadialBlurFilter.h"
 #include "base/utils/TGFXCast.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/filters/utils/FilterHelper.h"
 #include "tgfx/core/ImageFilter.h"
 
 namespace pag {
@@ -70,8 +72,20 @@ std::shared_ptr<tgfx::Image> RadialBlurFilter::Apply(std::shared_ptr<tgfx::Image
   center.x = center.x / contentBounds.width();
   center.y = center.y / contentBounds.height();
   amount = amount < 0.25 ? amount : 0.25;
-  auto filter = std::make_shared<RadialBlurFilter>(cache, amount, center);
-  return input->makeWithFilter(tgfx::ImageFilter::Runtime(filter), offset);
+  auto radialBlurFilter = std::make_shared<RadialBlurFilter>(cache, amount, center);
+  auto filter = tgfx::ImageFilter::Runtime(radialBlurFilter);
+  // The blur length of a pixel is proportional to its distance from the center.
+  auto maxSize = std::max(input->width(), input->height());
+  auto blurRadius = static_cast<float>(amount) * static_cast<float>(maxSize);
+  auto workingScale = GetBlurWorkingScale(blurRadius, cache->filterQuality());
+  if (workingScale < 1.0f) {
+    tgfx::Point scale = {};
+    auto source = DownsampleImage(input, workingScale, &scale);
+    if (source != nullptr) {
+      return UpsampleImage(source->makeWithFilter(std::move(filter), offset), scale, offset);
+    }
+  }
+  return input->makeWithFilter(std::move(filter), offset);
 }
 
 std::string RadialBlurFilter::onBuildFragmentShader() const {
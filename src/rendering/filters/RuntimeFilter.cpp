@@ -17,9 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RuntimeFilter.h"
+#include <functional>
 #include "base/utils/Log.h"
+#include "rendering/caches/FilterResourcesCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/filters/utils/FilterHelper.h"
+#include "tgfx/core/Clock.h"
 
 namespace pag {
 static constexpr char VERTEX_SHADER[] = R"(
@@ -76,13 +79,10 @@ std::vector<tgfx::Attribute> RuntimeFilter::vertexAttributes() const {
   return {{"aPosition", tgfx::VertexFormat::Float2}, {"aTextureCoord", tgfx::VertexFormat::Float2}};
 }
 
-std::shared_ptr<tgfx::RenderPipeline> RuntimeFilter::createPipeline(tgfx::GPU* gpu) const {
-  auto info = gpu->info();
-  auto isDesktop = info->version.find("OpenGL ES") == std::string::npos;
-  std::string versionPrefix = isDesktop ? "#version 150\n\n" : "#version 300 es\n\n";
-
+std::shared_ptr<tgfx::RenderPipeline> RuntimeFilter::createPipeline(
+    tgfx::GPU* gpu, const std::string& vertexCode, const std::string& fragmentCode) const {
   tgfx::ShaderModuleDescriptor vertexModule = {};
-  vertexModule.code = versionPrefix + onBuildVertexShader();
+  vertexModule.code = vertexCode;
   vertexModule.stage = tgfx::ShaderStage::Vertex;
   auto vertexShader = gpu->createShaderModule(vertexModule);
   if (vertexShader == nullptr) {
@@ -91,7 +91,7 @@ std::shared_ptr<tgfx::RenderPipeline> RuntimeFilter::createPipeline(tgfx::GPU* g
   }
 
   tgfx::ShaderModuleDescriptor fragmentModule = {};
-  fragmentModule.code = versionPrefix + onBuildFragmentShader();
+  fragmentModule.code = fragmentCode;
   fragmentModule.stage = tgfx::ShaderStage::Fragment;
   auto fragmentShader = gpu->createShaderModule(fragmentModule);
   if (fragmentShader == nullptr) {
@@ -172,8 +172,22 @@ std::shared_ptr<tgfx::RenderPipeline> RuntimeFilter::getPipeline(tgfx::GPU* gpu)
 FilterResources* RuntimeFilter::getFilterResources(tgfx::GPU* gpu) const {
   auto type = filterType();
   auto resources = cache->findFilterResources(type);
-  if (resources == nullptr) {
-    auto pipeline = createPipeline(gpu);
+  if (resources != nullptr) {
+    DEBUG_ASSERT(resources->pipeline != nullptr);
+    return resources;
+  }
+  auto info = gpu->info();
+  auto isDesktop = info->version.find("OpenGL ES") == std::string::npos;
+  std::string versionPrefix = isDesktop ? "#version 150\n\n" : "#version 300 es\n\n";
+  auto vertexCode = versionPrefix + onBuildVertexShader();
+  auto fragmentCode = versionPrefix + onBuildFragmentShader();
+  auto shaderHash = std::hash<std::string>()(vertexCode + fragmentCode);
+  auto context = cache->getContext();
+  auto contextID = context != nullptr ? context->uniqueID() : 0;
+  auto sharedResources = FilterResourcesCache::Find(contextID, type, shaderHash);
+  if (sharedResources == nullptr) {
+    auto startTime = tgfx::Clock::Now();
+    auto pipeline = createPipeline(gpu, vertexCode, fragmentCode);
     if (pipeline == nullptr) {
       return nullptr;
     }
@@ -181,16 +195,25 @@ FilterResources* RuntimeFilter::getFilterResources(tgfx::GPU* gpu) const {
                                         tgfx::AddressMode::ClampToEdge, tgfx::FilterMode::Linear,
                                         tgfx::FilterMode::Linear, tgfx::MipmapMode::None);
     auto sampler = gpu->createSampler(samplerDesc);
-    auto newResources = onCreateFilterResources();
-    newResources->pipeline = std::move(pipeline);
-    newResources->sampler = std::move(sampler);
-    resources = newResources.get();
-    cache->addFilterResources(type, std::move(newResources));
+    sharedResources = onCreateFilterResources();
+    sharedResources->pipeline = std::move(pipeline);
+    sharedResources->sampler = std::move(sampler);
+    cache->recordProgramCompilingTime(tgfx::Clock::Now() - startTime);
+    FilterResourcesCache::Add(contextID, type, shaderHash, sharedResources);
   }
+  resources = sharedResources.get();
+  cache->addFilterResources(type, std::move(sharedResources));
   DEBUG_ASSERT(resources->pipeline != nullptr);
   return resources;
 }
 
+bool RuntimeFilter::prewarm(tgfx::GPU* gpu) const {
+  if (gpu == nullptr) {
+    return false;
+  }
+  return getFilterResources(gpu) != nullptr;
+}
+
 bool RuntimeFilter::onDraw(tgfx::CommandEncoder* encoder,
                            const std::vector<std::shared_ptr<tgfx::Texture>>& inputTextures,
                            std::shared_ptr<tgfx::Texture> outputTexture,
@@ -60,6 +60,12 @@ class RuntimeFilter : public tgfx::RuntimeEffect {
               std::shared_ptr<tgfx::Texture> outputTexture,
               const tgfx::Point& offset) const override;
 
+  /**
+   * Compiles the render pipeline of this filter ahead of time if it is not compiled yet for the
+   * specified GPU. Returns false if the pipeline fails to compile.
+   */
+  bool prewarm(tgfx::GPU* gpu) const;
+
  protected:
   RenderCache* cache = nullptr;
 
@@ -128,7 +134,9 @@ class RuntimeFilter : public tgfx::RuntimeEffect {
   std::shared_ptr<tgfx::RenderPipeline> getPipeline(tgfx::GPU* gpu) const;
 
  private:
-  std::shared_ptr<tgfx::RenderPipeline> createPipeline(tgfx::GPU* gpu) const;
+  std::shared_ptr<tgfx::RenderPipeline> createPipeline(tgfx::GPU* gpu,
+                                                       const std::string& vertexCode,
+                                                       const std::string& fragmentCode) const;
 };
 
 }  // namespace pag
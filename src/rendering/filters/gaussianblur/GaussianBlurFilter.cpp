@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GaussianBlurFilter.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/filters/utils/FilterHelper.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
@@ -24,7 +25,8 @@
 namespace pag {
 
 std::shared_ptr<tgfx::Image> GaussianBlurFilter::Apply(std::shared_ptr<tgfx::Image> input,
-                                                       Effect* effect, Frame layerFrame,
+                                                       RenderCache* cache, Effect* effect,
+                                                       Frame layerFrame,
                                                        const tgfx::Point& filterScale,
                                                        const tgfx::Point& sourceScale,
                                                        tgfx::Point* offset) {
@@ -40,14 +42,33 @@ std::shared_ptr<tgfx::Image> GaussianBlurFilter::Apply(std::shared_ptr<tgfx::Ima
   }
   blurrinessX *= filterScale.x * sourceScale.x;
   blurrinessY *= filterScale.y * sourceScale.y;
+  auto workingScale = GetBlurWorkingScale(std::max(blurrinessX, blurrinessY),
+                                          cache->filterQuality());
+  auto scale = tgfx::Point::Make(1.0f, 1.0f);
+  auto source = input;
+  if (workingScale < 1.0f) {
+    source = DownsampleImage(input, workingScale, &scale);
+    if (source == nullptr) {
+      source = input;
+      scale.set(1.0f, 1.0f);
+    }
+    blurrinessX *= scale.x;
+    blurrinessY *= scale.y;
+  }
   std::shared_ptr<tgfx::ImageFilter> filter;
+  std::shared_ptr<tgfx::Image> output;
   if (repeatEdgePixels) {
     filter = tgfx::ImageFilter::Blur(blurrinessX / 2, blurrinessY / 2, tgfx::TileMode::Clamp);
-    tgfx::Rect clipBounds = tgfx::Rect::MakeWH(input->width(), input->height());
-    return input->makeWithFilter(filter, offset, &clipBounds);
+    tgfx::Rect clipBounds = tgfx::Rect::MakeWH(source->width(), source->height());
+    output = source->makeWithFilter(filter, offset, &clipBounds);
+  } else {
+    filter = tgfx::ImageFilter::Blur(blurrinessX / 2, blurrinessY / 2);
+    output = source->makeWithFilter(filter, offset);
+  }
+  if (source == input) {
+    return output;
   }
-  filter = tgfx::ImageFilter::Blur(blurrinessX / 2, blurrinessY / 2);
-  return input->makeWithFilter(filter, offset);
+  return UpsampleImage(std::move(output), scale, offset);
 }
 
 }  // namespace pag
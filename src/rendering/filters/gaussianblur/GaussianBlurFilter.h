@@ -25,8 +25,9 @@ namespace pag {
 
 class GaussianBlurFilter {
  public:
-  static std::shared_ptr<tgfx::Image> Apply(std::shared_ptr<tgfx::Image> input, Effect* effect,
-                                            Frame layerFrame, const tgfx::Point& filterScale,
+  static std::shared_ptr<tgfx::Image> Apply(std::shared_ptr<tgfx::Image> input,
+                                            RenderCache* cache, Effect* effect, Frame layerFrame,
+                                            const tgfx::Point& filterScale,
                                             const tgfx::Point& sourceScale, tgfx::Point* offset);
 };
 }  // namespace pag
@@ -19,8 +19,10 @@
 #include "DropShadowFilter.h"
 #include "base/utils/MathUtil.h"
 #include "base/utils/TGFXCast.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/filters/layerstyle/SolidStrokeFilter.h"
 #include "rendering/filters/utils/BlurTypes.h"
+#include "rendering/filters/utils/FilterHelper.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
 
@@ -54,17 +56,28 @@ void DropShadowFilter::update(Frame layerFrame, const tgfx::Point& filterScale,
 }
 
 bool DropShadowFilter::draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image) {
+  auto blurRadius = std::max(sizeX, sizeY) * (1.f - spread);
+  auto workingScale = GetBlurWorkingScale(blurRadius, cache->filterQuality());
+  auto scale = tgfx::Point::Make(1.0f, 1.0f);
+  if (workingScale < 1.0f) {
+    auto source = DownsampleImage(image, workingScale, &scale);
+    if (source != nullptr) {
+      image = std::move(source);
+    } else {
+      scale.set(1.0f, 1.0f);
+    }
+  }
   std::shared_ptr<tgfx::ImageFilter> filter = nullptr;
   if (spread == 0.f) {
-    filter = getDropShadowFilter(offsetX, offsetY);
+    filter = getDropShadowFilter(offsetX * scale.x, offsetY * scale.y, scale);
   } else if (spread == 1.f) {
-    filter = getStrokeFilter();
+    filter = getStrokeFilter(scale);
   } else {
-    auto strokeFilter = getStrokeFilter();
+    auto strokeFilter = getStrokeFilter(scale);
     if (strokeFilter == nullptr) {
       return false;
     }
-    auto dropShadowFilter = getDropShadowFilter(0, 0);
+    auto dropShadowFilter = getDropShadowFilter(0, 0, scale);
     if (dropShadowFilter == nullptr) {
       return false;
     }
@@ -77,24 +90,29 @@ bool DropShadowFilter::draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image)
   image = image->makeWithFilter(filter, &point);
   tgfx::Paint paint;
   paint.setAlpha(alpha);
+  canvas->save();
+  // Draws the shadow produced at the working resolution back at the source resolution.
+  canvas->scale(1.0f / scale.x, 1.0f / scale.y);
   canvas->drawImage(std::move(image), point.x, point.y, &paint);
+  canvas->restore();
   return true;
 }
 
-std::shared_ptr<tgfx::ImageFilter> DropShadowFilter::getStrokeFilter() const {
+std::shared_ptr<tgfx::ImageFilter> DropShadowFilter::getStrokeFilter(
+    const tgfx::Point& scale) const {
   auto strokeOption = SolidStrokeOption();
   strokeOption.color = color;
-  strokeOption.spreadSizeX = sizeX * spread;
-  strokeOption.spreadSizeY = sizeY * spread;
-  strokeOption.offsetX = offsetX;
-  strokeOption.offsetY = offsetY;
+  strokeOption.spreadSizeX = sizeX * spread * scale.x;
+  strokeOption.spreadSizeY = sizeY * spread * scale.y;
+  strokeOption.offsetX = offsetX * scale.x;
+  strokeOption.offsetY = offsetY * scale.y;
   return SolidStrokeFilter::CreateFilter(cache, strokeOption, mode);
 }
 
-std::shared_ptr<tgfx::ImageFilter> DropShadowFilter::getDropShadowFilter(float offsetX,
-                                                                         float offsetY) const {
-  float blurSizeX = sizeX * (1.f - spread) / 2;
-  float blurSizeY = sizeY * (1.f - spread) / 2;
+std::shared_ptr<tgfx::ImageFilter> DropShadowFilter::getDropShadowFilter(
+    float offsetX, float offsetY, const tgfx::Point& scale) const {
+  float blurSizeX = sizeX * (1.f - spread) / 2 * scale.x;
+  float blurSizeY = sizeY * (1.f - spread) / 2 * scale.y;
   return tgfx::ImageFilter::DropShadowOnly(offsetX, offsetY, blurSizeX, blurSizeY, color);
 }
 
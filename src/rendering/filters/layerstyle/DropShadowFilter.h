@@ -36,9 +36,10 @@ class DropShadowFilter : public LayerStyleFilter {
   bool draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image) override;
 
  private:
-  std::shared_ptr<tgfx::ImageFilter> getStrokeFilter() const;
+  std::shared_ptr<tgfx::ImageFilter> getStrokeFilter(const tgfx::Point& scale) const;
 
-  std::shared_ptr<tgfx::ImageFilter> getDropShadowFilter(float offsetX, float offsetY) const;
+  std::shared_ptr<tgfx::ImageFilter> getDropShadowFilter(float offsetX, float offsetY,
+                                                         const tgfx::Point& scale) const;
 
   DropShadowStyle* layerStyle = nullptr;
   tgfx::Color color = tgfx::Color::Black();
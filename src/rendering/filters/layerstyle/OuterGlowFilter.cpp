@@ -18,8 +18,10 @@
 
 #include "OuterGlowFilter.h"
 #include "base/utils/TGFXCast.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/filters/layerstyle/SolidStrokeFilter.h"
 #include "rendering/filters/utils/BlurTypes.h"
+#include "rendering/filters/utils/FilterHelper.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
 
@@ -43,17 +45,28 @@ void OuterGlowFilter::update(Frame layerFrame, const tgfx::Point& filterScale,
 }
 
 bool OuterGlowFilter::draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image) {
+  auto blurRadius = std::max(sizeX, sizeY) * (1.f - spread) / range;
+  auto workingScale = GetBlurWorkingScale(blurRadius, cache->filterQuality());
+  auto scale = tgfx::Point::Make(1.0f, 1.0f);
+  if (workingScale < 1.0f) {
+    auto source = DownsampleImage(image, workingScale, &scale);
+    if (source != nullptr) {
+      image = std::move(source);
+    } else {
+      scale.set(1.0f, 1.0f);
+    }
+  }
   std::shared_ptr<tgfx::ImageFilter> filter = nullptr;
   if (spread == 0.f) {
-    filter = getDropShadowFilter();
+    filter = getDropShadowFilter(scale);
   } else if (spread == 1.f) {
-    filter = getStrokeFilter();
+    filter = getStrokeFilter(scale);
   } else {
-    auto strokeFilter = getStrokeFilter();
+    auto strokeFilter = getStrokeFilter(scale);
     if (strokeFilter == nullptr) {
       return false;
     }
-    auto dropShadowFilter = getDropShadowFilter();
+    auto dropShadowFilter = getDropShadowFilter(scale);
     if (dropShadowFilter == nullptr) {
       return false;
     }
@@ -66,21 +79,26 @@ bool OuterGlowFilter::draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image) {
   image = image->makeWithFilter(filter, &offset);
   tgfx::Paint paint;
   paint.setAlpha(alpha);
+  canvas->save();
+  canvas->scale(1.0f / scale.x, 1.0f / scale.y);
   canvas->drawImage(std::move(image), offset.x, offset.y, &paint);
+  canvas->restore();
   return true;
 }
 
-std::shared_ptr<tgfx::ImageFilter> OuterGlowFilter::getStrokeFilter() const {
+std::shared_ptr<tgfx::ImageFilter> OuterGlowFilter::getStrokeFilter(
+    const tgfx::Point& scale) const {
   auto strokeOption = SolidStrokeOption();
   strokeOption.color = color;
-  strokeOption.spreadSizeX = spread * sizeX / range;
-  strokeOption.spreadSizeY = spread * sizeY / range;
+  strokeOption.spreadSizeX = spread * sizeX / range * scale.x;
+  strokeOption.spreadSizeY = spread * sizeY / range * scale.y;
   return SolidStrokeFilter::CreateFilter(cache, strokeOption, mode);
 }
 
-std::shared_ptr<tgfx::ImageFilter> OuterGlowFilter::getDropShadowFilter() const {
-  auto blurSizeX = sizeX * (1.f - spread) / range;
-  auto blurSizeY = sizeY * (1.f - spread) / range;
+std::shared_ptr<tgfx::ImageFilter> OuterGlowFilter::getDropShadowFilter(
+    const tgfx::Point& scale) const {
+  auto blurSizeX = sizeX * (1.f - spread) / range * scale.x;
+  auto blurSizeY = sizeY * (1.f - spread) / range * scale.y;
   return tgfx::ImageFilter::DropShadowOnly(0, 0, blurSizeX / 2, blurSizeY / 2, color);
 }
 
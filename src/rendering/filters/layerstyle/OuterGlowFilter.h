@@ -36,9 +36,9 @@ class OuterGlowFilter : public LayerStyleFilter {
   bool draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image) override;
 
  private:
-  std::shared_ptr<tgfx::ImageFilter> getStrokeFilter() const;
+  std::shared_ptr<tgfx::ImageFilter> getStrokeFilter(const tgfx::Point& scale) const;
 
-  std::shared_ptr<tgfx::ImageFilter> getDropShadowFilter() const;
+  std::shared_ptr<tgfx::ImageFilter> getDropShadowFilter(const tgfx::Point& scale) const;
 
   OuterGlowStyle* layerStyle = nullptr;
 
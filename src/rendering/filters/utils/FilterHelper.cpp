@@ -17,8 +17,14 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FilterHelper.h"
+#include <algorithm>
+#include <cmath>
 
 namespace pag {
+// The largest blur radius that still runs at full resolution when the filter quality is 0.
+#define BLUR_RADIUS_THRESHOLD 8.0f
+#define MIN_BLUR_WORKING_SCALE 0.25f
+
 std::array<float, 9> ToShaderMatrix(const tgfx::Matrix& matrix) {
   float values[6];
   matrix.get6(values);
@@ -80,4 +86,37 @@ tgfx::Point ToVertexPoint(const tgfx::Texture* target, const tgfx::Point& point)
           2.0f * point.y / static_cast<float>(target->height()) - 1.0f};
 }
 
+float GetBlurWorkingScale(float blurRadius, float filterQuality) {
+  if (filterQuality >= 1.0f || blurRadius <= 0.0f) {
+    return 1.0f;
+  }
+  auto maxRadius = BLUR_RADIUS_THRESHOLD / (1.0f - std::max(filterQuality, 0.0f));
+  if (blurRadius <= maxRadius) {
+    return 1.0f;
+  }
+  return std::max(maxRadius / blurRadius, MIN_BLUR_WORKING_SCALE);
+}
+
+std::shared_ptr<tgfx::Image> DownsampleImage(std::shared_ptr<tgfx::Image> image, float scale,
+                                             tgfx::Point* actualScale) {
+  auto width = std::max(1, static_cast<int>(ceilf(static_cast<float>(image->width()) * scale)));
+  auto height = std::max(1, static_cast<int>(ceilf(static_cast<float>(image->height()) * scale)));
+  actualScale->x = static_cast<float>(width) / static_cast<float>(image->width());
+  actualScale->y = static_cast<float>(height) / static_cast<float>(image->height());
+  return image->makeScaled(width, height);
+}
+
+std::shared_ptr<tgfx::Image> UpsampleImage(std::shared_ptr<tgfx::Image> image,
+                                           const tgfx::Point& scale, tgfx::Point* offset) {
+  if (image == nullptr) {
+    return nullptr;
+  }
+  auto width = static_cast<int>(roundf(static_cast<float>(image->width()) / scale.x));
+  auto height = static_cast<int>(roundf(static_cast<float>(image->height()) / scale.y));
+  if (offset != nullptr) {
+    offset->x /= scale.x;
+    offset->y /= scale.y;
+  }
+  return image->makeScaled(width, height);
+}
 }  // namespace pag
@@ -21,6 +21,7 @@
 #include <array>
 #include "base/utils/TGFXCast.h"
 #include "pag/pag.h"
+#include "tgfx/core/Image.h"
 #include "tgfx/gpu/Texture.h"
 
 namespace pag {
@@ -38,4 +39,26 @@ tgfx::Point ToTexturePoint(const tgfx::Texture* source, const tgfx::Point& textu
 
 tgfx::Point ToVertexPoint(const tgfx::Texture* target, const tgfx::Point& point);
 
+/**
+ * Returns the scale of the working resolution for a blur with the specified radius in pixels. Large
+ * blurs throw away the high-frequency details of their inputs, so they can run on a downsampled
+ * input without visible difference. The filterQuality ranges from 0.0 to 1.0, a lower value allows
+ * smaller blurs to be downsampled, and 1.0 always keeps the full resolution.
+ */
+float GetBlurWorkingScale(float blurRadius, float filterQuality);
+
+/**
+ * Returns a copy of the image downsampled by the specified scale, and stores the actual scale of
+ * each axis after rounding the size into actualScale.
+ */
+std::shared_ptr<tgfx::Image> DownsampleImage(std::shared_ptr<tgfx::Image> image, float scale,
+                                             tgfx::Point* actualScale);
+
+/**
+ * Scales an image produced at a downsampled resolution back up, and converts its offset to the
+ * original resolution as well.
+ */
+std::shared_ptr<tgfx::Image> UpsampleImage(std::shared_ptr<tgfx::Image> image,
+                                           const tgfx::Point& scale, tgfx::Point* offset);
+
 }  // namespace pag
@@ -46,6 +46,14 @@ class ImageProxy {
    */
   virtual bool isTemporary() const = 0;
 
+  /**
+   * Returns true if the image can be decoded at a smaller size than the proxy when it is only
+   * displayed downscaled. The images returned by getImage() may then be smaller than the proxy.
+   */
+  virtual bool isScalable() const {
+    return false;
+  }
+
   /**
    * Prepares the image for the next getImage() call.
    */
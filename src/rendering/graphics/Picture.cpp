@@ -70,6 +70,7 @@ class ImageProxyPicture : public Picture {
     }
     auto canvas = surface->getCanvas();
     canvas->setMatrix(tgfx::Matrix::MakeTrans(-x, -y));
+    canvas->concat(getImageMatrix(image.get()));
     canvas->drawImage(std::move(image));
     return surface->getColor(0, 0).alpha > 0;
   }
@@ -87,7 +88,7 @@ class ImageProxyPicture : public Picture {
     // Do not call proxy->getImage() here, which will clear the decoded image in the render cache.
     if (proxy->isTemporary()) {
       auto image = proxy->getImage(cache);
-      canvas->drawImage(std::move(image));
+      drawImage(canvas, std::move(image));
       return;
     }
     auto renderFlags = canvas->renderFlags();
@@ -102,12 +103,35 @@ class ImageProxyPicture : public Picture {
       }
     }
     auto image = proxy->getImage(cache);
-    canvas->drawImage(std::move(image));
+    drawImage(canvas, std::move(image));
   }
 
  private:
   std::shared_ptr<ImageProxy> proxy = nullptr;
 
+  // Maps the image to the bounds of the proxy, since the image may be decoded at a smaller size.
+  tgfx::Matrix getImageMatrix(const tgfx::Image* image) const {
+    if (image == nullptr ||
+        (image->width() == proxy->width() && image->height() == proxy->height())) {
+      return tgfx::Matrix::I();
+    }
+    return tgfx::Matrix::MakeScale(
+        static_cast<float>(proxy->width()) / static_cast<float>(image->width()),
+        static_cast<float>(proxy->height()) / static_cast<float>(image->height()));
+  }
+
+  void drawImage(Canvas* canvas, std::shared_ptr<tgfx::Image> image) const {
+    auto imageMatrix = getImageMatrix(image.get());
+    if (imageMatrix.isIdentity()) {
+      canvas->drawImage(std::move(image));
+      return;
+    }
+    auto canvasMatrix = canvas->getMatrix();
+    canvas->concat(imageMatrix);
+    canvas->drawImage(std::move(image));
+    canvas->setMatrix(canvasMatrix);
+  }
+
   float getScaleFactor(float maxScaleFactor) const override {
     // Use RescaleImage() only when the maxScaleFactor is less than 0.7f (half in memory size) to
     // avoid the unnecessary increase of draw calls.
@@ -124,12 +148,13 @@ class ImageProxyPicture : public Picture {
     if (image == nullptr) {
       return nullptr;
     }
-    bool needRescale = !image->isTextureBacked() && scaleFactor != 1.0f;
+    auto imageScale = static_cast<float>(image->width()) / static_cast<float>(proxy->width());
+    bool needRescale = !image->isTextureBacked() && scaleFactor != imageScale;
     if (needRescale) {
-      image = RescaleImage(cache->getContext(), image, scaleFactor, mipmapped);
+      image = RescaleImage(cache->getContext(), image, scaleFactor / imageScale, mipmapped);
     } else {
       image = image->makeTextureImage(cache->getContext());
-      scaleFactor = 1.0f;
+      scaleFactor = imageScale;
     }
     if (image == nullptr) {
       return nullptr;
@@ -223,8 +248,8 @@ class SnapshotPicture : public Picture {
 
 class DefaultImageProxy : public ImageProxy {
  public:
-  DefaultImageProxy(ID assetID, std::shared_ptr<tgfx::Image> image)
-      : assetID(assetID), image(std::move(image)) {
+  DefaultImageProxy(ID assetID, std::shared_ptr<tgfx::Image> image, bool scalable)
+      : assetID(assetID), image(std::move(image)), scalable(scalable) {
   }
 
   int width() const override {
@@ -239,6 +264,10 @@ class DefaultImageProxy : public ImageProxy {
     return false;
   }
 
+  bool isScalable() const override {
+    return scalable;
+  }
+
   void prepareImage(RenderCache* cache) const override {
     cache->prepareAssetImage(assetID, this);
   }
@@ -255,6 +284,7 @@ class DefaultImageProxy : public ImageProxy {
  private:
   ID assetID = 0;
   std::shared_ptr<tgfx::Image> image = nullptr;
+  bool scalable = false;
 };
 
 class BackendTextureProxy : public ImageProxy {
@@ -315,11 +345,13 @@ static std::atomic_uint64_t IDCount = {1};
 Picture::Picture(ID assetID) : assetID(assetID), uniqueKey(IDCount++) {
 }
 
-std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image) {
+std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image,
+                                           bool scalable) {
   if (image == nullptr) {
     return nullptr;
   }
-  auto proxy = std::make_shared<DefaultImageProxy>(assetID, std::move(image));
+  scalable = scalable && !image->isTextureBacked();
+  auto proxy = std::make_shared<DefaultImageProxy>(assetID, std::move(image), scalable);
   return MakeFrom(assetID, std::move(proxy));
 }
 
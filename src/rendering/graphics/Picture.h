@@ -37,9 +37,12 @@ namespace pag {
 class Picture : public Graphic {
  public:
   /**
-   * Creates a new Picture with specified Image. Return null if the image is null.
+   * Creates a new Picture with specified Image. Return null if the image is null. If scalable is
+   * true and the image is not backed by a texture, the image may be decoded at a smaller size
+   * according to the max scale of the asset on the stage.
    */
-  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image);
+  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image,
+                                           bool scalable = false);
 
   /*
    * Creates a new image with specified ImageProxy. Returns nullptr if the proxy is null.
@@ -19,8 +19,10 @@
 #include "base/utils/TimeUtil.h"
 #include "pag/file.h"
 #include "pag/pag.h"
+#include "rendering/caches/LayerCache.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/ScopedLock.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 uint16_t PAGFile::MaxSupportedTagLevel() {
@@ -38,6 +40,80 @@ std::shared_ptr<PAGFile> PAGFile::Load(const std::string& filePath) {
   return MakeFrom(file);
 }
 
+/**
+ * Builds the contents of the image and text layers visible at the specified frame of the
+ * composition, which includes decoding the image headers, matching the fonts and shaping the texts.
+ * The contents are cached in the layers and shared by all PAGFiles of the same File.
+ */
+static void PreloadComposition(Composition* composition, Frame compositionFrame) {
+  if (composition->type() != CompositionType::Vector) {
+    return;
+  }
+  for (auto layer : static_cast<VectorComposition*>(composition)->layers) {
+    if (!layer->isActive) {
+      continue;
+    }
+    auto contentFrame = compositionFrame - layer->startTime;
+    if (contentFrame < 0 || contentFrame >= layer->duration) {
+      continue;
+    }
+    auto layerType = layer->type();
+    if (layerType == LayerType::PreCompose) {
+      auto preComposeLayer = static_cast<PreComposeLayer*>(layer);
+      PreloadComposition(preComposeLayer->composition,
+                         preComposeLayer->getCompositionFrame(compositionFrame));
+    } else if (layerType == LayerType::Image || layerType == LayerType::Text) {
+      auto layerCache = LayerCache::Get(layer);
+      if (layerCache->contentVisible(contentFrame)) {
+        layerCache->getContent(contentFrame);
+      }
+    }
+  }
+}
+
+struct LoadAsyncTask {
+  LoadAsyncTask(size_t count, std::function<void(std::vector<std::shared_ptr<PAGFile>>)> callback)
+      : files(count), pendingCount(count), callback(std::move(callback)) {
+  }
+
+  std::mutex locker = {};
+  std::vector<std::shared_ptr<PAGFile>> files = {};
+  size_t pendingCount = 0;
+  std::function<void(std::vector<std::shared_ptr<PAGFile>>)> callback = nullptr;
+};
+
+void PAGFile::LoadAsync(const std::vector<std::string>& filePaths,
+                        std::function<void(std::vector<std::shared_ptr<PAGFile>>)> callback,
+                        bool preloadResources) {
+  if (callback == nullptr) {
+    return;
+  }
+  if (filePaths.empty()) {
+    callback({});
+    return;
+  }
+  auto loadTask = std::make_shared<LoadAsyncTask>(filePaths.size(), std::move(callback));
+  for (size_t i = 0; i < filePaths.size(); i++) {
+    tgfx::Task::Run([loadTask, i, filePath = filePaths[i], preloadResources]() {
+      auto file = File::Load(filePath);
+      if (file != nullptr && preloadResources) {
+        auto rootLayer = file->getRootLayer();
+        PreloadComposition(rootLayer->composition, rootLayer->getCompositionFrame(0));
+      }
+      auto pagFile = MakeFrom(file);
+      bool finished = false;
+      {
+        std::lock_guard<std::mutex> autoLock(loadTask->locker);
+        loadTask->files[i] = pagFile;
+        finished = --loadTask->pendingCount == 0;
+      }
+      if (finished) {
+        loadTask->callback(std::move(loadTask->files));
+      }
+    });
+  }
+}
+
 std::shared_ptr<PAGFile> PAGFile::MakeFrom(std::shared_ptr<File> file) {
   if (file == nullptr) {
     return nullptr;
@@ -43,6 +43,7 @@ PAGLayer::~PAGLayer() {
     _trackMatteLayer->detachFromTree();
     _trackMatteLayer->trackMatteOwner = nullptr;
   }
+  delete trackMatteCache;
 }
 
 uint32_t PAGLayer::uniqueID() const {
@@ -479,6 +480,8 @@ void PAGLayer::onAddToStage(PAGStage* pagStage) {
 void PAGLayer::onRemoveFromStage() {
   stage->removeReference(this);
   stage = nullptr;
+  delete trackMatteCache;
+  trackMatteCache = nullptr;
   if (_trackMatteLayer != nullptr) {
     _trackMatteLayer->onRemoveFromStage();
   }
@@ -98,6 +98,18 @@ class PAGStage : public PAGComposition {
 
   float getAssetMinScale(ID assetID);
 
+  /**
+   * Records a lookup of the track matte caches in the layers of this stage. The counts are reported
+   * through the Performance of the RenderCache at the end of each frame.
+   */
+  void recordTrackMatteCache(bool hit) {
+    if (hit) {
+      trackMatteCacheHits++;
+    } else {
+      trackMatteCacheMisses++;
+    }
+  }
+
  protected:
   void invalidateCacheScale() override {
     PAGComposition::invalidateCacheScale();
@@ -116,6 +128,8 @@ class PAGStage : public PAGComposition {
   std::unordered_map<ID, SequenceCache> sequenceCache = {};
   std::unordered_set<ID> invalidAssets = {};
   std::unordered_map<ID, PAGImage*> pagImageMap = {};
+  int trackMatteCacheHits = 0;
+  int trackMatteCacheMisses = 0;
 
   static tgfx::Point GetLayerContentScaleFactor(PAGLayer* pagLayer, bool isPAGImage);
   PAGStage(int width, int height);
@@ -175,6 +175,14 @@ Content* PAGTextLayer::getContent() {
   return layerCache->getContent(contentFrame);
 }
 
+std::shared_ptr<TextContentCache> PAGTextLayer::getTextContentCache() {
+  if (replacement != nullptr) {
+    return replacement->getContentCache();
+  }
+  // The layer cache lives as long as the layer, which this PAGTextLayer keeps alive.
+  return std::shared_ptr<TextContentCache>(weakThis.lock(), layerCache->getTextContentCache());
+}
+
 bool PAGTextLayer::contentModified() const {
   return replacement != nullptr;
 }
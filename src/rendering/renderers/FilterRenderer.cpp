@@ -18,6 +18,7 @@
 
 #include "FilterRenderer.h"
 #include "base/utils/MatrixUtil.h"
+#include "base/utils/Tracer.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/filters/BrightnessContrastFilter.h"
@@ -33,7 +34,11 @@
 #include "rendering/filters/MotionTileFilter.h"
 #include "rendering/filters/RadialBlurFilter.h"
 #include "rendering/filters/gaussianblur/GaussianBlurFilter.h"
+#include "rendering/filters/glow/GlowBlurFilter.h"
 #include "rendering/filters/glow/GlowFilter.h"
+#include "rendering/filters/glow/GlowMergeFilter.h"
+#include "rendering/filters/layerstyle/AlphaEdgeDetectFilter.h"
+#include "rendering/filters/layerstyle/SolidStrokeFilter.h"
 #include "rendering/filters/utils/Filter3DFactory.h"
 #include "tgfx/core/PictureRecorder.h"
 
@@ -218,7 +223,7 @@ std::shared_ptr<tgfx::Image> ApplyFilter(std::shared_ptr<tgfx::Image> input, Eff
     case EffectType::LevelsIndividual:
       return LevelsIndividualFilter::Apply(std::move(input), cache, effect, layerFrame, offset);
     case EffectType::FastBlur:
-      return GaussianBlurFilter::Apply(std::move(input), effect, layerFrame, effectScale,
+      return GaussianBlurFilter::Apply(std::move(input), cache, effect, layerFrame, effectScale,
                                        sourceScale, offset);
     case EffectType::DisplacementMap:
       return DisplacementMapFilter::Apply(std::move(input), effect, layer, cache, layerMatrix,
@@ -368,8 +373,46 @@ static std::shared_ptr<tgfx::Picture> CreateSource(RenderCache* cache, const tgf
   return recorder.finishRecordingAsPicture();
 }
 
+static bool MakeFilterResultKey(const FilterModifier* modifier, float contentScale,
+                                const tgfx::Rect& clipBounds, FilterResultKey* key) {
+  auto layer = modifier->layer;
+  // Layers with static filters are already cached as a whole by their content caches.
+  if (!modifier->cacheResult || LayerCache::Get(layer)->cacheFilters()) {
+    return false;
+  }
+  key->layerID = layer->uniqueID;
+  key->layerFrame = modifier->layerFrame;
+  key->scaleLevel = static_cast<int>(roundf(contentScale * CONTENT_SCALE_STEP));
+  key->clipBounds = clipBounds;
+  key->clipBounds.roundOut();
+  return true;
+}
+
+static void DrawFilterOutput(Canvas* parentCanvas, const FilterList* filterList,
+                             const tgfx::Matrix& contentMatrix, float contentScale,
+                             std::shared_ptr<tgfx::Image> output, const tgfx::Point& totalOffset) {
+  auto cache = parentCanvas->getCache();
+  parentCanvas->save();
+  tgfx::Matrix inverted = tgfx::Matrix::I();
+  contentMatrix.invert(&inverted);
+  parentCanvas->concat(inverted);
+  if (!filterList->layerStyles.empty()) {
+    parentCanvas->translate(totalOffset.x, totalOffset.y);
+    auto filter = LayerStylesFilter::Make(cache, filterList->layerStyles, filterList->layerFrame,
+                                          contentScale, filterList->layerStyleScale);
+    filter->applyFilter(parentCanvas, std::move(output));
+  } else {
+    auto canvasMatrix = parentCanvas->getMatrix();
+    parentCanvas->translate(totalOffset.x, totalOffset.y);
+    parentCanvas->drawImage(output);
+    parentCanvas->setMatrix(canvasMatrix);
+  }
+  parentCanvas->restore();
+}
+
 void FilterRenderer::DrawWithFilter(Canvas* parentCanvas, const FilterModifier* modifier,
                                     std::shared_ptr<Graphic> content) {
+  TRACE_SCOPE_ID("FilterRenderer::DrawWithFilter", modifier->layer->id);
   auto cache = parentCanvas->getCache();
   auto filterList = MakeFilterList(modifier);
   auto contentBounds = GetContentBounds(filterList.get(), content);
@@ -396,6 +439,16 @@ void FilterRenderer::DrawWithFilter(Canvas* parentCanvas, const FilterModifier*
 
   auto contentMatrix = GetLayerMatrix(filterList.get(), contentScale);
 
+  FilterResultKey resultKey = {};
+  auto cacheResult = MakeFilterResultKey(modifier, contentScale, clipBounds, &resultKey);
+  if (cacheResult) {
+    if (auto result = cache->findFilterResult(resultKey)) {
+      DrawFilterOutput(parentCanvas, filterList.get(), contentMatrix, contentScale, result->image,
+                       result->offset);
+      return;
+    }
+  }
+
   auto sourcePicture = CreateSource(cache, contentMatrix, content);
   if (sourcePicture == nullptr) {
     return;
@@ -416,22 +469,113 @@ void FilterRenderer::DrawWithFilter(Canvas* parentCanvas, const FilterModifier*
   auto output = ApplyFilters(input, cache, filterList.get(), sourceScale, filterBounds, clipBounds,
                              clipStartIndex, &offset);
   totalOffset += offset;
+  if (cacheResult && output != input) {
+    // Flattens the output into a texture, otherwise the cached image would run the filters again
+    // every time it is drawn.
+    auto textureImage = output->makeTextureImage(cache->getContext());
+    if (textureImage != nullptr) {
+      output = textureImage;
+      cache->addFilterResult(resultKey, {output, totalOffset});
+    }
+  }
+  DrawFilterOutput(parentCanvas, filterList.get(), contentMatrix, contentScale, std::move(output),
+                   totalOffset);
+}
 
-  parentCanvas->save();
-  tgfx::Matrix inverted = tgfx::Matrix::I();
-  contentMatrix.invert(&inverted);
-  parentCanvas->concat(inverted);
-  if (!filterList->layerStyles.empty()) {
-    parentCanvas->translate(totalOffset.x, totalOffset.y);
-    auto filter = LayerStylesFilter::Make(cache, filterList->layerStyles, filterList->layerFrame,
-                                          contentScale, filterList->layerStyleScale);
-    filter->applyFilter(parentCanvas, std::move(output));
-  } else {
-    auto canvasMatrix = parentCanvas->getMatrix();
-    parentCanvas->translate(totalOffset.x, totalOffset.y);
-    parentCanvas->drawImage(output);
-    parentCanvas->setMatrix(canvasMatrix);
+static void CollectEffectFilters(RenderCache* cache, Effect* effect,
+                                 std::vector<std::shared_ptr<RuntimeFilter>>* filters) {
+  // The shaders of runtime filters never depend on their parameters, so placeholder values are
+  // enough to build the same pipelines that the real drawing will use.
+  switch (effect->type()) {
+    case EffectType::CornerPin: {
+      Point cornerPoints[4] = {};
+      filters->push_back(std::make_shared<CornerPinFilter>(cache, cornerPoints));
+    } break;
+    case EffectType::Bulge:
+      filters->push_back(
+          std::make_shared<BulgeFilter>(cache, 0.0f, 0.0f, Point::Zero(), 0.0f, 0.0f));
+      break;
+    case EffectType::MotionTile:
+      filters->push_back(std::make_shared<MotionTileFilter>(cache, Point::Zero(), 0.0f, 0.0f, 0.0f,
+                                                            0.0f, false, 0.0f, false));
+      break;
+    case EffectType::Glow:
+      filters->push_back(
+          std::make_shared<GlowBlurRuntimeFilter>(cache, BlurDirection::Horizontal, 0.0f, 1.0f));
+      filters->push_back(std::make_shared<GlowMergeRuntimeFilter>(cache, 0.0f, nullptr));
+      break;
+    case EffectType::LevelsIndividual:
+      filters->push_back(
+          std::make_shared<LevelsIndividualFilter>(cache, LevelsIndividualFilterParam()));
+      break;
+    case EffectType::DisplacementMap:
+      filters->push_back(std::make_shared<DisplacementMapFilter>(
+          cache, DisplacementMapSource::Red, 0.0f, DisplacementMapSource::Red, 0.0f,
+          DisplacementMapBehavior::CenterMap, false, false, 1.0f, tgfx::Matrix::I(),
+          tgfx::Size::MakeEmpty(), tgfx::Size::MakeEmpty(), tgfx::Rect::MakeEmpty(), nullptr));
+      break;
+    case EffectType::RadialBlur:
+      filters->push_back(std::make_shared<RadialBlurFilter>(cache, 0.0, tgfx::Point::Zero()));
+      break;
+    case EffectType::Mosaic:
+      filters->push_back(std::make_shared<MosaicFilter>(cache, 0.0f, 0.0f, false));
+      break;
+    case EffectType::BrightnessContrast:
+      filters->push_back(std::make_shared<BrightnessContrastFilter>(cache, 0.0f, 0.0f));
+      break;
+    case EffectType::HueSaturation:
+      filters->push_back(std::make_shared<HueSaturationFilter>(cache, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                                               0.0f, 0.0f));
+      break;
+    default:
+      break;
   }
-  parentCanvas->restore();
+}
+
+static void CollectLayerStyleFilters(RenderCache* cache, LayerStyle* layerStyle,
+                                     std::vector<std::shared_ptr<RuntimeFilter>>* filters) {
+  switch (layerStyle->type()) {
+    case LayerStyleType::Stroke:
+      filters->push_back(std::make_shared<AlphaEdgeDetectLayerEffect>(cache));
+      [[fallthrough]];
+    case LayerStyleType::DropShadow:
+    case LayerStyleType::OuterGlow:
+      filters->push_back(std::make_shared<SolidStrokeNormalFilter>(cache, SolidStrokeOption()));
+      filters->push_back(std::make_shared<SolidStrokeThickFilter>(cache, SolidStrokeOption()));
+      break;
+    default:
+      break;
+  }
+}
+
+int FilterRenderer::PrewarmFilters(RenderCache* cache, tgfx::GPU* gpu, const File* file) {
+  if (cache == nullptr || gpu == nullptr || file == nullptr) {
+    return 0;
+  }
+  std::vector<std::shared_ptr<RuntimeFilter>> filters = {};
+  for (auto composition : file->compositions) {
+    if (composition->type() != CompositionType::Vector) {
+      continue;
+    }
+    for (auto layer : static_cast<VectorComposition*>(composition)->layers) {
+      for (auto effect : layer->effects) {
+        CollectEffectFilters(cache, effect, &filters);
+      }
+      for (auto layerStyle : layer->layerStyles) {
+        CollectLayerStyleFilters(cache, layerStyle, &filters);
+      }
+      if (layer->motionBlur) {
+        filters.push_back(std::make_shared<MotionBlurFilter>(cache, std::array<float, 9>{},
+                                                              std::array<float, 9>{}));
+      }
+    }
+  }
+  int count = 0;
+  for (auto& filter : filters) {
+    if (filter->prewarm(gpu)) {
+      count++;
+    }
+  }
+  return count;
 }
 }  // namespace pag
@@ -45,6 +45,13 @@ class FilterRenderer {
   static void DrawWithFilter(Canvas* parentCanvas, const FilterModifier* modifier,
                              std::shared_ptr<Graphic> content);
 
+  /**
+   * Compiles the render pipelines of all runtime filters used by the layers in the specified file,
+   * so that the first frame displaying them doesn't have to. Returns the number of filters that
+   * were prewarmed successfully.
+   */
+  static int PrewarmFilters(RenderCache* cache, tgfx::GPU* gpu, const File* file);
+
  private:
   static std::unique_ptr<FilterList> MakeFilterList(const FilterModifier* modifier);
 
@@ -19,6 +19,7 @@
 #include "LayerRenderer.h"
 #include "base/utils/MatrixUtil.h"
 #include "base/utils/TGFXCast.h"
+#include "base/utils/Tracer.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/editing/StillImage.h"
 
@@ -42,6 +43,7 @@ void LayerRenderer::DrawLayer(Recorder* recorder, Layer* layer, Frame layerFrame
   if (TransformIllegal(extraTransform) || TrackMatteIsEmpty(trackMatte)) {
     return;
   }
+  TRACE_SCOPE_ID("LayerRenderer::DrawLayer", layer->id);
   auto contentFrame = layerFrame - layer->startTime;
   auto layerCache = LayerCache::Get(layer);
   if (!layerCache->contentVisible(contentFrame)) {
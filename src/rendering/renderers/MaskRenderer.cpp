@@ -18,33 +18,56 @@
 
 #include "MaskRenderer.h"
 #include "pag/file.h"
+#include "rendering/caches/MaskPathCache.h"
 #include "rendering/utils/PathUtil.h"
 
 namespace pag {
+static tgfx::Path MakeMaskPath(const MaskInput& input, bool isFirst) {
+  auto maskPath = ToPath(input.path);
+  ExpandPath(&maskPath, input.expansion);
+  auto inverted = input.inverted;
+  if (isFirst) {
+    if (input.mode == MaskMode::Subtract) {
+      inverted = !inverted;
+    }
+  }
+  if (inverted) {
+    maskPath.toggleInverseFillType();
+  }
+  return maskPath;
+}
+
 void RenderMasks(tgfx::Path* maskContent, const std::vector<MaskData*>& masks, Frame layerFrame) {
+  RenderMasks(maskContent, masks, layerFrame, MaskPathCache::Get());
+}
+
+void RenderMasks(tgfx::Path* maskContent, const std::vector<MaskData*>& masks, Frame layerFrame,
+                 MaskPathCache* cache) {
   bool isFirst = true;
+  ID previousID = 0;
   for (auto& mask : masks) {
-    auto path = mask->maskPath->getValueAt(layerFrame);
-    if (path == nullptr || !path->isClosed() || mask->maskMode == MaskMode::None) {
+    auto input = MakeMaskInput(mask, layerFrame);
+    if (!input.path.isClosed() || input.mode == MaskMode::None) {
       continue;
     }
-    auto maskPath = ToPath(*path);
-    auto expansion = mask->maskExpansion->getValueAt(layerFrame);
-    ExpandPath(&maskPath, expansion);
-    auto inverted = mask->inverted;
-    if (isFirst) {
-      if (mask->maskMode == MaskMode::Subtract) {
-        inverted = !inverted;
+    MaskPathKey key = {previousID, std::move(input)};
+    if (cache != nullptr) {
+      // 前面的蒙版结果未变化时直接复用，只有从第一个变化的蒙版开始才需要重新做路径运算。
+      previousID = cache->find(key, maskContent);
+      if (previousID != 0) {
+        isFirst = false;
+        continue;
       }
     }
-    if (inverted) {
-      maskPath.toggleInverseFillType();
-    }
+    auto maskPath = MakeMaskPath(key.mask, isFirst);
     if (isFirst) {
       isFirst = false;
       *maskContent = maskPath;
     } else {
-      maskContent->addPath(maskPath, ToPathOp(mask->maskMode));
+      maskContent->addPath(maskPath, ToPathOp(key.mask.mode));
+    }
+    if (cache != nullptr) {
+      previousID = cache->add(key, *maskContent);
     }
   }
 }
@@ -23,5 +23,18 @@
 #include "tgfx/core/Path.h"
 
 namespace pag {
+class MaskPathCache;
+
+/**
+ * Combines the masks at the specified frame into one path, reusing the results of MaskPathCache
+ * shared by all layers.
+ */
 void RenderMasks(tgfx::Path* maskContent, const std::vector<MaskData*>& masks, Frame layerFrame);
+
+/**
+ * Combines the masks at the specified frame into one path. Only the masks after the longest chain
+ * found in the specified cache are evaluated, the cache is skipped if it is nullptr.
+ */
+void RenderMasks(tgfx::Path* maskContent, const std::vector<MaskData*>& masks, Frame layerFrame,
+                 MaskPathCache* cache);
 }
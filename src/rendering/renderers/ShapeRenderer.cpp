@@ -80,6 +80,8 @@ class PaintElement : public ElementData {
     newPaint->stroke = stroke;
     newPaint->pathFillType = pathFillType;
     newPaint->compositeOrder = compositeOrder;
+    newPaint->source = source;
+    newPaint->matrix = matrix;
     return std::unique_ptr<ElementData>(newPaint);
   }
 
@@ -98,6 +100,10 @@ class PaintElement : public ElementData {
   tgfx::Color color = tgfx::Color::White();
   GradientPaint gradient;
   StrokePaint stroke;
+  // The paint element in the shape geometry only records where it comes from, its values are
+  // resolved from the source element at each frame.
+  ShapeElement* source = nullptr;
+  tgfx::Matrix matrix = tgfx::Matrix::I();
 };
 
 class PathElement : public ElementData {
@@ -135,6 +141,7 @@ class GroupElement : public ElementData {
     auto newGroup = new GroupElement();
     newGroup->blendMode = blendMode;
     newGroup->alpha = alpha;
+    newGroup->opacity = opacity;
     for (auto& data : elements) {
       auto element = data->clone().release();
       newGroup->elements.push_back(element);
@@ -177,6 +184,8 @@ class GroupElement : public ElementData {
 
   tgfx::BlendMode blendMode = tgfx::BlendMode::SrcOver;
   float alpha = 1.0f;
+  // The opacity of the shape transform, which is applied on top of the alpha at each frame.
+  Property<Opacity>* opacity = nullptr;
   std::vector<ElementData*> elements;
 };
 
@@ -683,7 +692,7 @@ void RenderElements_ShapeGroup(ShapeElement* element, const tgfx::Matrix& parent
   auto transform = ShapeTransformToTransform(shape->transform, frame);
   transform.matrix.postConcat(parentMatrix);
   auto group = new GroupElement();
-  group->alpha = transform.alpha;
+  group->opacity = shape->transform->opacity;
   group->blendMode = ToTGFX(shape->blendMode);
   RenderElements(shape->elements, transform.matrix, group, frame);
   parentGroup->elements.push_back(group);
@@ -721,40 +730,33 @@ void RenderElements_ShapePath(ShapeElement* element, const tgfx::Matrix& parentM
   parentGroup->elements.push_back(pathElement);
 }
 
-void RenderElements_Fill(ShapeElement* element, const tgfx::Matrix&, GroupElement* parentGroup,
-                         Frame frame) {
-  auto fill = static_cast<FillElement*>(element);
-  auto paint = FillToPaint(fill, frame);
-  if (paint != nullptr) {
-    parentGroup->elements.push_back(paint);
-  }
+void AddPaintSlot(PaintType paintType, ShapeElement* element, const tgfx::Matrix& parentMatrix,
+                  GroupElement* parentGroup) {
+  auto paint = new PaintElement(paintType);
+  paint->source = element;
+  paint->matrix = parentMatrix;
+  paint->stroke.matrix = parentMatrix;
+  parentGroup->elements.push_back(paint);
+}
+
+void RenderElements_Fill(ShapeElement* element, const tgfx::Matrix& parentMatrix,
+                         GroupElement* parentGroup, Frame) {
+  AddPaintSlot(PaintType::Fill, element, parentMatrix, parentGroup);
 }
 
 void RenderElements_Stroke(ShapeElement* element, const tgfx::Matrix& parentMatrix,
-                           GroupElement* parentGroup, Frame frame) {
-  auto stroke = static_cast<StrokeElement*>(element);
-  auto paint = StrokeToPaint(stroke, parentMatrix, frame);
-  if (paint != nullptr) {
-    parentGroup->elements.push_back(paint);
-  }
+                           GroupElement* parentGroup, Frame) {
+  AddPaintSlot(PaintType::Stroke, element, parentMatrix, parentGroup);
 }
 
 void RenderElements_GradientFill(ShapeElement* element, const tgfx::Matrix& parentMatrix,
-                                 GroupElement* parentGroup, Frame frame) {
-  auto fill = static_cast<GradientFillElement*>(element);
-  auto paint = GradientFillToPaint(fill, parentMatrix, frame);
-  if (paint != nullptr) {
-    parentGroup->elements.push_back(paint);
-  }
+                                 GroupElement* parentGroup, Frame) {
+  AddPaintSlot(PaintType::GradientFill, element, parentMatrix, parentGroup);
 }
 
 void RenderElements_GradientStroke(ShapeElement* element, const tgfx::Matrix& parentMatrix,
-                                   GroupElement* parentGroup, Frame frame) {
-  auto stroke = static_cast<GradientStrokeElement*>(element);
-  auto paint = GradientStrokeToPaint(stroke, parentMatrix, frame);
-  if (paint != nullptr) {
-    parentGroup->elements.push_back(paint);
-  }
+                                   GroupElement* parentGroup, Frame) {
+  AddPaintSlot(PaintType::GradientStroke, element, parentMatrix, parentGroup);
 }
 
 void RenderElements_MergePaths(ShapeElement* element, const tgfx::Matrix&,
@@ -849,6 +851,28 @@ void ApplyStrokeToPath(tgfx::Path* path, const StrokePaint& stroke) {
   }
 }
 
+PaintElement* ResolvePaint(PaintElement* slot, Frame frame) {
+  switch (slot->paintType) {
+    case PaintType::Fill:
+      return FillToPaint(static_cast<FillElement*>(slot->source), frame);
+    case PaintType::Stroke:
+      return StrokeToPaint(static_cast<StrokeElement*>(slot->source), slot->stroke.matrix, frame);
+    case PaintType::GradientFill:
+      return GradientFillToPaint(static_cast<GradientFillElement*>(slot->source), slot->matrix,
+                                 frame);
+    case PaintType::GradientStroke: {
+      auto paint =
+          GradientStrokeToPaint(static_cast<GradientStrokeElement*>(slot->source), slot->matrix,
+                                frame);
+      if (paint != nullptr) {
+        paint->stroke.matrix = slot->stroke.matrix;
+      }
+      return paint;
+    }
+  }
+  return nullptr;
+}
+
 std::shared_ptr<Graphic> RenderShape(ID assetID, PaintElement* paint, tgfx::Path* path) {
   tgfx::Path shapePath = *path;
   auto paintType = paint->paintType;
@@ -870,7 +894,8 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, PaintElement* paint, tgfx::Path
   return Graphic::MakeCompose(shape, modifier);
 }
 
-std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path* path) {
+std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path* path,
+                                     Frame frame) {
   std::vector<std::shared_ptr<Graphic>> contents = {};
   for (auto& element : group->elements) {
     switch (element->type()) {
@@ -879,8 +904,12 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path
         path->addPath(pathElement->path);
       } break;
       case ElementDataType::Paint: {
-        auto paint = reinterpret_cast<PaintElement*>(element);
-        auto shape = RenderShape(assetID, paint, path);
+        std::unique_ptr<PaintElement> paint(
+            ResolvePaint(reinterpret_cast<PaintElement*>(element), frame));
+        if (paint == nullptr) {
+          break;
+        }
+        auto shape = RenderShape(assetID, paint.get(), path);
         if (shape) {
           if (paint->compositeOrder == CompositeOrder::AbovePreviousInSameGroup) {
             contents.push_back(shape);
@@ -891,7 +920,7 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path
       } break;
       case ElementDataType::Group: {
         tgfx::Path tempPath = {};
-        auto shape = RenderShape(assetID, static_cast<GroupElement*>(element), &tempPath);
+        auto shape = RenderShape(assetID, static_cast<GroupElement*>(element), &tempPath, frame);
         path->addPath(tempPath);
         if (shape) {
           contents.insert(contents.begin(), shape);
@@ -900,16 +929,135 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path
     }
   }
   auto shape = Graphic::MakeCompose(contents);
-  auto modifier = Modifier::MakeBlend(group->alpha, group->blendMode);
+  auto alpha = group->alpha;
+  if (group->opacity != nullptr) {
+    alpha *= ToAlpha(group->opacity->getValueAt(frame));
+  }
+  auto modifier = Modifier::MakeBlend(alpha, group->blendMode);
   return Graphic::MakeCompose(shape, modifier);
 }
 
-std::shared_ptr<Graphic> RenderShapes(ID assetID, const std::vector<ShapeElement*>& contents,
-                                      Frame layerFrame) {
-  GroupElement rootGroup;
+void AppendKeyValue(ShapeGeometryKey* key, float value) {
+  key->values.push_back(value);
+}
+
+void AppendKeyValue(ShapeGeometryKey* key, const Point& value) {
+  key->values.push_back(value.x);
+  key->values.push_back(value.y);
+}
+
+void AppendKeyValue(ShapeGeometryKey* key, const PathHandle& value) {
+  key->values.push_back(static_cast<float>(value->verbs.size()));
+  for (auto& verb : value->verbs) {
+    key->values.push_back(static_cast<float>(verb));
+  }
+  for (auto& point : value->points) {
+    key->values.push_back(point.x);
+    key->values.push_back(point.y);
+  }
+}
+
+template <typename T>
+void AppendKeyProperty(ShapeGeometryKey* key, Property<T>* property, Frame frame) {
+  // The values of static properties are the same at every frame, so they never tell two frames
+  // apart.
+  if (property != nullptr && property->animatable()) {
+    AppendKeyValue(key, property->getValueAt(frame));
+  }
+}
+
+void AppendKeyTransform(ShapeGeometryKey* key, ShapeTransform* transform, Frame frame) {
+  AppendKeyProperty(key, transform->anchorPoint, frame);
+  AppendKeyProperty(key, transform->position, frame);
+  AppendKeyProperty(key, transform->scale, frame);
+  AppendKeyProperty(key, transform->skew, frame);
+  AppendKeyProperty(key, transform->skewAxis, frame);
+  AppendKeyProperty(key, transform->rotation, frame);
+}
+
+void AppendKeyElements(ShapeGeometryKey* key, const std::vector<ShapeElement*>& list,
+                       Frame frame) {
+  for (auto& element : list) {
+    switch (element->type()) {
+      case ShapeType::ShapeGroup: {
+        auto group = static_cast<ShapeGroupElement*>(element);
+        AppendKeyTransform(key, group->transform, frame);
+        AppendKeyElements(key, group->elements, frame);
+      } break;
+      case ShapeType::Rectangle: {
+        auto rectangle = static_cast<RectangleElement*>(element);
+        AppendKeyProperty(key, rectangle->size, frame);
+        AppendKeyProperty(key, rectangle->position, frame);
+        AppendKeyProperty(key, rectangle->roundness, frame);
+      } break;
+      case ShapeType::Ellipse: {
+        auto ellipse = static_cast<EllipseElement*>(element);
+        AppendKeyProperty(key, ellipse->size, frame);
+        AppendKeyProperty(key, ellipse->position, frame);
+      } break;
+      case ShapeType::PolyStar: {
+        auto polyStar = static_cast<PolyStarElement*>(element);
+        AppendKeyProperty(key, polyStar->points, frame);
+        AppendKeyProperty(key, polyStar->position, frame);
+        AppendKeyProperty(key, polyStar->rotation, frame);
+        AppendKeyProperty(key, polyStar->innerRadius, frame);
+        AppendKeyProperty(key, polyStar->outerRadius, frame);
+        AppendKeyProperty(key, polyStar->innerRoundness, frame);
+        AppendKeyProperty(key, polyStar->outerRoundness, frame);
+      } break;
+      case ShapeType::ShapePath:
+        AppendKeyProperty(key, static_cast<ShapePathElement*>(element)->shapePath, frame);
+        break;
+      case ShapeType::TrimPaths: {
+        auto trimPaths = static_cast<TrimPathsElement*>(element);
+        AppendKeyProperty(key, trimPaths->start, frame);
+        AppendKeyProperty(key, trimPaths->end, frame);
+        AppendKeyProperty(key, trimPaths->offset, frame);
+      } break;
+      case ShapeType::Repeater: {
+        // The opacities of a repeater are baked into the alpha of each copy.
+        auto repeater = static_cast<RepeaterElement*>(element);
+        AppendKeyProperty(key, repeater->copies, frame);
+        AppendKeyProperty(key, repeater->offset, frame);
+        AppendKeyProperty(key, repeater->transform->anchorPoint, frame);
+        AppendKeyProperty(key, repeater->transform->position, frame);
+        AppendKeyProperty(key, repeater->transform->scale, frame);
+        AppendKeyProperty(key, repeater->transform->rotation, frame);
+        AppendKeyProperty(key, repeater->transform->startOpacity, frame);
+        AppendKeyProperty(key, repeater->transform->endOpacity, frame);
+      } break;
+      case ShapeType::RoundCorners:
+        AppendKeyProperty(key, static_cast<RoundCornersElement*>(element)->radius, frame);
+        break;
+      default:
+        // Fills, strokes and merge paths have no animated property that affects the paths.
+        break;
+    }
+  }
+}
+
+ShapeGeometryKey MakeShapeGeometryKey(const std::vector<ShapeElement*>& contents, Frame frame) {
+  ShapeGeometryKey key = {};
+  AppendKeyElements(&key, contents, frame);
+  return key;
+}
+
+std::shared_ptr<GroupElement> RenderShapeGeometry(const std::vector<ShapeElement*>& contents,
+                                                  Frame layerFrame) {
+  auto rootGroup = std::make_shared<GroupElement>();
   auto matrix = tgfx::Matrix::I();
-  RenderElements(contents, matrix, &rootGroup, layerFrame);
+  RenderElements(contents, matrix, rootGroup.get(), layerFrame);
+  return rootGroup;
+}
+
+std::shared_ptr<Graphic> RenderShapePaints(ID assetID, GroupElement* geometry, Frame layerFrame) {
   tgfx::Path tempPath = {};
-  return RenderShape(assetID, &rootGroup, &tempPath);
+  return RenderShape(assetID, geometry, &tempPath, layerFrame);
+}
+
+std::shared_ptr<Graphic> RenderShapes(ID assetID, const std::vector<ShapeElement*>& contents,
+                                      Frame layerFrame) {
+  auto geometry = RenderShapeGeometry(contents, layerFrame);
+  return RenderShapePaints(assetID, geometry.get(), layerFrame);
 }
 }  // namespace pag
@@ -23,6 +23,35 @@
 #include "rendering/utils/Transform.h"
 
 namespace pag {
+class GroupElement;
+
+/**
+ * The values of all animated properties that affect the paths of some shape elements at a frame.
+ * Two frames with equal keys have the same shape geometry, even if their paints are different.
+ */
+struct ShapeGeometryKey {
+  std::vector<float> values;
+
+  bool operator==(const ShapeGeometryKey& other) const {
+    return values == other.values;
+  }
+};
+
+ShapeGeometryKey MakeShapeGeometryKey(const std::vector<ShapeElement*>& contents, Frame frame);
+
+/**
+ * Builds the geometry of the shape elements at the specified frame, which runs all the path
+ * operations, such as trim paths, merge paths and repeaters. The paints in the returned geometry
+ * only refer to their source elements, so it can be reused by any frame with the same geometry key.
+ */
+std::shared_ptr<GroupElement> RenderShapeGeometry(const std::vector<ShapeElement*>& contents,
+                                                  Frame layerFrame);
+
+/**
+ * Resolves the paints of the shape geometry at the specified frame and returns the final graphic.
+ */
+std::shared_ptr<Graphic> RenderShapePaints(ID assetID, GroupElement* geometry, Frame layerFrame);
+
 std::shared_ptr<Graphic> RenderShapes(ID assetID, const std::vector<ShapeElement*>& contents,
                                       Frame layerFrame);
 }
@@ -20,15 +20,21 @@
 #include "base/utils/MathUtil.h"
 #include "base/utils/TGFXCast.h"
 #include "rendering/FontManager.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/caches/TextContentCache.h"
+#include "rendering/graphics/Canvas.h"
 #include "rendering/graphics/Shape.h"
+#include "rendering/graphics/Text.h"
 #include "rendering/utils/PathUtil.h"
 #include "tgfx/core/PathEffect.h"
 #include "tgfx/core/PathMeasure.h"
+#include "tgfx/core/Surface.h"
 
 namespace pag {
 
 #define LINE_GAP_FACTOR 1.2f
 #define EMPTY_LINE_WIDTH 1.0f
+#define GLYPH_PREWARM_SURFACE_SIZE 64
 
 struct GlyphInfo {
   int glyphIndex = 0;
@@ -539,4 +545,52 @@ void CalculateTextAscentAndDescent(const TextDocument* textDocument, float* pMin
   *pMinAscent = minAscent;
   *pMaxDescent = maxDescent;
 }
+
+std::vector<std::shared_ptr<TextBlock>> CollectTextBlocks(
+    const std::vector<std::shared_ptr<TextContentCache>>& textContentCaches) {
+  std::vector<std::shared_ptr<TextBlock>> textBlocks = {};
+  for (auto& textContentCache : textContentCaches) {
+    auto cacheTextBlocks = textContentCache->getTextBlocks();
+    textBlocks.insert(textBlocks.end(), cacheTextBlocks.begin(), cacheTextBlocks.end());
+  }
+  return textBlocks;
+}
+
+int PrewarmGlyphs(RenderCache* cache, const std::vector<std::shared_ptr<TextBlock>>& textBlocks) {
+  if (cache == nullptr || cache->getContext() == nullptr || textBlocks.empty()) {
+    return 0;
+  }
+  // The glyphs only need to touch the surface to get rasterized into the atlas, so a small surface
+  // is enough. Each glyph is moved to the origin to keep it inside the clip.
+  auto surface = tgfx::Surface::Make(cache->getContext(), GLYPH_PREWARM_SURFACE_SIZE,
+                                     GLYPH_PREWARM_SURFACE_SIZE);
+  if (surface == nullptr) {
+    return 0;
+  }
+  Canvas canvas(surface.get(), cache);
+  int count = 0;
+  for (auto& textBlock : textBlocks) {
+    auto assetScale = cache->getAssetMaxScale(textBlock->assetID());
+    auto scale = (assetScale > 0 ? assetScale : 1.0f) * textBlock->maxScale();
+    auto glyphs = textBlock->maskAtlasGlyphs(1.0f);
+    auto colorGlyphs = textBlock->colorAtlasGlyphs(1.0f);
+    glyphs.insert(glyphs.end(), colorGlyphs.begin(), colorGlyphs.end());
+    for (auto& glyph : glyphs) {
+      auto graphic = Text::MakeFrom({glyph}, textBlock);
+      if (graphic == nullptr) {
+        continue;
+      }
+      tgfx::Rect bounds = {};
+      graphic->measureBounds(&bounds);
+      canvas.save();
+      canvas.scale(scale, scale);
+      canvas.translate(-bounds.left, -bounds.top);
+      graphic->draw(&canvas);
+      canvas.restore();
+      count++;
+    }
+  }
+  cache->getContext()->flushAndSubmit();
+  return count;
+}
 }  // namespace pag
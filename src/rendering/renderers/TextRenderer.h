@@ -23,6 +23,10 @@
 #include "rendering/graphics/Graphic.h"
 
 namespace pag {
+class RenderCache;
+class TextBlock;
+class TextContentCache;
+
 std::pair<std::vector<std::vector<GlyphHandle>>, tgfx::Rect> GetLines(
     const TextDocument* textDocument, const TextPathOptions* pathOptions);
 
@@ -32,4 +36,21 @@ std::shared_ptr<Graphic> RenderTextBackground(ID assetID,
 
 void CalculateTextAscentAndDescent(const TextDocument* textDocument, float* pMinAscent,
                                    float* pMaxDescent);
+
+/**
+ * Shapes every text document of the specified text content caches, including every keyframe of
+ * their source texts, and returns the resulting text blocks. The text blocks stay cached in the
+ * content caches, so the caches of original text layers share them with all PAGFiles of the same
+ * File. It requires no GPU context or root locker and can be called on any thread.
+ */
+std::vector<std::shared_ptr<TextBlock>> CollectTextBlocks(
+    const std::vector<std::shared_ptr<TextContentCache>>& textContentCaches);
+
+/**
+ * Draws every distinct glyph of the specified text blocks once at its expected scale, which fills
+ * the glyph atlas of the context attached to the cache. The atlas is owned by the GPU context, so
+ * all players rendering to that context reuse the rasterized glyphs. Returns the number of glyphs
+ * that have been prewarmed.
+ */
+int PrewarmGlyphs(RenderCache* cache, const std::vector<std::shared_ptr<TextBlock>>& textBlocks);
 }  // namespace pag
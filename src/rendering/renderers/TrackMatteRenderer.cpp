@@ -21,6 +21,7 @@
 #include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/caches/TextContent.h"
+#include "rendering/layers/PAGStage.h"
 #include "rendering/renderers/LayerRenderer.h"
 
 namespace pag {
@@ -65,12 +66,8 @@ static std::shared_ptr<Modifier> MakeMaskModifier(std::shared_ptr<Graphic> conte
   return Modifier::MakeMask(std::move(content), inverted, useLuma);
 }
 
-std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner) {
-  if (trackMatteOwner == nullptr || trackMatteOwner->_trackMatteLayer == nullptr) {
-    return nullptr;
-  }
-  auto trackMatteLayer = trackMatteOwner->_trackMatteLayer.get();
-  auto trackMatteType = trackMatteOwner->layer->trackMatteType;
+static std::unique_ptr<TrackMatte> MakeTrackMatte(PAGLayer* trackMatteLayer,
+                                                  TrackMatteType trackMatteType) {
   auto layerFrame = trackMatteLayer->contentFrame + trackMatteLayer->layer->startTime;
   std::shared_ptr<FilterModifier> filterModifier = nullptr;
   if (!trackMatteLayer->cacheFilters()) {
@@ -94,6 +91,60 @@ std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner)
   return trackMatte;
 }
 
+static bool TrackMatteCacheEnabled(PAGLayer* trackMatteLayer) {
+  // 被编辑过的内容（替换的图片、文本或子图层）不受静态区间的约束，无法复用。
+  if (trackMatteLayer->contentModified()) {
+    return false;
+  }
+  // 预合成图层的静态区间不包含子图层的变化，只有内容完全静态时才能复用。
+  return trackMatteLayer->layerType() != LayerType::PreCompose ||
+         trackMatteLayer->layerCache->contentStatic();
+}
+
+static bool CheckTrackMatteCache(PAGLayer* trackMatteLayer, const TrackMatteCache* cache) {
+  return cache->layerMatrix == trackMatteLayer->layerMatrix &&
+         cache->layerAlpha == trackMatteLayer->layerAlpha &&
+         !trackMatteLayer->layerCache->checkFrameChanged(trackMatteLayer->contentFrame,
+                                                         cache->contentFrame);
+}
+
+std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner) {
+  if (trackMatteOwner == nullptr || trackMatteOwner->_trackMatteLayer == nullptr) {
+    return nullptr;
+  }
+  auto trackMatteLayer = trackMatteOwner->_trackMatteLayer.get();
+  auto trackMatteType = trackMatteOwner->layer->trackMatteType;
+  if (!TrackMatteCacheEnabled(trackMatteLayer)) {
+    delete trackMatteLayer->trackMatteCache;
+    trackMatteLayer->trackMatteCache = nullptr;
+    if (trackMatteLayer->stage != nullptr) {
+      trackMatteLayer->stage->recordTrackMatteCache(false);
+    }
+    return MakeTrackMatte(trackMatteLayer, trackMatteType);
+  }
+  auto cache = trackMatteLayer->trackMatteCache;
+  auto hit = cache != nullptr && CheckTrackMatteCache(trackMatteLayer, cache);
+  if (trackMatteLayer->stage != nullptr) {
+    trackMatteLayer->stage->recordTrackMatteCache(hit);
+  }
+  if (!hit) {
+    if (cache == nullptr) {
+      cache = new TrackMatteCache();
+      trackMatteLayer->trackMatteCache = cache;
+    }
+    auto trackMatte = MakeTrackMatte(trackMatteLayer, trackMatteType);
+    cache->contentFrame = trackMatteLayer->contentFrame;
+    cache->layerMatrix = trackMatteLayer->layerMatrix;
+    cache->layerAlpha = trackMatteLayer->layerAlpha;
+    cache->trackMatte = trackMatte ? *trackMatte : TrackMatte();
+    return trackMatte;
+  }
+  if (cache->trackMatte.modifier == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<TrackMatte>(cache->trackMatte);
+}
+
 std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(Layer* trackMatteOwner, Frame layerFrame) {
   if (trackMatteOwner == nullptr || trackMatteOwner->trackMatteLayer == nullptr) {
     return nullptr;
@@ -28,10 +28,22 @@ struct TrackMatte {
   std::shared_ptr<Graphic> colorGlyphs = nullptr;
 };
 
+/**
+ * The track matte recorded for a matte layer at some frame, which can be reused by the following
+ * frames as long as the matte layer renders the same content.
+ */
+struct TrackMatteCache {
+  Frame contentFrame = 0;
+  Matrix layerMatrix = {};
+  float layerAlpha = 1.0f;
+  TrackMatte trackMatte = {};
+};
+
 class TrackMatteRenderer {
  public:
   /**
-   * Returns nullptr if trackMatteLayer is nullptr.
+   * Returns nullptr if trackMatteLayer is nullptr. The track matte is cached in the matte layer and
+   * reused while the matte layer stays within the same static time range.
    */
   static std::unique_ptr<TrackMatte> Make(PAGLayer* trackMatteOwner);
 
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SequenceReader.h"
+#include "base/utils/Tracer.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/sequences/BitmapSequenceReader.h"
 #include "rendering/sequences/VideoReader.h"
@@ -24,6 +25,7 @@
 
 namespace pag {
 std::shared_ptr<tgfx::ImageBuffer> SequenceReader::readBuffer(Frame targetFrame) {
+  TRACE_SCOPE_ID("SequenceReader::readBuffer", targetFrame);
   tgfx::Clock clock = {};
   auto buffer = onMakeBuffer(targetFrame);
   decodingTime += clock.measure();
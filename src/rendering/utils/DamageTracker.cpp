@@ -0,0 +1,208 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DamageTracker.h"
+#include <unordered_set>
+#include "pag/file.h"
+#include "base/utils/TGFXCast.h"
+#include "rendering/caches/LayerCache.h"
+#include "rendering/layers/PAGStage.h"
+
+namespace pag {
+// Beyond this number, all damaged areas are merged into one rect, since the cost of issuing many
+// small scissored draws outweighs the saved fill-rate.
+static constexpr size_t MAX_DAMAGE_RECTS = 8;
+
+bool DamageTracker::CanTrackChildren(PAGLayer* pagLayer) {
+  auto layer = pagLayer->layer;
+  if (layer->type() != LayerType::PreCompose) {
+    return false;
+  }
+  if (!layer->masks.empty() || !layer->effects.empty() || !layer->layerStyles.empty() ||
+      layer->motionBlur || layer->blendMode != BlendMode::Normal || layer->transform3D != nullptr ||
+      pagLayer->_trackMatteLayer != nullptr) {
+    return false;
+  }
+  auto composition = static_cast<PreComposeLayer*>(layer)->composition;
+  return composition->type() == CompositionType::Vector;
+}
+
+// Returns true if the children kept in both lists are not in the same relative order.
+static bool IsReordered(const std::vector<ID>& oldIDs, const std::vector<ID>& newIDs) {
+  if (oldIDs == newIDs) {
+    return false;
+  }
+  std::unordered_set<ID> oldSet(oldIDs.begin(), oldIDs.end());
+  std::unordered_set<ID> newSet(newIDs.begin(), newIDs.end());
+  auto oldIter = oldIDs.begin();
+  for (auto id : newIDs) {
+    if (oldSet.count(id) == 0) {
+      continue;
+    }
+    while (oldIter != oldIDs.end() && newSet.count(*oldIter) == 0) {
+      oldIter++;
+    }
+    if (oldIter == oldIDs.end() || *oldIter != id) {
+      return true;
+    }
+    oldIter++;
+  }
+  return false;
+}
+
+void DamageTracker::update(PAGStage* stage) {
+  rects.clear();
+  updateCount++;
+  fullDamage = invalidated;
+  invalidated = false;
+  if (stage->widthInternal() != stageWidth || stage->heightInternal() != stageHeight) {
+    stageWidth = stage->widthInternal();
+    stageHeight = stage->heightInternal();
+    fullDamage = true;
+  }
+  visitComposition(stage, tgfx::Matrix::I(), 1.0f);
+  for (auto iter = layerStates.begin(); iter != layerStates.end();) {
+    if (iter->second.updateCount != updateCount) {
+      // The layer has been removed or become invisible since the last update.
+      addDamage(iter->second.bounds);
+      iter = layerStates.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+  for (auto iter = compositionStates.begin(); iter != compositionStates.end();) {
+    if (iter->second.updateCount != updateCount) {
+      iter = compositionStates.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+  if (fullDamage) {
+    rects.clear();
+  }
+}
+
+void DamageTracker::visitComposition(PAGComposition* composition, const tgfx::Matrix& matrix,
+                                     float alpha) {
+  std::vector<ID> childIDs = {};
+  for (auto& childLayer : composition->layers) {
+    if (!childLayer->layerVisible) {
+      continue;
+    }
+    childIDs.push_back(childLayer->_uniqueID);
+    visitLayer(childLayer.get(), matrix, alpha);
+  }
+  auto& state = compositionStates[composition->_uniqueID];
+  // Added and removed children damage their own bounds, but a reorder leaves every child unchanged
+  // while the overlapping areas are drawn differently, so the whole composition is damaged.
+  if (state.updateCount != 0 && IsReordered(state.childIDs, childIDs)) {
+    auto bounds = tgfx::Rect::MakeWH(stageWidth, stageHeight);
+    if (composition->_parent != nullptr) {
+      composition->measureBounds(&bounds);
+      matrix.mapRect(&bounds);
+    }
+    addDamage(bounds);
+  }
+  state.childIDs = std::move(childIDs);
+  state.updateCount = updateCount;
+}
+
+void DamageTracker::visitLayer(PAGLayer* pagLayer, const tgfx::Matrix& parentMatrix, float alpha) {
+  auto layerCache = pagLayer->layerCache;
+  if (!layerCache->contentVisible(pagLayer->contentFrame)) {
+    return;
+  }
+  if (CanTrackChildren(pagLayer)) {
+    auto transform = layerCache->getTransform(pagLayer->contentFrame);
+    auto matrix = ToTGFX(pagLayer->getTotalMatrixInternal());
+    matrix.postConcat(parentMatrix);
+    auto childAlpha = alpha * transform->alpha * pagLayer->layerAlpha;
+    visitComposition(static_cast<PAGComposition*>(pagLayer), matrix, childAlpha);
+    return;
+  }
+  auto matrix = ToTGFX(pagLayer->layerMatrix);
+  matrix.postConcat(parentMatrix);
+  auto layerAlpha = alpha * pagLayer->layerAlpha;
+  auto trackMatteLayer = pagLayer->_trackMatteLayer.get();
+  auto& state = layerStates[pagLayer->_uniqueID];
+  auto isNew = state.updateCount == 0 || state.layer != pagLayer;
+  auto changed = isNew || state.contentVersion != pagLayer->contentVersion ||
+                 layerCache->checkFrameChanged(pagLayer->contentFrame, state.contentFrame) ||
+                 state.matrix != matrix || state.alpha != layerAlpha ||
+                 state.trackMatteLayer != trackMatteLayer;
+  if (!changed && trackMatteLayer != nullptr) {
+    changed = state.trackMatteVersion != trackMatteLayer->contentVersion ||
+              trackMatteLayer->layerCache->checkFrameChanged(trackMatteLayer->contentFrame,
+                                                             state.trackMatteFrame);
+  }
+  state.updateCount = updateCount;
+  if (!changed) {
+    return;
+  }
+  if (!isNew) {
+    addDamage(state.bounds);
+  }
+  tgfx::Rect bounds = {};
+  PAGComposition::MeasureChildLayer(&bounds, pagLayer);
+  parentMatrix.mapRect(&bounds);
+  addDamage(bounds);
+  state.layer = pagLayer;
+  state.contentFrame = pagLayer->contentFrame;
+  state.contentVersion = pagLayer->contentVersion;
+  state.trackMatteLayer = trackMatteLayer;
+  if (trackMatteLayer != nullptr) {
+    state.trackMatteFrame = trackMatteLayer->contentFrame;
+    state.trackMatteVersion = trackMatteLayer->contentVersion;
+  }
+  state.matrix = matrix;
+  state.alpha = layerAlpha;
+  state.bounds = bounds;
+}
+
+void DamageTracker::addDamage(const tgfx::Rect& bounds) {
+  if (fullDamage) {
+    return;
+  }
+  auto rect = bounds;
+  rect.roundOut();
+  if (!rect.intersect(tgfx::Rect::MakeWH(stageWidth, stageHeight))) {
+    return;
+  }
+  // Merges the rect with every existing rect it overlaps, until it overlaps none of them.
+  auto merged = true;
+  while (merged) {
+    merged = false;
+    for (auto iter = rects.begin(); iter != rects.end(); iter++) {
+      if (iter->intersects(rect)) {
+        rect.join(*iter);
+        rects.erase(iter);
+        merged = true;
+        break;
+      }
+    }
+  }
+  rects.push_back(rect);
+  if (rects.size() > MAX_DAMAGE_RECTS) {
+    auto unionRect = rects[0];
+    for (auto& item : rects) {
+      unionRect.join(item);
+    }
+    rects = {unionRect};
+  }
+}
+}  // namespace pag
@@ -0,0 +1,98 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "pag/pag.h"
+#include "tgfx/core/Matrix.h"
+#include "tgfx/core/Rect.h"
+
+namespace pag {
+/**
+ * DamageTracker compares the layers under a PAGStage with their states in the previous frame and
+ * collects the areas of the stage that have changed. Layers inside plain compositions are tracked
+ * one by one, while compositions that render their children as a group (masks, effects, layer
+ * styles, track mattes, blend modes, etc.) are tracked as a whole.
+ */
+class DamageTracker {
+ public:
+  /**
+   * Updates the layer states with the current frame of the stage and recomputes the damaged areas.
+   */
+  void update(PAGStage* stage);
+
+  /**
+   * Marks the whole stage damaged in the next update, e.g. when the render settings have changed.
+   */
+  void invalidate() {
+    invalidated = true;
+  }
+
+  /**
+   * Returns true if the whole stage was damaged in the last update.
+   */
+  bool isFullDamage() const {
+    return fullDamage;
+  }
+
+  /**
+   * Returns the damaged areas of the last update in the stage coordinates. The rects are rounded
+   * out to integers and clipped to the stage bounds. It is meaningless if isFullDamage() is true.
+   */
+  const std::vector<tgfx::Rect>& damageRects() const {
+    return rects;
+  }
+
+ private:
+  struct LayerState {
+    PAGLayer* layer = nullptr;
+    Frame contentFrame = 0;
+    uint32_t contentVersion = 0;
+    PAGLayer* trackMatteLayer = nullptr;
+    Frame trackMatteFrame = 0;
+    uint32_t trackMatteVersion = 0;
+    tgfx::Matrix matrix = {};
+    float alpha = 1.0f;
+    tgfx::Rect bounds = {};
+    uint32_t updateCount = 0;
+  };
+
+  struct CompositionState {
+    // The visible children in drawing order, reordering them changes the overlapping areas.
+    std::vector<ID> childIDs = {};
+    uint32_t updateCount = 0;
+  };
+
+  std::unordered_map<ID, LayerState> layerStates = {};
+  std::unordered_map<ID, CompositionState> compositionStates = {};
+  std::vector<tgfx::Rect> rects = {};
+  bool invalidated = true;
+  bool fullDamage = true;
+  uint32_t updateCount = 0;
+  int stageWidth = 0;
+  int stageHeight = 0;
+
+  static bool CanTrackChildren(PAGLayer* pagLayer);
+
+  void visitComposition(PAGComposition* composition, const tgfx::Matrix& matrix, float alpha);
+  void visitLayer(PAGLayer* pagLayer, const tgfx::Matrix& parentMatrix, float alpha);
+  void addDamage(const tgfx::Rect& bounds);
+};
+}  // namespace pag
@@ -179,6 +179,17 @@ std::vector<int64_t> MemoryCalculator::GetRootLayerGraphicsMemoriesPreFrame(
   return memoriesPreFrame;
 }
 
+size_t MemoryCalculator::GetPathMemory(const tgfx::Path& path) {
+  // Every point comes with at most one verb, plus the fixed size of the path object itself.
+  auto pointCount = static_cast<size_t>(path.countPoints());
+  return sizeof(tgfx::Path) + pointCount * (sizeof(tgfx::Point) + sizeof(uint8_t));
+}
+
+size_t MemoryCalculator::GetPathDataMemory(const PathData& pathData) {
+  return sizeof(PathData) + pathData.verbs.capacity() * sizeof(PathDataVerb) +
+         pathData.points.capacity() * sizeof(Point);
+}
+
 bool MemoryCalculator::UpdateMaxScaleMapIfNeed(
     void* resource, tgfx::Point currentScale,
     std::unordered_map<void*, tgfx::Point>& resourcesMaxScaleMap) {
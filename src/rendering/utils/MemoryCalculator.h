@@ -21,6 +21,7 @@
 #include <unordered_set>
 #include "pag/file.h"
 #include "pag/pag.h"
+#include "tgfx/core/Path.h"
 #include "tgfx/core/Point.h"
 
 namespace pag {
@@ -34,6 +35,16 @@ class MemoryCalculator {
       PreComposeLayer* rootLayer, std::unordered_map<void*, tgfx::Point>& resourcesScaleMap,
       std::unordered_map<void*, std::vector<TimeRange>*>& resourcesTimeRangesMap);
 
+  /**
+   * Returns the estimated memory in bytes used by the points and verbs of the specified path.
+   */
+  static size_t GetPathMemory(const tgfx::Path& path);
+
+  /**
+   * Returns the memory in bytes used by the verbs and points of the specified path data.
+   */
+  static size_t GetPathDataMemory(const PathData& pathData);
+
  private:
   static void FillBitmapGraphicsMemories(
       Composition* composition, std::unordered_map<void*, tgfx::Point>& resourcesScaleMap,
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TextShaper.h"
+#include "base/utils/Tracer.h"
 #ifdef PAG_USE_HARFBUZZ
 #include "TextShaperHarfbuzz.h"
 #else
@@ -30,6 +31,7 @@ std::vector<ShapedGlyph> TextShaper::Shape(const std::string& text,
   if (text.empty()) {
     return {};
   }
+  TRACE_SCOPE("TextShaper::Shape");
 #ifdef PAG_USE_HARFBUZZ
   return TextShaperHarfbuzz::Shape(text, std::move(typeface));
 #else
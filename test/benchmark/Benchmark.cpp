@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace pag {
+static int64_t Percentile(const std::vector<int64_t>& sortedSamples, double percent) {
+  if (sortedSamples.empty()) {
+    return 0;
+  }
+  // Nearest-rank method, which always returns an actual sample.
+  auto rank = static_cast<size_t>(std::ceil(percent * static_cast<double>(sortedSamples.size())));
+  rank = std::clamp(rank, static_cast<size_t>(1), sortedSamples.size());
+  return sortedSamples[rank - 1];
+}
+
+void BenchmarkContext::record(const std::string& stage, int64_t microseconds) {
+  auto key = file.empty() ? stage : stage + ":" + file;
+  samples[key].push_back(microseconds);
+}
+
+void BenchmarkContext::measure(const std::string& stage, const std::function<void()>& func) {
+  auto startTime = tgfx::Clock::Now();
+  func();
+  record(stage, tgfx::Clock::Now() - startTime);
+}
+
+std::unordered_map<std::string, StageStats> BenchmarkContext::stats() const {
+  std::unordered_map<std::string, StageStats> result = {};
+  for (auto& item : samples) {
+    auto sortedSamples = item.second;
+    std::sort(sortedSamples.begin(), sortedSamples.end());
+    StageStats stageStats = {};
+    stageStats.samples = sortedSamples.size();
+    stageStats.p50 = Percentile(sortedSamples, 0.5);
+    stageStats.p95 = Percentile(sortedSamples, 0.95);
+    stageStats.p99 = Percentile(sortedSamples, 0.99);
+    result[item.first] = stageStats;
+  }
+  return result;
+}
+
+static std::map<std::string, BenchmarkFunc>& GetBenchmarks() {
+  static auto& benchmarks = *new std::map<std::string, BenchmarkFunc>();
+  return benchmarks;
+}
+
+bool BenchmarkRegistry::Register(const std::string& name, BenchmarkFunc func) {
+  GetBenchmarks()[name] = func;
+  return true;
+}
+
+void BenchmarkRegistry::RunAll(BenchmarkContext* context, const std::string& filter) {
+  for (auto& item : GetBenchmarks()) {
+    if (item.first.compare(0, filter.size(), filter) != 0) {
+      continue;
+    }
+    printf("[ RUN      ] %s\n", item.first.c_str());
+    auto startTime = tgfx::Clock::Now();
+    item.second(context);
+    auto duration = (tgfx::Clock::Now() - startTime) / 1000;
+    printf("[     DONE ] %s (%lld ms)\n", item.first.c_str(), static_cast<long long>(duration));
+  }
+}
+}  // namespace pag
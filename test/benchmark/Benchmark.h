@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+/**
+ * Percentile statistics of one benchmark stage, in microseconds.
+ */
+struct StageStats {
+  size_t samples = 0;
+  int64_t p50 = 0;
+  int64_t p95 = 0;
+  int64_t p99 = 0;
+};
+
+/**
+ * BenchmarkContext collects the timing samples of all stages measured by the registered
+ * benchmarks.
+ */
+class BenchmarkContext {
+ public:
+  /**
+   * The number of measured iterations each benchmark should run for every stage.
+   */
+  int iterations = 10;
+
+  /**
+   * Input files passed on the command line. Benchmarks fall back to their built-in corpus if it is
+   * empty.
+   */
+  std::vector<std::string> files = {};
+
+  /**
+   * The file being measured, relative to the project root. Samples are bucketed by file and stage,
+   * so every file of the corpus gets its own percentiles instead of being mixed with the others.
+   * Leave it empty for benchmarks that do not measure files.
+   */
+  std::string file = {};
+
+  /**
+   * Records one timing sample of the specified stage for the current file, in microseconds.
+   */
+  void record(const std::string& stage, int64_t microseconds);
+
+  /**
+   * Runs the function and records its execution time as one sample of the specified stage.
+   */
+  void measure(const std::string& stage, const std::function<void()>& func);
+
+  /**
+   * Returns the percentile statistics of all stages recorded so far, keyed by "stage:file", or by
+   * the stage alone for samples recorded without a file.
+   */
+  std::unordered_map<std::string, StageStats> stats() const;
+
+ private:
+  std::unordered_map<std::string, std::vector<int64_t>> samples = {};
+};
+
+using BenchmarkFunc = void (*)(BenchmarkContext* context);
+
+class BenchmarkRegistry {
+ public:
+  /**
+   * Registers a benchmark. Benchmarks run in the order of their names.
+   */
+  static bool Register(const std::string& name, BenchmarkFunc func);
+
+  /**
+   * Runs all registered benchmarks whose names start with the specified filter.
+   */
+  static void RunAll(BenchmarkContext* context, const std::string& filter = "");
+};
+
+#define PAG_BENCHMARK(name)                                      \
+  static void Benchmark_##name(pag::BenchmarkContext* context);  \
+  static const bool Benchmark_##name##_Registered =              \
+      pag::BenchmarkRegistry::Register(#name, Benchmark_##name); \
+  static void Benchmark_##name(pag::BenchmarkContext* context)
+}  // namespace pag
@@ -0,0 +1,197 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "Benchmark.h"
+#include "ffavc.h"
+#include "pag/pag.h"
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-warning-option"
+#pragma clang diagnostic ignored "-Wdeprecated-literal-operator"
+#include "nlohmann/json.hpp"
+#pragma clang diagnostic pop
+#include "utils/ProjectPath.h"
+
+using nlohmann::json;
+
+namespace pag {
+// Differences below this value are treated as noise, no matter how large the ratio is.
+static constexpr int64_t MIN_REGRESSION_TIME = 500;  // 0.5ms
+
+struct BenchmarkOptions {
+  std::string outputPath = "";
+  std::string baselinePath = "";
+  std::string filter = "";
+  bool updateBaseline = false;
+  bool allowMissing = false;
+  double tolerance = 0.25;
+};
+
+static void PrintUsage() {
+  std::cout << "Usage: PAGBenchmark [options] [files...]\n"
+            << "  --iterations <n>     measured iterations per stage, default 10\n"
+            << "  --filter <prefix>    only runs the benchmarks whose names start with prefix\n"
+            << "  --output <path>      writes the JSON report to path instead of stdout\n"
+            << "  --baseline <path>    baseline to compare with, default "
+               "test/baseline/benchmark.json\n"
+            << "  --tolerance <ratio>  allowed slowdown before failing, default 0.25\n"
+            << "  --update-baseline    saves the current results as the new baseline\n"
+            << "  --allow-missing      passes even if the baseline or some of its stages are\n"
+            << "                       missing, e.g. for runs narrowed by --filter\n";
+}
+
+static bool ParseArguments(int argc, char** argv, BenchmarkContext* context,
+                           BenchmarkOptions* options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto hasValue = i + 1 < argc;
+    if (arg == "--iterations" && hasValue) {
+      context->iterations = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--filter" && hasValue) {
+      options->filter = argv[++i];
+    } else if (arg == "--output" && hasValue) {
+      options->outputPath = argv[++i];
+    } else if (arg == "--baseline" && hasValue) {
+      options->baselinePath = argv[++i];
+    } else if (arg == "--tolerance" && hasValue) {
+      options->tolerance = atof(argv[++i]);
+    } else if (arg == "--update-baseline") {
+      options->updateBaseline = true;
+    } else if (arg == "--allow-missing") {
+      options->allowMissing = true;
+    } else if (arg.compare(0, 2, "--") == 0) {
+      return false;
+    } else {
+      context->files.push_back(ProjectPath::Absolute(arg));
+    }
+  }
+  if (options->baselinePath.empty()) {
+    options->baselinePath = ProjectPath::Absolute("test/baseline/benchmark.json");
+  }
+  return true;
+}
+
+static json MakeReport(const std::unordered_map<std::string, StageStats>& stats) {
+  json stages = json::object();
+  for (auto& item : stats) {
+    auto& stageStats = item.second;
+    stages[item.first] = {{"samples", stageStats.samples},
+                          {"p50", stageStats.p50},
+                          {"p95", stageStats.p95},
+                          {"p99", stageStats.p99}};
+  }
+  return {{"unit", "us"}, {"stages", stages}};
+}
+
+static bool WriteJSON(const json& value, const std::string& path) {
+  auto parentPath = std::filesystem::path(path).parent_path();
+  if (!parentPath.empty()) {
+    std::filesystem::create_directories(parentPath);
+  }
+  std::ofstream file(path);
+  if (!file) {
+    return false;
+  }
+  file << value.dump(2) << std::endl;
+  return true;
+}
+
+static int CompareWithBaseline(const json& report, const BenchmarkOptions& options) {
+  std::ifstream file(options.baselinePath);
+  if (!file) {
+    std::cerr << "No baseline found at " << options.baselinePath
+              << ", run with --update-baseline to create one." << std::endl;
+    return options.allowMissing ? 0 : 1;
+  }
+  auto baseline = json::parse(file, nullptr, false);
+  if (baseline.is_discarded() || !baseline.contains("stages")) {
+    std::cerr << "Invalid baseline file: " << options.baselinePath << std::endl;
+    return 1;
+  }
+  int regressions = 0;
+  auto& stages = report["stages"];
+  for (auto& item : stages.items()) {
+    if (!baseline["stages"].contains(item.key())) {
+      std::cout << "NEW: " << item.key() << " is not in the baseline yet" << std::endl;
+    }
+  }
+  for (auto& item : baseline["stages"].items()) {
+    if (!stages.contains(item.key())) {
+      if (!options.allowMissing) {
+        std::cerr << "MISSING: " << item.key() << " is in the baseline but was not measured"
+                  << std::endl;
+        regressions++;
+      }
+      continue;
+    }
+    for (auto key : {"p50", "p95"}) {
+      auto expected = item.value()[key].get<int64_t>();
+      auto actual = stages[item.key()][key].get<int64_t>();
+      auto limit = static_cast<int64_t>(static_cast<double>(expected) * (1.0 + options.tolerance));
+      if (actual > limit && actual - expected > MIN_REGRESSION_TIME) {
+        std::cerr << "REGRESSION: " << item.key() << " " << key << " " << actual << "us > "
+                  << expected << "us (baseline)" << std::endl;
+        regressions++;
+      }
+    }
+  }
+  return regressions;
+}
+
+static void SetUpEnvironment() {
+  std::vector<std::string> fontPaths = {
+      ProjectPath::Absolute("resources/font/NotoSansSC-Regular.otf"),
+      ProjectPath::Absolute("resources/font/NotoColorEmoji.ttf")};
+  std::vector<int> ttcIndices = {0, 0};
+  PAGFont::SetFallbackFontPaths(fontPaths, ttcIndices);
+  auto factory = ffavc::DecoderFactory::GetHandle();
+  PAGVideoDecoder::RegisterSoftwareDecoderFactory(
+      reinterpret_cast<pag::SoftwareDecoderFactory*>(factory));
+}
+}  // namespace pag
+
+int main(int argc, char** argv) {
+  pag::BenchmarkContext context = {};
+  pag::BenchmarkOptions options = {};
+  if (!pag::ParseArguments(argc, argv, &context, &options)) {
+    pag::PrintUsage();
+    return 1;
+  }
+  pag::SetUpEnvironment();
+  pag::BenchmarkRegistry::RunAll(&context, options.filter);
+  auto report = pag::MakeReport(context.stats());
+  if (options.outputPath.empty()) {
+    std::cout << report.dump(2) << std::endl;
+  } else if (!pag::WriteJSON(report, options.outputPath)) {
+    std::cerr << "Failed to write the report to " << options.outputPath << std::endl;
+    return 1;
+  }
+  if (options.updateBaseline) {
+    if (!pag::WriteJSON(report, options.baselinePath)) {
+      std::cerr << "Failed to write the baseline to " << options.baselinePath << std::endl;
+      return 1;
+    }
+    std::cout << "Baseline updated: " << options.baselinePath << std::endl;
+    return 0;
+  }
+  auto regressions = pag::CompareWithBaseline(report, options);
+  return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,215 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "Benchmark.h"
+#include "pag/pag.h"
+#include "pagx/PAGScene.h"
+#include "pagx/PAGSurface.h"
+#include "pagx/PAGXDocument.h"
+#include "pagx/PAGXImporter.h"
+#include "utils/ProjectPath.h"
+
+namespace pag {
+// The maximum number of frames measured per file for the per-frame stages.
+static constexpr int MAX_MEASURED_FRAMES = 60;
+
+static const std::vector<std::string> PAGCorpus = {
+    "resources/apitest/complex_test.pag",  "resources/apitest/ZC2.pag",
+    "resources/apitest/test_repeat.pag",   "resources/apitest/TEXT04.pag",
+    "resources/apitest/wz_mvp.pag",        "resources/apitest/video_sequence_test.pag",
+    "resources/apitest/BitmapComp.pag",    "resources/filter/Glow.pag",
+    "resources/filter/DropShadow.pag",     "resources/filter/MotionBlur.pag"};
+
+static const std::vector<std::string> PAGXCorpus = {
+    "resources/apitest/api_consistency.pagx", "resources/text/box_layout.pagx",
+    "resources/text/line_break.pagx", "resources/layout/constraint_group.pagx",
+    "resources/pagx_to_html/layer_blend_modes.pagx"};
+
+static std::vector<std::string> GetCorpus(BenchmarkContext* context,
+                                          const std::vector<std::string>& defaultCorpus,
+                                          const std::string& extension) {
+  std::vector<std::string> result = {};
+  if (context->files.empty()) {
+    for (auto& path : defaultCorpus) {
+      result.push_back(ProjectPath::Absolute(path));
+    }
+    return result;
+  }
+  for (auto& path : context->files) {
+    if (path.size() > extension.size() &&
+        path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+      result.push_back(path);
+    }
+  }
+  return result;
+}
+
+// Returns the path relative to the project root, so baselines do not depend on the checkout path.
+static std::string GetFileKey(const std::string& path) {
+  auto root = std::filesystem::path(ProjectPath::Absolute("")).lexically_normal();
+  auto relativePath = std::filesystem::path(path).lexically_normal().lexically_relative(root);
+  if (relativePath.empty() || *relativePath.begin() == "..") {
+    return path;
+  }
+  return relativePath.generic_string();
+}
+
+static std::vector<uint8_t> ReadBytes(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+static std::shared_ptr<PAGFile> LoadFromBytes(const std::vector<uint8_t>& bytes) {
+  // Loads without a path, so the weak file cache in File::Load never returns a previous result.
+  return PAGFile::Load(bytes.data(), bytes.size());
+}
+
+static void MeasurePAGFile(BenchmarkContext* context, const std::string& path) {
+  auto bytes = ReadBytes(path);
+  auto pagFile = LoadFromBytes(bytes);
+  if (pagFile == nullptr) {
+    printf("Failed to load: %s\n", path.c_str());
+    return;
+  }
+  // Warms up the process-wide caches (fonts, shaders, codecs) once before measuring.
+  auto warmUpSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  if (warmUpSurface == nullptr) {
+    printf("Failed to create an offscreen surface for: %s\n", path.c_str());
+    return;
+  }
+  auto warmUpPlayer = std::make_shared<PAGPlayer>();
+  warmUpPlayer->setSurface(warmUpSurface);
+  warmUpPlayer->setComposition(pagFile);
+  warmUpPlayer->flush();
+
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pag/load", [&]() { pagFile = LoadFromBytes(bytes); });
+  }
+
+  for (int i = 0; i < context->iterations; i++) {
+    auto file = LoadFromBytes(bytes);
+    auto surface = PAGSurface::MakeOffscreen(file->width(), file->height());
+    auto player = std::make_shared<PAGPlayer>();
+    player->setSurface(surface);
+    context->measure("pag/first_frame", [&]() {
+      player->setComposition(file);
+      player->flush();
+    });
+  }
+
+  auto surface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto player = std::make_shared<PAGPlayer>();
+  player->setSurface(surface);
+  player->setComposition(pagFile);
+  player->flush();
+  auto numFrames = static_cast<int>(
+      std::round(static_cast<double>(pagFile->duration()) * pagFile->frameRate() / 1000000.0));
+  auto measuredFrames = std::clamp(numFrames, 1, MAX_MEASURED_FRAMES);
+  for (int i = 0; i < context->iterations; i++) {
+    for (int frame = 0; frame < measuredFrames; frame++) {
+      player->setProgress(static_cast<double>(frame) / measuredFrames);
+      context->measure("pag/flush", [&]() { player->flush(); });
+    }
+  }
+
+  auto decoderFile = LoadFromBytes(bytes);
+  auto decoder = PAGDecoder::MakeFrom(decoderFile);
+  if (decoder == nullptr) {
+    return;
+  }
+  auto rowBytes = static_cast<size_t>(decoder->width()) * 4;
+  std::vector<uint8_t> pixels(rowBytes * static_cast<size_t>(decoder->height()));
+  auto decodedFrames = std::min(decoder->numFrames(), MAX_MEASURED_FRAMES);
+  for (int frame = 0; frame < decodedFrames; frame++) {
+    context->measure("pag/decoder", [&]() { decoder->readFrame(frame, pixels.data(), rowBytes); });
+  }
+
+  // Compares the throughput of decoding uncached frames one by one and through the readback
+  // pipeline. Files loaded without a path get a fresh temporary sequence file for each decoder.
+  for (int i = 0; i < context->iterations; i++) {
+    auto serialDecoder = PAGDecoder::MakeFrom(LoadFromBytes(bytes));
+    context->measure("pag/decoder_serial", [&]() {
+      for (int frame = 0; frame < decodedFrames; frame++) {
+        serialDecoder->readFrame(frame, pixels.data(), rowBytes);
+      }
+    });
+    auto pipelinedDecoder = PAGDecoder::MakeFrom(LoadFromBytes(bytes));
+    context->measure("pag/decoder_pipelined", [&]() {
+      pipelinedDecoder->readFrames(0, decodedFrames, [](int, const void*, size_t) { return true; });
+    });
+  }
+}
+
+static void MeasurePAGXFile(BenchmarkContext* context, const std::string& path) {
+  auto bytes = ReadBytes(path);
+  auto document = pagx::PAGXImporter::FromXML(bytes.data(), bytes.size());
+  if (document == nullptr) {
+    printf("Failed to import: %s\n", path.c_str());
+    return;
+  }
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pagx/import", [&]() {
+      document = pagx::PAGXImporter::FromXML(bytes.data(), bytes.size());
+    });
+  }
+
+  auto width = std::max(1, static_cast<int>(std::ceil(document->width)));
+  auto height = std::max(1, static_cast<int>(std::ceil(document->height)));
+  auto surface = pagx::PAGSurface::MakeOffscreen(width, height);
+  if (surface == nullptr) {
+    printf("Failed to create an offscreen surface for: %s\n", path.c_str());
+    return;
+  }
+  for (int i = 0; i < context->iterations; i++) {
+    auto newDocument = pagx::PAGXImporter::FromXML(bytes.data(), bytes.size());
+    context->measure("pagx/first_frame", [&]() {
+      auto scene = pagx::PAGScene::Make(newDocument);
+      scene->draw(surface);
+    });
+  }
+  auto scene = pagx::PAGScene::Make(document);
+  scene->draw(surface);
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pagx/frame", [&]() {
+      scene->advanceAndApply(16667);
+      scene->draw(surface);
+    });
+  }
+}
+
+PAG_BENCHMARK(PAGFile) {
+  for (auto& path : GetCorpus(context, PAGCorpus, ".pag")) {
+    context->file = GetFileKey(path);
+    MeasurePAGFile(context, path);
+  }
+  context->file = "";
+}
+
+PAG_BENCHMARK(PAGX) {
+  for (auto& path : GetCorpus(context, PAGXCorpus, ".pagx")) {
+    context->file = GetFileKey(path);
+    MeasurePAGXFile(context, path);
+  }
+  context->file = "";
+}
+}  // namespace pag
@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <string>
+#include "Benchmark.h"
+#include "pagx/PAGXDocument.h"
+#include "pagx/PAGXExporter.h"
+#include "pagx/PAGXImporter.h"
+#include "pagx/svg/SVGPathParser.h"
+
+namespace pag {
+// The shape of the synthetic document: PATH_COUNT paths of SEGMENT_COUNT cubic segments each.
+static constexpr int PATH_COUNT = 200;
+static constexpr int SEGMENT_COUNT = 250;
+
+static std::string MakePathData(std::mt19937* random) {
+  std::uniform_real_distribution<float> distribution(-2000.0f, 2000.0f);
+  std::string result = "M" + std::to_string(distribution(*random)) + " " +
+                       std::to_string(distribution(*random));
+  for (int i = 0; i < SEGMENT_COUNT; i++) {
+    result += " C";
+    for (int j = 0; j < 6; j++) {
+      result += " " + std::to_string(distribution(*random));
+    }
+  }
+  return result + " Z";
+}
+
+static std::string MakePathDocument() {
+  std::mt19937 random(20260101);
+  std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                    "<pagx width=\"4000\" height=\"4000\">\n  <Layer>\n";
+  for (int i = 0; i < PATH_COUNT; i++) {
+    xml += "    <Path data=\"" + MakePathData(&random) + "\"/>\n";
+  }
+  xml += "    <Fill color=\"#FF0000\"/>\n  </Layer>\n</pagx>\n";
+  return xml;
+}
+
+/**
+ * Measures number parsing and formatting on a document made of large path data, where the numeric
+ * codec dominates the import and export time.
+ */
+PAG_BENCHMARK(PAGXNumbers) {
+  auto xml = MakePathDocument();
+  auto document = pagx::PAGXImporter::FromXML(xml);
+  if (document == nullptr) {
+    printf("Failed to import the synthetic path document.\n");
+    return;
+  }
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pagx/path_import", [&]() { document = pagx::PAGXImporter::FromXML(xml); });
+  }
+  std::string output = {};
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pagx/path_export", [&]() { output = pagx::PAGXExporter::ToXML(*document); });
+  }
+
+  std::mt19937 random(20260102);
+  auto pathString = MakePathData(&random);
+  pagx::PathData pathData = {};
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pagx/path_data_parse",
+                     [&]() { pathData = pagx::PathDataFromSVGString(pathString); });
+  }
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("pagx/path_data_format",
+                     [&]() { pathString = pagx::PathDataToSVGString(pathData); });
+  }
+}
+}  // namespace pag
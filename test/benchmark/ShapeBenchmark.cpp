@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+#include "base/keyframes/SingleEaseKeyframe.h"
+#include "pag/file.h"
+#include "rendering/caches/ShapeContentCache.h"
+#include "rendering/renderers/ShapeRenderer.h"
+
+namespace pag {
+// The shape of the synthetic layer: GROUP_COUNT groups, each merging CIRCLE_COUNT circles with a
+// subtract operation and filled with a color animated over FRAME_COUNT frames.
+static constexpr int GROUP_COUNT = 20;
+static constexpr int CIRCLE_COUNT = 16;
+static constexpr Frame FRAME_COUNT = 60;
+
+static ShapeTransform* MakeShapeTransform(const Point& position) {
+  auto transform = new ShapeTransform();
+  transform->anchorPoint = new Property<Point>(Point::Zero());
+  transform->position = new Property<Point>(position);
+  transform->scale = new Property<Point>(Point::Make(1, 1));
+  transform->skew = new Property<float>(0);
+  transform->skewAxis = new Property<float>(0);
+  transform->rotation = new Property<float>(0);
+  transform->opacity = new Property<Opacity>(Opaque);
+  return transform;
+}
+
+static FillElement* MakeAnimatedFill() {
+  auto keyframe = new SingleEaseKeyframe<Color>();
+  keyframe->startTime = 0;
+  keyframe->endTime = FRAME_COUNT;
+  keyframe->startValue = Red;
+  keyframe->endValue = White;
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  auto fill = new FillElement();
+  fill->color = new AnimatableProperty<Color>({keyframe});
+  fill->opacity = new Property<Opacity>(Opaque);
+  return fill;
+}
+
+static std::unique_ptr<ShapeLayer> MakeShapeLayer() {
+  auto layer = new ShapeLayer();
+  layer->duration = FRAME_COUNT;
+  for (int i = 0; i < GROUP_COUNT; i++) {
+    auto group = new ShapeGroupElement();
+    group->transform = MakeShapeTransform(Point::Make((i % 5) * 200, (i / 5) * 200));
+    for (int j = 0; j < CIRCLE_COUNT; j++) {
+      auto ellipse = new EllipseElement();
+      auto size = static_cast<float>(200 - j * 10);
+      ellipse->size = new Property<Point>(Point::Make(size, size));
+      ellipse->position = new Property<Point>(Point::Make(j * 3, j * 2));
+      group->elements.push_back(ellipse);
+    }
+    auto mergePaths = new MergePathsElement();
+    mergePaths->mode = MergePathsMode::Subtract;
+    group->elements.push_back(mergePaths);
+    group->elements.push_back(MakeAnimatedFill());
+    layer->contents.push_back(group);
+  }
+  return std::unique_ptr<ShapeLayer>(layer);
+}
+
+/**
+ * Measures the shape contents of a layer whose fills are animated over complex merge paths, with
+ * and without reusing the shape geometry between frames.
+ */
+PAG_BENCHMARK(AnimatedFillShapes) {
+  auto layer = MakeShapeLayer();
+  for (int i = 0; i < context->iterations; i++) {
+    context->measure("shape/render_shapes", [&]() {
+      for (Frame frame = 0; frame < FRAME_COUNT; frame++) {
+        RenderShapes(layer->uniqueID, layer->contents, frame);
+      }
+    });
+    // Creates a new cache for every iteration, so that no frame is cached in advance.
+    ShapeContentCache contentCache(layer.get());
+    context->measure("shape/content_cache", [&]() {
+      for (Frame frame = 0; frame < FRAME_COUNT; frame++) {
+        contentCache.getCache(frame);
+      }
+    });
+  }
+}
+}  // namespace pag
@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+#include "base/keyframes/SingleEaseKeyframe.h"
+#include "pag/file.h"
+#include "rendering/caches/LayerCache.h"
+
+namespace pag {
+// The shape of the synthetic rig: a chain of PARENT_DEPTH null layers, with CHILD_COUNT children
+// attached to the deepest one, all animated over FRAME_COUNT frames.
+static constexpr int PARENT_DEPTH = 10;
+static constexpr int CHILD_COUNT = 500;
+static constexpr Frame FRAME_COUNT = 60;
+
+static Transform2D* MakeRotatingTransform(float degrees) {
+  auto transform = Transform2D::MakeDefault().release();
+  auto keyframe = new SingleEaseKeyframe<float>();
+  keyframe->startTime = 0;
+  keyframe->endTime = FRAME_COUNT;
+  keyframe->startValue = 0;
+  keyframe->endValue = degrees;
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  delete transform->rotation;
+  transform->rotation = new AnimatableProperty<float>({keyframe});
+  return transform;
+}
+
+static std::vector<std::unique_ptr<Layer>> MakeParentRig() {
+  std::vector<std::unique_ptr<Layer>> layers = {};
+  Layer* parent = nullptr;
+  for (int i = 0; i < PARENT_DEPTH + CHILD_COUNT; i++) {
+    auto layer = new NullLayer();
+    layer->id = static_cast<ID>(i + 1);
+    layer->duration = FRAME_COUNT;
+    layer->transform = MakeRotatingTransform(static_cast<float>(i % 90));
+    layer->parent = parent;
+    if (i < PARENT_DEPTH) {
+      parent = layer;
+    }
+    layers.emplace_back(layer);
+  }
+  return layers;
+}
+
+/**
+ * Measures the transform evaluation of a deep parent rig, where every child shares the same chain
+ * of animated parents.
+ */
+PAG_BENCHMARK(ParentTransforms) {
+  for (int i = 0; i < context->iterations; i++) {
+    // Creates a new rig for every iteration, so that no transform is cached in advance.
+    auto layers = MakeParentRig();
+    context->measure("transform/parent_rig", [&]() {
+      for (Frame frame = 0; frame < FRAME_COUNT; frame++) {
+        for (size_t index = PARENT_DEPTH; index < layers.size(); index++) {
+          LayerCache::Get(layers[index].get())->getTransform(frame);
+        }
+      }
+    });
+  }
+}
+}  // namespace pag
@@ -0,0 +1,70 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+#include "base/utils/BezierEasing.h"
+#include "utils/TestUtils.h"
+
+namespace pag {
+/**
+ * 用例描述: BezierEasing 的插值结果与 BezierPath 的采样结果保持一致，不改变已有动画的渲染结果
+ */
+PAG_TEST(BezierEasingTest, MatchesBezierPath) {
+  std::vector<std::pair<Point, Point>> controlPoints = {
+      {Point::Make(1.0f, 0.0f), Point::Make(0.0f, 1.0f)},
+      {Point::Make(0.0f, 1.0f), Point::Make(1.0f, 0.0f)},
+      {Point::Make(0.42f, 0.0f), Point::Make(0.58f, 1.0f)},
+      {Point::Make(0.33f, 0.0f), Point::Make(0.67f, 1.0f)}};
+  for (auto& item : controlPoints) {
+    BezierEasing easing(item.first, item.second);
+    auto bezierPath =
+        BezierPath::Build(Point::Zero(), item.first, item.second, Point::Make(1, 1), 0.005f);
+    for (int i = 1; i < 100; i++) {
+      auto x = static_cast<float>(i) / 100;
+      EXPECT_EQ(easing.getInterpolation(x), bezierPath->getY(x));
+    }
+  }
+}
+
+/**
+ * 用例描述: 多线程同时构建相同的曲线时共享同一份缓存，释放后缓存项随之失效
+ */
+PAG_TEST(BezierEasingTest, SharedBezierPath) {
+  auto control1 = Point::Make(0.25f, 0.1f);
+  auto control2 = Point::Make(0.25f, 1.0f);
+  std::vector<std::shared_ptr<BezierPath>> paths(8);
+  std::vector<std::thread> threads = {};
+  for (size_t i = 0; i < paths.size(); i++) {
+    threads.emplace_back([&paths, i, control1, control2]() {
+      paths[i] = BezierPath::Build(Point::Zero(), control1, control2, Point::Make(1, 1), 0.005f);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& path : paths) {
+    ASSERT_TRUE(path != nullptr);
+    EXPECT_EQ(path, paths[0]);
+  }
+  std::weak_ptr<BezierPath> weakPath = paths[0];
+  paths.clear();
+  EXPECT_TRUE(weakPath.expired());
+  auto path = BezierPath::Build(Point::Zero(), control1, control2, Point::Make(1, 1), 0.005f);
+  EXPECT_TRUE(path != nullptr);
+}
+}  // namespace pag
@@ -16,10 +16,13 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <filesystem>
+#include <future>
 #include "pag/pag.h"
 #include "platform/Platform.h"
 #include "rendering/caches/DiskCache.h"
+#include "rendering/caches/DiskIOWorker.h"
 #include "rendering/utils/BitmapBuffer.h"
 #include "rendering/utils/Directory.h"
 #include "utils/TestUtils.h"
@@ -352,6 +355,53 @@ PAG_TEST(PAGDiskCacheTest, PAGDecoder) {
   pag::PAGDiskCache::RemoveAll();
 }
 
+/**
+ * 用例描述: PAGDecoder::readFrames() 流水线读取的像素与逐帧 readFrame() 的结果完全一致。
+ */
+PAG_TEST(PAGDiskCacheTest, PAGDecoderReadFrames) {
+  pag::PAGDiskCache::RemoveAll();
+  auto pagFile = LoadPAGFile("resources/apitest/ZC2.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  auto decoder = PAGDecoder::MakeFrom(pagFile, 30, 0.5f);
+  ASSERT_TRUE(decoder != nullptr);
+  auto numFrames = decoder->numFrames();
+  auto rowBytes = static_cast<size_t>(decoder->width()) * 4;
+  auto byteSize = rowBytes * static_cast<size_t>(decoder->height());
+  std::vector<std::vector<uint8_t>> expectedFrames = {};
+  for (int i = 0; i < numFrames; i++) {
+    std::vector<uint8_t> pixels(byteSize);
+    EXPECT_TRUE(decoder->readFrame(i, pixels.data(), rowBytes));
+    expectedFrames.push_back(std::move(pixels));
+  }
+  decoder = nullptr;
+  pag::PAGDiskCache::RemoveAll();
+
+  pagFile = LoadPAGFile("resources/apitest/ZC2.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  decoder = PAGDecoder::MakeFrom(pagFile, 30, 0.5f);
+  ASSERT_TRUE(decoder != nullptr);
+  // Caches a few frames in the middle, so readFrames() has to mix cached and rendered frames.
+  std::vector<uint8_t> pixels(byteSize);
+  EXPECT_TRUE(decoder->readFrame(5, pixels.data(), rowBytes));
+  EXPECT_TRUE(decoder->readFrame(6, pixels.data(), rowBytes));
+  int nextIndex = 0;
+  auto count = decoder->readFrames(0, numFrames, [&](int index, const void* data, size_t bytes) {
+    EXPECT_EQ(index, nextIndex++);
+    EXPECT_EQ(bytes, rowBytes);
+    EXPECT_EQ(memcmp(data, expectedFrames[index].data(), byteSize), 0);
+    return true;
+  });
+  EXPECT_EQ(count, numFrames);
+  EXPECT_TRUE(decoder->sequenceFile->isComplete());
+  EXPECT_TRUE(decoder->reader == nullptr);
+
+  count = decoder->readFrames(numFrames - 3, 10, [&](int, const void*, size_t) { return false; });
+  EXPECT_EQ(count, 1);
+  count = decoder->readFrames(-1, 10, [&](int, const void*, size_t) { return true; });
+  EXPECT_EQ(count, 0);
+  pag::PAGDiskCache::RemoveAll();
+}
+
 PAG_TEST(PAGDiskCacheTest, PAGDecoder_StaticTimeRanges) {
   pag::PAGDiskCache::RemoveAll();
   auto pagFile = LoadPAGFile("resources/apitest/polygon.pag");
@@ -438,6 +488,61 @@ PAG_TEST(PAGDiskCacheTest, FileCache) {
   pag::PAGDiskCache::RemoveAll();
 }
 
+/**
+ * 用例描述: 磁盘缓存索引以追加日志的方式写入，日志在记录中间被截断后，重启时能恢复截断前的所有记录。
+ */
+PAG_TEST(PAGDiskCacheTest, JournalRecovery) {
+  auto cacheDir = Platform::Current()->getCacheDir() + "/journal";
+  std::filesystem::remove_all(cacheDir);
+  auto configPath = cacheDir + "/cache.cfg";
+  auto journalPath = cacheDir + "/cache.journal";
+  auto data1 = ReadFile("resources/apitest/polygon.pag");
+  auto data2 = ReadFile("resources/apitest/ellipse.pag");
+  auto data3 = ReadFile("resources/apitest/poly_star.pag");
+  ASSERT_TRUE(data1 != nullptr && data2 != nullptr && data3 != nullptr);
+
+  auto diskCache = std::make_unique<DiskCache>(cacheDir);
+  EXPECT_TRUE(diskCache->writeFile("key1", data1));
+  EXPECT_TRUE(diskCache->writeFile("key2", data2));
+  EXPECT_TRUE(diskCache->writeFile("key3", data3));
+  DiskIOWorker::GetInstance()->waitAll();
+  // Only the journal is written, each record costs the same regardless of the number of entries.
+  EXPECT_FALSE(std::filesystem::exists(configPath));
+  auto journalSize = std::filesystem::file_size(journalPath);
+  EXPECT_TRUE(diskCache->writeFile("key1", data1));
+  DiskIOWorker::GetInstance()->waitAll();
+  auto touchRecordSize = std::filesystem::file_size(journalPath) - journalSize;
+  EXPECT_EQ(touchRecordSize, 13u);
+  diskCache = nullptr;
+
+  // Cut the last record (the touch of key1) and the tail of the add record of key3.
+  std::filesystem::resize_file(journalPath, journalSize - 3);
+  diskCache = std::make_unique<DiskCache>(cacheDir);
+  DiskIOWorker::GetInstance()->waitAll();
+  EXPECT_EQ(diskCache->cachedFiles.size(), 2u);
+  EXPECT_EQ(diskCache->totalDiskSize, data1->size() + data2->size());
+  EXPECT_EQ(diskCache->cachedFiles.front()->cacheKey, "key2");
+  auto cacheData = diskCache->readFile("key1");
+  ASSERT_TRUE(cacheData != nullptr);
+  EXPECT_EQ(cacheData->size(), data1->size());
+  EXPECT_TRUE(memcmp(data1->bytes(), cacheData->bytes(), data1->size()) == 0);
+  EXPECT_TRUE(diskCache->readFile("key3") == nullptr);
+  // The replayed journal is compacted into the config.
+  EXPECT_FALSE(std::filesystem::exists(journalPath));
+  EXPECT_TRUE(std::filesystem::exists(configPath));
+  diskCache = nullptr;
+
+  diskCache = std::make_unique<DiskCache>(cacheDir);
+  DiskIOWorker::GetInstance()->waitAll();
+  EXPECT_EQ(diskCache->cachedFiles.size(), 2u);
+  EXPECT_EQ(diskCache->totalDiskSize, data1->size() + data2->size());
+  EXPECT_EQ(diskCache->fileIDCount, 3u);
+  diskCache->removeAll();
+  DiskIOWorker::GetInstance()->waitAll();
+  diskCache = nullptr;
+  std::filesystem::remove_all(cacheDir);
+}
+
 /**
  * Tests for DiskIOWorker: serial execution order and waitAll behavior.
  */
@@ -493,4 +598,64 @@ PAG_TEST(PAGDiskCacheTest, DiskIOWorker) {
   EXPECT_EQ(counter.load(), 100);
 }
 
+/**
+ * 用例描述: DiskIOWorker 按 key 合并仍在排队的任务，合并后的任务保持原来的排队位置；
+ * 析构时仍按提交顺序执行完所有排队的任务。
+ */
+PAG_TEST(PAGDiskCacheTest, DiskIOWorkerCoalescing) {
+  std::mutex orderMutex;
+  std::vector<std::string> order = {};
+  auto appendOrder = [&order, &orderMutex](const std::string& name) {
+    std::lock_guard<std::mutex> lock(orderMutex);
+    order.push_back(name);
+  };
+  std::promise<void> started;
+  std::promise<void> released;
+  auto releasedFuture = released.get_future().share();
+  {
+    DiskIOWorker worker;
+    // Blocks the worker thread, so the tasks below stay pending until released.
+    worker.submit([&started, releasedFuture]() {
+      started.set_value();
+      releasedFuture.wait();
+    });
+    started.get_future().wait();
+    std::atomic<int> value{0};
+    std::atomic<int> runs{0};
+    for (int i = 1; i <= 5; i++) {
+      worker.submit(
+          [i, &value, &runs, &appendOrder]() {
+            value = i;
+            runs++;
+            appendOrder("config");
+          },
+          "config");
+      if (i == 1) {
+        worker.submit([&appendOrder]() { appendOrder("other"); });
+      }
+    }
+    released.set_value();
+    worker.waitAll();
+    EXPECT_EQ(value.load(), 5);
+    EXPECT_EQ(runs.load(), 1);
+    std::vector<std::string> expectedOrder = {"config", "other"};
+    EXPECT_EQ(order, expectedOrder);
+
+    // The key can be submitted again once its task has started.
+    worker.submit([&appendOrder]() { appendOrder("config"); }, "config");
+    worker.waitAll();
+    EXPECT_EQ(order.size(), 3u);
+
+    order.clear();
+    for (int i = 0; i < 16; i++) {
+      worker.submit([i, &appendOrder]() { appendOrder(std::to_string(i)); });
+    }
+  }
+  // The tasks still pending at destruction are drained in the submitted order.
+  ASSERT_EQ(order.size(), 16u);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(order[static_cast<size_t>(i)], std::to_string(i));
+  }
+}
+
 }  // namespace pag
@@ -22,6 +22,7 @@
 #pragma clang diagnostic ignored "-Wdeprecated-literal-operator"
 #include "nlohmann/json.hpp"
 #pragma clang diagnostic pop
+#include "utils/Semaphore.h"
 #include "utils/TestUtils.h"
 
 #define PAG_COMPLEX_FILE_PATH TestConstants::PAG_ROOT + "resources/apitest/complex_test.pag"
@@ -722,4 +723,41 @@ PAG_TEST(PAGFileTest, EditableIndices) {
   ASSERT_EQ(editableTexts[1], static_cast<int>(0));
 }
 
+/**
+ * 用例描述: PAGFile::LoadAsync 批量异步加载，同路径并发加载只解码一次
+ */
+PAG_TEST(PAGFileTest, LoadAsync) {
+  std::vector<std::string> filePaths = {ProjectPath::Absolute("resources/apitest/test.pag"),
+                                        ProjectPath::Absolute("resources/apitest/TEXT04.pag"),
+                                        ProjectPath::Absolute("resources/apitest/test.pag"),
+                                        ProjectPath::Absolute("resources/apitest/not_exist.pag")};
+  std::vector<std::shared_ptr<PAGFile>> files = {};
+  Semaphore semaphore(0);
+  PAGFile::LoadAsync(
+      filePaths,
+      [&](std::vector<std::shared_ptr<PAGFile>> result) {
+        files = std::move(result);
+        semaphore.signal();
+      },
+      true);
+  semaphore.wait();
+  ASSERT_EQ(files.size(), filePaths.size());
+  ASSERT_NE(files[0], nullptr);
+  ASSERT_NE(files[1], nullptr);
+  ASSERT_NE(files[2], nullptr);
+  EXPECT_EQ(files[3], nullptr);
+  EXPECT_NE(files[0], files[2]);
+  EXPECT_EQ(files[0]->getFile(), files[2]->getFile());
+  EXPECT_EQ(files[0]->path(), filePaths[0]);
+  EXPECT_EQ(files[1]->path(), filePaths[1]);
+  EXPECT_EQ(PAGFile::Load(filePaths[1])->getFile(), files[1]->getFile());
+
+  auto pagSurface = OffscreenSurface::Make(files[1]->width(), files[1]->height());
+  ASSERT_NE(pagSurface, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(files[1]);
+  EXPECT_TRUE(pagPlayer->flush());
+}
+
 }  // namespace pag
@@ -16,6 +16,9 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include "base/utils/TimeUtil.h"
 #pragma clang diagnostic push
@@ -23,6 +26,7 @@
 #pragma clang diagnostic ignored "-Wdeprecated-literal-operator"
 #include "nlohmann/json.hpp"
 #pragma clang diagnostic pop
+#include "rendering/filters/utils/FilterHelper.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -100,6 +104,57 @@ PAG_TEST(PAGFilterTest, MotionBlur) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/MotionBlur_600000"));
 }
 
+/**
+ * 用例描述: 动画滤镜的结果缓存，循环播放时回到相同帧应直接复用缓存结果，图层离开舞台后释放缓存
+ */
+PAG_TEST(PAGFilterTest, FilterResultCache) {
+  auto pagFile = LoadPAGFile("resources/filter/MotionBlur.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  auto renderCache = pagPlayer->renderCache;
+  auto& filterResultCache = renderCache->filterResultCache;
+
+  pagFile->setCurrentTime(200000);
+  pagPlayer->flush();
+  auto firstSnapshot = MakeSnapshot(pagSurface);
+  pagFile->setCurrentTime(600000);
+  pagPlayer->flush();
+  auto memoryUsage = filterResultCache.memoryUsage();
+  EXPECT_GT(memoryUsage, 0u);
+  EXPECT_LE(memoryUsage, renderCache->filterResultMemoryBudget());
+  // The results are GPU textures counted by the context, so they stay out of memoryUsage().
+  EXPECT_EQ(renderCache->memoryUsage(), renderCache->graphicsMemory);
+  std::vector<std::shared_ptr<tgfx::Image>> cachedImages = {};
+  for (auto& entry : filterResultCache.entries) {
+    cachedImages.push_back(entry.result.image);
+  }
+
+  pagFile->setCurrentTime(200000);
+  pagPlayer->flush();
+  auto secondSnapshot = MakeSnapshot(pagSurface);
+  tgfx::Pixmap firstPixels(firstSnapshot);
+  tgfx::Pixmap secondPixels(secondSnapshot);
+  ASSERT_EQ(firstPixels.byteSize(), secondPixels.byteSize());
+  EXPECT_EQ(memcmp(firstPixels.pixels(), secondPixels.pixels(), firstPixels.byteSize()), 0);
+  EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/MotionBlur_200000"));
+  // A hit replays the cached image instead of adding a new one.
+  EXPECT_EQ(filterResultCache.memoryUsage(), memoryUsage);
+  ASSERT_EQ(filterResultCache.entries.size(), cachedImages.size());
+  for (auto& entry : filterResultCache.entries) {
+    EXPECT_TRUE(std::find(cachedImages.begin(), cachedImages.end(), entry.result.image) !=
+                cachedImages.end());
+  }
+
+  pagFile->removeAllLayers();
+  pagPlayer->flush();
+  EXPECT_EQ(filterResultCache.memoryUsage(), 0u);
+  EXPECT_TRUE(filterResultCache.entries.empty());
+}
+
 /**
  * 用例描述: GaussBlur效果测试
  */
@@ -129,6 +184,60 @@ PAG_TEST(PAGFilterTest, GaussBlur) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/GaussBlur_FastBlur_NoRepeat"));
 }
 
+/**
+ * 用例描述: 降低滤镜质量时，大半径模糊在较低分辨率下执行
+ */
+PAG_TEST(PAGFilterTest, FilterQuality) {
+  EXPECT_EQ(GetBlurWorkingScale(100.0f, 1.0f), 1.0f);
+  EXPECT_EQ(GetBlurWorkingScale(4.0f, 0.0f), 1.0f);
+  EXPECT_FLOAT_EQ(GetBlurWorkingScale(16.0f, 0.0f), 0.5f);
+  EXPECT_FLOAT_EQ(GetBlurWorkingScale(16.0f, 0.5f), 1.0f);
+  EXPECT_FLOAT_EQ(GetBlurWorkingScale(1000.0f, 0.0f), 0.25f);
+
+  auto pagFile = LoadPAGFile("resources/filter/fastblur.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  EXPECT_EQ(pagPlayer->filterQuality(), 1.0f);
+  pagPlayer->setFilterQuality(-1.0f);
+  EXPECT_EQ(pagPlayer->filterQuality(), 0.0f);
+  pagFile->setCurrentTime(1000000);
+  EXPECT_TRUE(pagPlayer->flush());
+  auto reducedSnapshot = MakeSnapshot(pagSurface);
+  pagPlayer->setFilterQuality(1.0f);
+  EXPECT_TRUE(pagPlayer->flush());
+  EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/GaussBlur_FastBlur"));
+  auto fullSnapshot = MakeSnapshot(pagSurface);
+
+  // 降采样后的模糊结果只允许与全分辨率结果存在轻微的插值误差。
+  tgfx::Pixmap reducedPixels(reducedSnapshot);
+  tgfx::Pixmap fullPixels(fullSnapshot);
+  ASSERT_EQ(reducedPixels.width(), fullPixels.width());
+  ASSERT_EQ(reducedPixels.height(), fullPixels.height());
+  auto rowBytes = static_cast<size_t>(fullPixels.width()) * 4;
+  size_t totalDiff = 0;
+  size_t outlierCount = 0;
+  for (int y = 0; y < fullPixels.height(); y++) {
+    auto row = static_cast<size_t>(y);
+    auto reducedRow =
+        static_cast<const uint8_t*>(reducedPixels.pixels()) + reducedPixels.rowBytes() * row;
+    auto fullRow = static_cast<const uint8_t*>(fullPixels.pixels()) + fullPixels.rowBytes() * row;
+    for (size_t i = 0; i < rowBytes; i++) {
+      auto diff = std::abs(static_cast<int>(reducedRow[i]) - static_cast<int>(fullRow[i]));
+      totalDiff += static_cast<size_t>(diff);
+      if (diff > 32) {
+        outlierCount++;
+      }
+    }
+  }
+  auto byteCount = rowBytes * static_cast<size_t>(fullPixels.height());
+  EXPECT_LT(static_cast<double>(totalDiff) / static_cast<double>(byteCount), 2.0);
+  EXPECT_LT(outlierCount, byteCount / 100);
+}
+
 /**
  * 用例描述: Glow效果测试
  */
@@ -488,4 +597,33 @@ PAG_TEST(PAGFilterTest, DefaultFeatherMask) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/DefaultFeatherMask"));
 }
 
+/**
+ * 用例描述: 预编译滤镜程序，并在同一个 Context 的多个 PAGPlayer 之间共享
+ */
+PAG_TEST(PAGFilterTest, PrewarmFilters) {
+  auto pagFile = LoadPAGFile("resources/filter/Glow.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  EXPECT_EQ(pagPlayer->prewarmFilters(pagFile), 0);
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  EXPECT_GT(pagPlayer->prewarmFilters(pagFile), 0);
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  EXPECT_EQ(pagPlayer->renderCache->programCompilingTime, 0);
+
+  auto otherFile = LoadPAGFile("resources/filter/Glow.pag");
+  ASSERT_NE(otherFile, nullptr);
+  auto otherSurface = OffscreenSurface::Make(otherFile->width(), otherFile->height());
+  ASSERT_NE(otherSurface, nullptr);
+  auto otherPlayer = std::make_shared<PAGPlayer>();
+  otherPlayer->setSurface(otherSurface);
+  otherPlayer->setComposition(otherFile);
+  otherPlayer->setProgress(0.5);
+  otherPlayer->flush();
+  EXPECT_EQ(otherPlayer->renderCache->programCompilingTime, 0);
+}
+
 }  // namespace pag
@@ -16,7 +16,13 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <thread>
+#include <vector>
+#include "base/utils/ImagePool.h"
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunknown-warning-option"
 #pragma clang diagnostic ignored "-Wdeprecated-literal-operator"
@@ -168,4 +174,114 @@ PAG_TEST(PAGImageTest, BottomLeftMask) {
   device->unlock();
   EXPECT_TRUE(Baseline::Compare(pixmap, "PAGImageTest/BottomLeftMask"));
 }
+
+/**
+ * 用例描述: 开启降采样解码后，替换图片显示尺寸远小于原图时按显示尺寸解码，放大后重新解码，
+ * 默认关闭时始终按原图尺寸解码
+ */
+PAG_TEST(PAGImageTest, DownsampledDecoding) {
+  auto pagImage = MakePAGImage("resources/apitest/rotation.jpg");
+  ASSERT_TRUE(pagImage != nullptr);
+  auto pagFile = LoadPAGFile("resources/apitest/replace2.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  pagFile->replaceImage(0, pagImage);
+  auto surface = OffscreenSurface::Make(720, 720);
+  ASSERT_TRUE(surface != nullptr);
+  auto player = std::make_unique<PAGPlayer>();
+  player->setComposition(pagFile);
+  player->setSurface(surface);
+  player->setMatrix(Matrix::MakeScale(0.05f));
+  EXPECT_FALSE(player->imageDownsampling());
+  EXPECT_TRUE(player->flush());
+  auto renderCache = player->renderCache;
+  auto assetID = pagImage->uniqueID();
+  ASSERT_TRUE(renderCache->assetImages[assetID] != nullptr);
+  EXPECT_EQ(renderCache->assetImages[assetID]->width(), pagImage->width());
+
+  player->setImageDownsampling(true);
+  EXPECT_TRUE(player->flush());
+  auto decodeScale = renderCache->assetImageScales[assetID];
+  EXPECT_LT(decodeScale, 1.0f);
+  EXPECT_LT(renderCache->assetImages[assetID]->width(), pagImage->width());
+
+  player->setMatrix(Matrix::MakeScale(0.06f));
+  EXPECT_TRUE(player->flush());
+  EXPECT_EQ(renderCache->assetImageScales[assetID], decodeScale);
+
+  player->setMatrix(Matrix::I());
+  EXPECT_TRUE(player->flush());
+  EXPECT_GT(renderCache->assetImageScales[assetID], decodeScale);
+
+  player->setMatrix(Matrix::MakeScale(0.05f));
+  player->setImageDownsampling(false);
+  EXPECT_TRUE(player->flush());
+  EXPECT_EQ(renderCache->assetImageScales[assetID], 1.0f);
+  EXPECT_EQ(renderCache->assetImages[assetID]->width(), pagImage->width());
+}
+
+/**
+ * 用例描述: 相同内容的图片在不同 PAGImage 之间共享同一份解码图片
+ */
+PAG_TEST(PAGImageTest, SharedImagePool) {
+  auto byteData =
+      ByteData::FromPath(ProjectPath::Absolute("resources/apitest/imageReplacement.png"));
+  ASSERT_TRUE(byteData != nullptr);
+  auto image = ImagePool::MakeFromEncoded(byteData->data(), byteData->length());
+  ASSERT_TRUE(image != nullptr);
+  auto copyData = ByteData::MakeCopy(byteData->data(), byteData->length());
+  EXPECT_EQ(ImagePool::MakeFromEncoded(copyData->data(), copyData->length()), image);
+  auto mipmappedImage = ImagePool::MakeMipmapped(image);
+  ASSERT_TRUE(mipmappedImage != nullptr);
+  EXPECT_EQ(ImagePool::MakeMipmapped(image), mipmappedImage);
+
+  auto otherData =
+      ByteData::FromPath(ProjectPath::Absolute("resources/apitest/imageReplacement.jpg"));
+  ASSERT_TRUE(otherData != nullptr);
+  auto otherImage = ImagePool::MakeFromEncoded(otherData->data(), otherData->length());
+  ASSERT_TRUE(otherImage != nullptr);
+  EXPECT_NE(otherImage, image);
+
+  auto filePath = ProjectPath::Absolute("test/out/PAGImageTest/SharedImagePool.img");
+  std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
+  // 两份内容补齐到相同长度，覆盖写入后文件大小不变
+  auto fileLength = std::max(byteData->length(), otherData->length());
+  auto writeFile = [&](const ByteData* data) {
+    std::vector<char> bytes(fileLength, 0);
+    memcpy(bytes.data(), data->data(), data->length());
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  };
+  writeFile(byteData.get());
+  auto fileImage = ImagePool::MakeFromFile(filePath);
+  ASSERT_TRUE(fileImage != nullptr);
+  EXPECT_EQ(ImagePool::MakeFromFile(filePath), fileImage);
+  EXPECT_EQ(fileImage->width(), image->width());
+  EXPECT_EQ(fileImage->height(), image->height());
+
+  // 原地覆盖写入的文件即使大小和修改时间都不变，也需要重新解码，不能返回旧的图片
+  auto modifyTime = std::filesystem::last_write_time(filePath);
+  writeFile(otherData.get());
+  std::filesystem::last_write_time(filePath, modifyTime);
+  auto rewrittenImage = ImagePool::MakeFromFile(filePath);
+  ASSERT_TRUE(rewrittenImage != nullptr);
+  EXPECT_NE(rewrittenImage, fileImage);
+  EXPECT_EQ(rewrittenImage->width(), otherImage->width());
+  EXPECT_EQ(rewrittenImage->height(), otherImage->height());
+  auto pagImage = PAGImage::FromPath(filePath);
+  ASSERT_TRUE(pagImage != nullptr);
+  EXPECT_EQ(pagImage->width(), otherImage->width());
+  EXPECT_EQ(pagImage->height(), otherImage->height());
+
+  // 图片释放后缓存池不再持有编码数据
+  // 末尾多一个字节，避免与仍在使用的 otherImage 共享
+  std::vector<char> encodedBytes(otherData->length() + 1, 0);
+  memcpy(encodedBytes.data(), otherData->data(), otherData->length());
+  auto encodedData = tgfx::Data::MakeWithCopy(encodedBytes.data(), encodedBytes.size());
+  std::weak_ptr<tgfx::Data> weakData = encodedData;
+  auto encodedImage = ImagePool::MakeFromEncoded(std::move(encodedData));
+  ASSERT_TRUE(encodedImage != nullptr);
+  EXPECT_FALSE(weakData.expired());
+  encodedImage = nullptr;
+  EXPECT_TRUE(weakData.expired());
+}
 }  // namespace pag
@@ -22,6 +22,12 @@
 #pragma clang diagnostic ignored "-Wdeprecated-literal-operator"
 #include "nlohmann/json.hpp"
 #pragma clang diagnostic pop
+#include "base/keyframes/SingleEaseKeyframe.h"
+#include "rendering/caches/MaskPathCache.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/renderers/MaskRenderer.h"
+#include "rendering/renderers/TrackMatteRenderer.h"
+#include "rendering/utils/MemoryCalculator.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -159,6 +165,150 @@ PAG_TEST(PAGLayerTest, trackMatte) {
   EXPECT_TRUE(Baseline::Compare(TestPAGSurface, "PAGLayerTest/trackMatte"));
 }
 
+/**
+ * 用例描述: 遮罩图层未变化时复用缓存的遮罩，变化后重新录制。
+ */
+PAG_TEST(PAGLayerTest, trackMatteCache) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  int target = 0;
+  auto layer = GetLayer(TestPAGFile, LayerType::Solid, target);
+  ASSERT_NE(layer, nullptr);
+  auto trackMatteLayer = layer->trackMatteLayer();
+  ASSERT_NE(trackMatteLayer, nullptr);
+  TestPAGFile->setCurrentTime(800 * 1000);
+  TestPAGPlayer->flush();
+  ASSERT_NE(trackMatteLayer->trackMatteCache, nullptr);
+  auto renderCache = TestPAGPlayer->renderCache;
+  EXPECT_EQ(renderCache->trackMatteCacheHits, 0);
+
+  // 只移动被遮罩的图层，遮罩图层的缓存可以直接复用。
+  auto matrix = layer->matrix();
+  auto offsetMatrix = matrix;
+  offsetMatrix.postTranslate(10, 10);
+  layer->setMatrix(offsetMatrix);
+  TestPAGPlayer->flush();
+  EXPECT_GT(renderCache->trackMatteCacheHits, 0);
+  EXPECT_GT(renderCache->trackMatteCacheHitRate(), 0.0f);
+  layer->setMatrix(matrix);
+  TestPAGPlayer->flush();
+  EXPECT_GT(renderCache->trackMatteCacheHits, 0);
+  EXPECT_TRUE(Baseline::Compare(TestPAGSurface, "PAGLayerTest/trackMatte"));
+
+  // 移动遮罩图层后缓存失效，需要重新录制。
+  auto matteMatrix = trackMatteLayer->matrix();
+  matteMatrix.postTranslate(10, 10);
+  trackMatteLayer->setMatrix(matteMatrix);
+  TestPAGPlayer->flush();
+  EXPECT_GT(renderCache->trackMatteCacheMisses, 0);
+  EXPECT_TRUE(trackMatteLayer->trackMatteCache->layerMatrix == matteMatrix);
+}
+
+static PathHandle MakeRectPath(float left, float top, float size) {
+  auto path = std::make_shared<PathData>();
+  path->moveTo(left, top);
+  path->lineTo(left + size, top);
+  path->lineTo(left + size, top + size);
+  path->lineTo(left, top + size);
+  path->close();
+  return path;
+}
+
+static MaskData* MakeRectMask(Property<PathHandle>* maskPath, MaskMode maskMode) {
+  auto mask = new MaskData();
+  mask->maskMode = maskMode;
+  mask->maskPath = maskPath;
+  mask->maskOpacity = new Property<Opacity>(Opaque);
+  mask->maskExpansion = new Property<float>(0);
+  return mask;
+}
+
+static std::vector<std::unique_ptr<MaskData>> MakeRectMasks(int maskCount, Frame duration) {
+  std::vector<std::unique_ptr<MaskData>> masks = {};
+  for (int i = 0; i < maskCount - 1; i++) {
+    auto maskPath = new Property<PathHandle>(MakeRectPath(i * 10.0f, i * 5.0f, 100));
+    masks.emplace_back(MakeRectMask(maskPath, MaskMode::Add));
+  }
+  // 只有最后一个蒙版有动画。
+  auto keyframe = new SingleEaseKeyframe<PathHandle>();
+  keyframe->startTime = 0;
+  keyframe->endTime = duration;
+  keyframe->startValue = MakeRectPath(0, 0, 50);
+  keyframe->endValue = MakeRectPath(200, 100, 50);
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  auto maskPath = new AnimatableProperty<PathHandle>({keyframe});
+  masks.emplace_back(MakeRectMask(maskPath, MaskMode::Subtract));
+  return masks;
+}
+
+static std::vector<MaskData*> GetMaskList(const std::vector<std::unique_ptr<MaskData>>& masks) {
+  std::vector<MaskData*> maskList = {};
+  for (auto& mask : masks) {
+    maskList.push_back(mask.get());
+  }
+  return maskList;
+}
+
+/**
+ * 用例描述: 只有一个蒙版有动画时，静态蒙版的合并结果在帧和图层之间共享。
+ */
+PAG_TEST(PAGLayerTest, maskPathCache) {
+  constexpr int maskCount = 20;
+  constexpr Frame duration = 10;
+  auto masks = MakeRectMasks(maskCount, duration);
+  auto maskList = GetMaskList(masks);
+  MaskPathCache cache(16 * 1024 * 1024);
+  for (Frame frame = 0; frame < duration; frame++) {
+    tgfx::Path cachedPath = {};
+    RenderMasks(&cachedPath, maskList, frame, &cache);
+    tgfx::Path expectedPath = {};
+    RenderMasks(&expectedPath, maskList, frame, nullptr);
+    EXPECT_TRUE(cachedPath == expectedPath);
+  }
+  // 前 19 个静态蒙版的结果只计算一次，最后一个蒙版每帧各有一个结果。
+  EXPECT_EQ(cache.entries.size(), static_cast<size_t>(maskCount - 1 + duration));
+  size_t memoryUsage = 0;
+  for (auto& entry : cache.entries) {
+    memoryUsage += MemoryCalculator::GetPathMemory(entry.path) +
+                   MemoryCalculator::GetPathDataMemory(entry.key.mask.path);
+  }
+  EXPECT_EQ(cache.memoryUsage(), memoryUsage);
+
+  // 另一个图层的蒙版数值相同时直接复用已有结果。
+  auto otherMasks = MakeRectMasks(maskCount, duration);
+  tgfx::Path otherPath = {};
+  RenderMasks(&otherPath, GetMaskList(otherMasks), 5, &cache);
+  EXPECT_EQ(cache.entries.size(), static_cast<size_t>(maskCount - 1 + duration));
+  tgfx::Path otherExpectedPath = {};
+  RenderMasks(&otherExpectedPath, GetMaskList(otherMasks), 5, nullptr);
+  EXPECT_FALSE(otherPath.isEmpty());
+  EXPECT_TRUE(otherPath == otherExpectedPath);
+
+  // 缓存只保存路径数据的拷贝，释放蒙版后原来的路径数据也随之释放。
+  std::weak_ptr<PathData> weakPath = masks.front()->maskPath->value;
+  maskList.clear();
+  masks.clear();
+  EXPECT_TRUE(weakPath.expired());
+  tgfx::Path reusedPath = {};
+  RenderMasks(&reusedPath, GetMaskList(otherMasks), 5, &cache);
+  EXPECT_EQ(cache.entries.size(), static_cast<size_t>(maskCount - 1 + duration));
+  EXPECT_TRUE(reusedPath == otherExpectedPath);
+
+  cache.purgeUntilMemoryTo(memoryUsage / 2);
+  EXPECT_LE(cache.memoryUsage(), memoryUsage / 2);
+  auto budget = memoryUsage / 4;
+  cache.setMemoryBudget(budget);
+  EXPECT_LE(cache.memoryUsage(), budget);
+  EXPECT_EQ(cache.positions.size(), cache.entries.size());
+
+  // 内存紧张时 PAGSurface::freeCache() 会清空全局的蒙版路径缓存。
+  RenderMasks(&otherPath, GetMaskList(otherMasks), 5);
+  EXPECT_GT(MaskPathCache::Get()->memoryUsage(), 0u);
+  auto pagSurface = OffscreenSurface::Make(100, 100);
+  ASSERT_TRUE(pagSurface != nullptr);
+  pagSurface->freeCache();
+  EXPECT_EQ(MaskPathCache::Get()->memoryUsage(), 0u);
+}
+
 /**
  * 用例描述: PAGLayerTest测试visible接口
  */
@@ -16,11 +16,15 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunknown-warning-option"
 #pragma clang diagnostic ignored "-Wdeprecated-literal-operator"
 #include "nlohmann/json.hpp"
 #pragma clang diagnostic pop
+#include "base/utils/Tracer.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -133,4 +137,158 @@ PAG_TEST(PAGPlayerTest, autoClear) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGPlayerTest/autoClear_autoClear_true"));
 }
 
+/**
+ * 用例描述: 局部重绘的像素与整体重绘完全一致，只移动一个图层时脏区域只包含该图层
+ */
+PAG_TEST(PAGPlayerTest, partialRedraw) {
+  auto makePlayer = [](std::shared_ptr<PAGFile> pagFile, bool partialRedraw) {
+    auto pagPlayer = std::make_unique<PAGPlayer>();
+    pagPlayer->setSurface(OffscreenSurface::Make(pagFile->width(), pagFile->height()));
+    pagPlayer->setComposition(pagFile);
+    pagPlayer->setPartialRedraw(partialRedraw);
+    return pagPlayer;
+  };
+  auto fullFile = LoadPAGFile("resources/apitest/test.pag");
+  ASSERT_TRUE(fullFile != nullptr);
+  auto partialFile = LoadPAGFile("resources/apitest/test.pag");
+  auto fullPlayer = makePlayer(fullFile, false);
+  auto partialPlayer = makePlayer(partialFile, true);
+  ASSERT_TRUE(fullPlayer->getSurface() != nullptr);
+  EXPECT_FALSE(fullPlayer->partialRedraw());
+  EXPECT_TRUE(partialPlayer->partialRedraw());
+
+  Bitmap fullBitmap(fullFile->width(), fullFile->height(), false, false);
+  Pixmap fullPixmap(fullBitmap);
+  Bitmap partialBitmap(fullFile->width(), fullFile->height(), false, false);
+  Pixmap partialPixmap(partialBitmap);
+  auto comparePixels = [&]() {
+    auto colorType = ToPAG(fullPixmap.colorType());
+    auto alphaType = ToPAG(fullPixmap.alphaType());
+    EXPECT_TRUE(fullPlayer->getSurface()->readPixels(
+        colorType, alphaType, fullPixmap.writablePixels(), fullPixmap.rowBytes()));
+    EXPECT_TRUE(partialPlayer->getSurface()->readPixels(
+        colorType, alphaType, partialPixmap.writablePixels(), partialPixmap.rowBytes()));
+    return memcmp(fullPixmap.pixels(), partialPixmap.pixels(), fullPixmap.byteSize()) == 0;
+  };
+
+  auto fullSolid = PAGSolidLayer::Make(fullFile->duration(), 50, 50, Red, 255);
+  auto partialSolid = PAGSolidLayer::Make(fullFile->duration(), 50, 50, Red, 255);
+  fullFile->addLayer(fullSolid);
+  partialFile->addLayer(partialSolid);
+  fullPlayer->flush();
+  partialPlayer->flush();
+  auto dirtyRegion = partialPlayer->getDirtyRegion();
+  ASSERT_EQ(dirtyRegion.size(), 1u);
+  EXPECT_EQ(dirtyRegion[0], Rect::MakeWH(fullFile->width(), fullFile->height()));
+  EXPECT_TRUE(comparePixels());
+
+  for (int i = 1; i <= 10; i++) {
+    fullPlayer->setProgress(i * 0.1);
+    partialPlayer->setProgress(i * 0.1);
+    fullPlayer->flush();
+    partialPlayer->flush();
+    EXPECT_TRUE(comparePixels());
+  }
+
+  EXPECT_FALSE(partialPlayer->flush());
+  EXPECT_TRUE(partialPlayer->getDirtyRegion().empty());
+
+  fullSolid->setMatrix(Matrix::MakeTrans(10, 0));
+  partialSolid->setMatrix(Matrix::MakeTrans(10, 0));
+  fullPlayer->flush();
+  partialPlayer->flush();
+  dirtyRegion = partialPlayer->getDirtyRegion();
+  ASSERT_EQ(dirtyRegion.size(), 1u);
+  EXPECT_EQ(dirtyRegion[0], Rect::MakeWH(60, 50));
+  EXPECT_EQ(fullPlayer->getDirtyRegion()[0], Rect::MakeWH(fullFile->width(), fullFile->height()));
+  EXPECT_TRUE(comparePixels());
+
+  auto fullBlueSolid = PAGSolidLayer::Make(fullFile->duration(), 50, 50, Blue, 255);
+  auto partialBlueSolid = PAGSolidLayer::Make(fullFile->duration(), 50, 50, Blue, 255);
+  fullBlueSolid->setMatrix(Matrix::MakeTrans(30, 0));
+  partialBlueSolid->setMatrix(Matrix::MakeTrans(30, 0));
+  fullFile->addLayer(fullBlueSolid);
+  partialFile->addLayer(partialBlueSolid);
+  fullPlayer->flush();
+  partialPlayer->flush();
+  EXPECT_TRUE(comparePixels());
+
+  // 只调整图层顺序时，每个图层自身没有变化，但重叠区域的绘制结果不同。
+  fullFile->swapLayer(fullSolid, fullBlueSolid);
+  partialFile->swapLayer(partialSolid, partialBlueSolid);
+  EXPECT_TRUE(partialPlayer->flush());
+  fullPlayer->flush();
+  dirtyRegion = partialPlayer->getDirtyRegion();
+  ASSERT_FALSE(dirtyRegion.empty());
+  auto dirtyBounds = dirtyRegion[0];
+  for (auto& rect : dirtyRegion) {
+    dirtyBounds.join(rect);
+  }
+  EXPECT_TRUE(dirtyBounds.contains(Rect::MakeXYWH(30, 0, 30, 50)));
+  EXPECT_TRUE(comparePixels());
+}
+
+/**
+ * 用例描述: PAGPlayer flush 时记录的 trace span 可以导出为 Chrome trace 格式
+ */
+PAG_TEST(PAGPlayerTest, traceSpans) {
+  auto pagFile = LoadPAGFile("resources/apitest/test.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_TRUE(pagSurface != nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  Tracer::Clear();
+  Tracer::SetEnabled(true);
+  pagPlayer->flush();
+  Tracer::SetEnabled(false);
+  auto trace = json::parse(Tracer::DumpJSON());
+  Tracer::Clear();
+  auto& events = trace["traceEvents"];
+  const json* flushEvent = nullptr;
+  const json* layerEvent = nullptr;
+  for (auto& event : events) {
+    EXPECT_EQ(event["ph"], "X");
+    if (event["name"] == "PAGPlayer::flush") {
+      flushEvent = &event;
+    } else if (event["name"] == "LayerRenderer::DrawLayer" && layerEvent == nullptr) {
+      layerEvent = &event;
+    }
+  }
+  ASSERT_TRUE(flushEvent != nullptr);
+  ASSERT_TRUE(layerEvent != nullptr);
+  auto flushStart = (*flushEvent)["ts"].get<int64_t>();
+  auto flushEnd = flushStart + (*flushEvent)["dur"].get<int64_t>();
+  auto layerStart = (*layerEvent)["ts"].get<int64_t>();
+  EXPECT_GE(layerStart, flushStart);
+  EXPECT_LE(layerStart + (*layerEvent)["dur"].get<int64_t>(), flushEnd);
+  EXPECT_TRUE((*layerEvent)["args"].contains("id"));
+  EXPECT_TRUE(json::parse(Tracer::DumpJSON())["traceEvents"].empty());
+
+  // 线程退出后缓冲区被下一个线程复用，退出线程记录的 span 仍然保留并可以导出。
+  PAG::SetTraceEnabled(true);
+  for (int i = 0; i < 100; i++) {
+    std::thread([]() { TraceScope scope("PAGPlayerTest::thread"); }).join();
+  }
+  PAG::SetTraceEnabled(false);
+  auto countThreadEvents = [](const json& trace) {
+    int count = 0;
+    for (auto& event : trace["traceEvents"]) {
+      if (event["name"] == "PAGPlayerTest::thread") {
+        count++;
+      }
+    }
+    return count;
+  };
+  EXPECT_EQ(countThreadEvents(json::parse(Tracer::DumpJSON())), 100);
+  auto tracePath = (std::filesystem::temp_directory_path() / "PAGPlayerTest_trace.json").string();
+  ASSERT_TRUE(PAG::DumpTrace(tracePath));
+  std::ifstream traceFile(tracePath);
+  EXPECT_EQ(countThreadEvents(json::parse(traceFile)), 100);
+  traceFile.close();
+  std::filesystem::remove(tracePath);
+  EXPECT_TRUE(json::parse(Tracer::DumpJSON())["traceEvents"].empty());
+}
+
 }  // namespace pag
@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <filesystem>
 #include "codec/mp4/MP4BoxHelper.h"
 #include "pag/pag.h"
 #include "platform/swiftshader/NativePlatform.h"
@@ -114,6 +115,61 @@ PAG_TEST(PAGSequenceTest, VideoSequenceToMP4WithoutHeader) {
   EXPECT_TRUE(
       Baseline::Compare(std::move(MP4Data), "PAGSequenceTest/VideoSequenceToMP4WithoutHeader"));
 }
+
+static bool SameBytes(const ByteData* left, const ByteData* right) {
+  if (left == nullptr || right == nullptr) {
+    return left == right;
+  }
+  return left->length() == right->length() &&
+         memcmp(left->data(), right->data(), left->length()) == 0;
+}
+
+/**
+ * 用例描述: 单遍写入（回填 box 大小）与两遍写入生成的 mp4 数据完全一致，流式写入文件的结果也一致。
+ */
+PAG_TEST(PAGSequenceTest, SinglePassMP4Generator) {
+  auto outputPath =
+      (std::filesystem::temp_directory_path() / "SinglePassMP4Generator.mp4").string();
+  int sequenceCount = 0;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(ProjectPath::Absolute("resources/apitest"))) {
+    if (entry.path().extension() != ".pag") {
+      continue;
+    }
+    auto file = File::Load(entry.path().string());
+    if (file == nullptr) {
+      continue;
+    }
+    for (auto composition : file->compositions) {
+      if (composition->type() != CompositionType::Video) {
+        continue;
+      }
+      for (auto videoSequence : static_cast<VideoComposition*>(composition)->sequences) {
+        auto twoPassData = MP4BoxHelper::MakeMP4Data(videoSequence, true, true);
+        auto singlePassData = MP4BoxHelper::MakeMP4Data(videoSequence, true, false);
+        EXPECT_TRUE(SameBytes(twoPassData.get(), singlePassData.get())) << entry.path();
+        auto twoPassHeader = MP4BoxHelper::MakeMP4Data(videoSequence, false, true);
+        auto singlePassHeader = MP4BoxHelper::MakeMP4Data(videoSequence, false, false);
+        EXPECT_TRUE(SameBytes(twoPassHeader.get(), singlePassHeader.get())) << entry.path();
+        if (singlePassData == nullptr) {
+          continue;
+        }
+        auto output = fopen(outputPath.c_str(), "wb");
+        ASSERT_TRUE(output != nullptr);
+        auto success = MP4BoxHelper::WriteMP4(videoSequence, output);
+        fclose(output);
+        EXPECT_TRUE(success) << entry.path();
+        auto streamData = ByteData::FromPath(outputPath);
+        auto mp4Data = MP4BoxHelper::CovertToMP4(videoSequence);
+        EXPECT_TRUE(SameBytes(streamData.get(), mp4Data.get())) << entry.path();
+        sequenceCount++;
+      }
+    }
+  }
+  EXPECT_GT(sequenceCount, 0);
+  std::filesystem::remove(outputPath);
+}
+
 /**
  * 用例描述: 同一个序列帧多图层引用且时间轴交错，测试解码器数量是否正确。
  */
@@ -16,7 +16,14 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <fstream>
+#include "base/keyframes/SingleEaseKeyframe.h"
+#include "rendering/caches/GraphicContent.h"
+#include "rendering/caches/ShapeContentCache.h"
+#include "rendering/graphics/Canvas.h"
+#include "rendering/renderers/ShapeRenderer.h"
+#include "utils/DevicePool.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -104,4 +111,131 @@ PAG_TEST(PAGShapeLayerTest, shape_transform_round_corner) {
   pagPlayer->flush();
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGShapeLayerTest/shape_transform_round_corner"));
 }
+
+static constexpr Frame SHAPE_FRAME_COUNT = 20;
+
+template <typename T>
+static AnimatableProperty<T>* MakeAnimatedProperty(const T& startValue, const T& endValue) {
+  auto keyframe = new SingleEaseKeyframe<T>();
+  keyframe->startTime = 0;
+  keyframe->endTime = SHAPE_FRAME_COUNT;
+  keyframe->startValue = startValue;
+  keyframe->endValue = endValue;
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  return new AnimatableProperty<T>({keyframe});
+}
+
+static ShapeGroupElement* MakeShapeGroup(const std::vector<ShapeElement*>& elements) {
+  auto transform = new ShapeTransform();
+  transform->anchorPoint = new Property<Point>(Point::Zero());
+  transform->position = new Property<Point>(Point::Make(20, 20));
+  transform->scale = new Property<Point>(Point::Make(1, 1));
+  transform->skew = new Property<float>(0);
+  transform->skewAxis = new Property<float>(0);
+  transform->rotation = new Property<float>(0);
+  transform->opacity = new Property<Opacity>(Opaque);
+  auto group = new ShapeGroupElement();
+  group->transform = transform;
+  group->elements = elements;
+  return group;
+}
+
+static RectangleElement* MakeRectangle(Property<Point>* size) {
+  auto rectangle = new RectangleElement();
+  rectangle->size = size;
+  rectangle->position = new Property<Point>(Point::Make(40, 40));
+  rectangle->roundness = new Property<float>(0);
+  return rectangle;
+}
+
+static FillElement* MakeFill(Property<Color>* color) {
+  auto fill = new FillElement();
+  fill->color = color;
+  fill->opacity = new Property<Opacity>(Opaque);
+  return fill;
+}
+
+static std::unique_ptr<ShapeLayer> MakeShapeLayer(const std::vector<ShapeElement*>& elements) {
+  auto layer = new ShapeLayer();
+  layer->duration = SHAPE_FRAME_COUNT;
+  layer->contents.push_back(MakeShapeGroup(elements));
+  return std::unique_ptr<ShapeLayer>(layer);
+}
+
+static std::unique_ptr<ShapeLayer> MakeRepeaterLayer() {
+  auto repeaterTransform = new RepeaterTransform();
+  repeaterTransform->anchorPoint = new Property<Point>(Point::Zero());
+  repeaterTransform->position = new Property<Point>(Point::Make(30, 10));
+  repeaterTransform->scale = new Property<Point>(Point::Make(1, 1));
+  repeaterTransform->rotation = new Property<float>(10);
+  repeaterTransform->startOpacity = new Property<Opacity>(Opaque);
+  repeaterTransform->endOpacity = new Property<Opacity>(128);
+  auto repeater = new RepeaterElement();
+  repeater->copies = new Property<float>(4);
+  repeater->offset = MakeAnimatedProperty(0.0f, 2.0f);
+  repeater->transform = repeaterTransform;
+  auto colors = std::make_shared<GradientColor>();
+  colors->colorStops = {{0.0f, 0.5f, Red}, {1.0f, 0.5f, Blue}};
+  colors->alphaStops = {{0.0f, 0.5f, Opaque}, {1.0f, 0.5f, Opaque}};
+  auto stroke = new GradientStrokeElement();
+  stroke->miterLimit = new Property<float>(4);
+  stroke->startPoint = MakeAnimatedProperty(Point::Make(0, 0), Point::Make(60, 0));
+  stroke->endPoint = new Property<Point>(Point::Make(120, 80));
+  stroke->colors = new Property<GradientColorHandle>(colors);
+  stroke->opacity = new Property<Opacity>(Opaque);
+  stroke->strokeWidth = new Property<float>(6);
+  stroke->dashOffset = new Property<float>(0);
+  auto size = new Property<Point>(Point::Make(50, 30));
+  return MakeShapeLayer({MakeRectangle(size), repeater, stroke});
+}
+
+/**
+ * 用例描述: ShapeContentCache 复用形状几何时，每一帧的绘制结果都与 RenderShapes 一致，
+ * 并且缓存的几何数量有上限
+ */
+PAG_TEST(PAGShapeLayerTest, ShapeGeometryCache) {
+  auto device = DevicePool::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto cacheSurface = tgfx::Surface::Make(context, 240, 200);
+  auto shapeSurface = tgfx::Surface::Make(context, 240, 200);
+  ASSERT_TRUE(cacheSurface != nullptr && shapeSurface != nullptr);
+  tgfx::Bitmap cacheBitmap(240, 200, false, false);
+  tgfx::Pixmap cachePixmap(cacheBitmap);
+  tgfx::Bitmap shapeBitmap(240, 200, false, false);
+  tgfx::Pixmap shapePixmap(shapeBitmap);
+  auto drawGraphic = [](tgfx::Surface* surface, std::shared_ptr<Graphic> graphic,
+                        tgfx::Pixmap* pixmap) {
+    surface->getCanvas()->clear();
+    Canvas canvas(surface, nullptr);
+    graphic->draw(&canvas);
+    return surface->readPixels(pixmap->info(), pixmap->writablePixels());
+  };
+
+  auto staticRectangle = MakeRectangle(new Property<Point>(Point::Make(60, 40)));
+  auto colorLayer = MakeShapeLayer({staticRectangle, MakeFill(MakeAnimatedProperty(Red, Blue))});
+  auto animatedSize = MakeAnimatedProperty(Point::Make(20, 20), Point::Make(80, 60));
+  auto geometryLayer =
+      MakeShapeLayer({MakeRectangle(animatedSize), MakeFill(new Property<Color>(Green))});
+  auto repeaterLayer = MakeRepeaterLayer();
+  for (auto layer : {colorLayer.get(), geometryLayer.get(), repeaterLayer.get()}) {
+    ShapeContentCache contentCache(layer);
+    for (Frame frame = 0; frame < SHAPE_FRAME_COUNT; frame++) {
+      std::unique_ptr<GraphicContent> content(
+          static_cast<GraphicContent*>(contentCache.createContent(frame)));
+      auto graphic = RenderShapes(layer->uniqueID, layer->contents, frame);
+      ASSERT_TRUE(drawGraphic(cacheSurface.get(), content->graphic, &cachePixmap));
+      ASSERT_TRUE(drawGraphic(shapeSurface.get(), graphic, &shapePixmap));
+      EXPECT_EQ(memcmp(cachePixmap.pixels(), shapePixmap.pixels(), cachePixmap.byteSize()), 0)
+          << "frame: " << frame;
+    }
+    EXPECT_LE(contentCache.geometries.size(), 4u);
+    if (layer == colorLayer.get()) {
+      // Only the fill color is animated, so every frame shares the same geometry.
+      EXPECT_EQ(contentCache.geometries.size(), 1u);
+    }
+  }
+  device->unlock();
+}
 }  // namespace pag
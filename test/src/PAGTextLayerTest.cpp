@@ -17,8 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <rendering/renderers/TextAnimatorRenderer.h>
+#include <cstring>
 #include <iostream>
 #include <thread>
+#include <unordered_set>
 #include "base/utils/Log.h"
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunknown-warning-option"
@@ -26,6 +28,8 @@
 #include "nlohmann/json.hpp"
 #pragma clang diagnostic pop
 #include "pag/file.h"
+#include "rendering/caches/TextContentCache.h"
+#include "rendering/editing/TextReplacement.h"
 #include "rendering/renderers/TextRenderer.h"
 #include "utils/TestUtils.h"
 
@@ -543,4 +547,102 @@ PAG_TEST(PAGTextLayerTest, TextLayerScaleAnimationWithMipmap) {
   EXPECT_TRUE(
       Baseline::Compare(TestPAGSurface, "PAGTextLayerTest/TextLayerScaleAnimationWithMipmap"));
 }
+
+/**
+ * 用例描述: 预先排版文本（包括替换后的文本）并光栅化字形，首帧渲染结果保持不变
+ */
+PAG_TEST(PAGTextLayerTest, PrewarmGlyphs) {
+  auto pagFile = LoadPAGFile("resources/apitest/test.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  EXPECT_EQ(pagPlayer->prewarmGlyphs(pagFile), 0);
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  int target = 0;
+  auto layer = GetLayer(pagFile, LayerType::Text, target);
+  ASSERT_NE(layer, nullptr);
+  auto textLayer = std::static_pointer_cast<PAGTextLayer>(layer);
+  textLayer->setText("预排版文本");
+  EXPECT_GT(pagPlayer->prewarmGlyphs(pagFile), 0);
+  // 替换后的文本使用自己的 TextContentCache，预排版需要作用在这份缓存上
+  ASSERT_TRUE(textLayer->replacement != nullptr);
+  auto textContentCache = textLayer->replacement->textContentCache;
+  ASSERT_TRUE(textContentCache != nullptr);
+  ASSERT_FALSE(textContentCache->textBlocks.empty());
+  for (auto& item : textContentCache->textBlocks) {
+    EXPECT_TRUE(item.second != nullptr);
+  }
+  pagFile->setCurrentTime(5 * 1000000);
+  pagPlayer->flush();
+
+  // 与未预排版的相同内容逐像素比较，预排版不应改变渲染结果。
+  auto expectedFile = LoadPAGFile("resources/apitest/test.pag");
+  ASSERT_NE(expectedFile, nullptr);
+  auto expectedSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  ASSERT_NE(expectedSurface, nullptr);
+  auto expectedPlayer = std::make_shared<PAGPlayer>();
+  expectedPlayer->setSurface(expectedSurface);
+  expectedPlayer->setComposition(expectedFile);
+  target = 0;
+  auto expectedLayer = GetLayer(expectedFile, LayerType::Text, target);
+  ASSERT_NE(expectedLayer, nullptr);
+  std::static_pointer_cast<PAGTextLayer>(expectedLayer)->setText("预排版文本");
+  expectedFile->setCurrentTime(5 * 1000000);
+  expectedPlayer->flush();
+  auto snapshot = MakeSnapshot(pagSurface);
+  auto expectedSnapshot = MakeSnapshot(expectedSurface);
+  tgfx::Pixmap pixmap(snapshot);
+  tgfx::Pixmap expectedPixmap(expectedSnapshot);
+  ASSERT_FALSE(pixmap.isEmpty());
+  ASSERT_EQ(pixmap.byteSize(), expectedPixmap.byteSize());
+  EXPECT_EQ(memcmp(pixmap.pixels(), expectedPixmap.pixels(), pixmap.byteSize()), 0);
+}
+
+/**
+ * 用例描述: 从 Hold 关键帧中枚举出图层时间范围内所有不同的 TextDocument，并且在首次使用时才排版
+ */
+PAG_TEST(PAGTextLayerTest, SourceTextKeyframes) {
+  auto makeKeyframe = [](Frame startTime, Frame endTime, TextDocumentHandle startValue,
+                         TextDocumentHandle endValue) {
+    auto keyframe = new Keyframe<TextDocumentHandle>();
+    keyframe->startTime = startTime;
+    keyframe->endTime = endTime;
+    keyframe->startValue = std::move(startValue);
+    keyframe->endValue = std::move(endValue);
+    return keyframe;
+  };
+  std::vector<TextDocumentHandle> documents = {};
+  for (auto& text : {"A", "B", "C", "D"}) {
+    auto document = std::make_shared<TextDocument>();
+    document->text = text;
+    document->fontSize = 24;
+    documents.push_back(document);
+  }
+  TextLayer layer = {};
+  layer.startTime = 0;
+  layer.duration = 100;
+  layer.sourceText = new AnimatableProperty<TextDocumentHandle>(
+      {makeKeyframe(0, 30, documents[0], documents[1]),
+       makeKeyframe(30, 60, documents[1], documents[2]),
+       makeKeyframe(60, 100, documents[2], documents[3]),
+       makeKeyframe(100, 150, documents[3], documents[3])});
+  TextContentCache cache(&layer);
+  std::unordered_set<TextDocument*> expected = {};
+  for (Frame frame = layer.startTime; frame < layer.startTime + layer.duration; frame++) {
+    expected.insert(layer.sourceText->getValueAt(frame).get());
+  }
+  EXPECT_EQ(expected.size(), 3u);
+  ASSERT_EQ(cache.textBlocks.size(), expected.size());
+  for (auto& item : cache.textBlocks) {
+    EXPECT_TRUE(expected.count(item.first) > 0);
+    EXPECT_TRUE(item.second == nullptr);
+  }
+  auto textBlocks = cache.getTextBlocks();
+  EXPECT_EQ(textBlocks.size(), 3u);
+  for (auto& textBlock : textBlocks) {
+    EXPECT_TRUE(textBlock != nullptr);
+  }
+}
 }  // namespace pag
@@ -9622,6 +9622,58 @@ PAG_TEST(PAGXHTMLStyleCascadeTest, EmptyStylePropertyFallbackAndShorthandGradien
             "linear-gradient(90deg, red, blue)");
 }
 
+PAG_TEST(PAGXHTMLStyleCascadeTest, IdenticalSiblingsShareResolvedStyle) {
+  auto root = ParseHtml(R"HTML(
+    <html>
+      <head><style>.item { color: red; font-size: 20px }</style></head>
+      <body style="width:100px;height:50px">
+        <div class="item" style="text-indent:2px"/>
+        <div class="item" style="text-indent:2px"/>
+        <div class="item"/>
+      </body>
+    </html>
+  )HTML");
+  ASSERT_NE(root, nullptr);
+  auto head = root->getFirstChild("head");
+  auto body = root->getFirstChild("body");
+  ASSERT_NE(body, nullptr);
+  auto first = body->getFirstChild("div");
+  ASSERT_NE(first, nullptr);
+  auto second = first->getNextSibling("div");
+  ASSERT_NE(second, nullptr);
+  auto third = second->getNextSibling("div");
+  ASSERT_NE(third, nullptr);
+
+  auto document = pagx::PAGXDocument::Make(100.0f, 50.0f);
+  float canvasWidth = 100.0f;
+  float canvasHeight = 50.0f;
+  pagx::HTMLDiagnosticSink diagnostics(false);
+  diagnostics.bindDocument(document.get());
+  pagx::HTMLValueParser valueParser(diagnostics, canvasWidth, canvasHeight);
+  pagx::HTMLStyleCascade cascade(diagnostics, valueParser);
+  cascade.collectStyles(head);
+
+  // Identical tag, class and inline style resolve to the same shared property map.
+  EXPECT_EQ(&cascade.getResolvedStyle(first), &cascade.getResolvedStyle(second));
+  EXPECT_NE(&cascade.getResolvedStyle(first), &cascade.getResolvedStyle(third));
+
+  auto bodyStyle = cascade.resolveInheritedStyle(body, pagx::HTMLInheritedStyle{});
+  EXPECT_NE(bodyStyle.cascadeId, 0u);
+  auto firstStyle = cascade.resolveInheritedStyle(first, bodyStyle);
+  auto errorCount = document->errors.size();
+  auto secondStyle = cascade.resolveInheritedStyle(second, bodyStyle);
+  auto thirdStyle = cascade.resolveInheritedStyle(third, bodyStyle);
+  EXPECT_EQ(firstStyle.cascadeId, secondStyle.cascadeId);
+  EXPECT_NE(firstStyle.cascadeId, thirdStyle.cascadeId);
+  EXPECT_FLOAT_EQ(secondStyle.fontSizePx, 20.0f);
+  EXPECT_EQ(secondStyle.color, "red");
+  EXPECT_FLOAT_EQ(thirdStyle.fontSizePx, 20.0f);
+
+  // The shared result still reports the unsupported text-indent for the second sibling.
+  ASSERT_EQ(document->errors.size(), errorCount + 1);
+  EXPECT_NE(document->errors.back().find("text-indent"), std::string::npos);
+}
+
 PAG_TEST(PAGXHTMLValueParserTest, FilterDefaultsAndRepeatingGradientBoundaries) {
   auto document = pagx::PAGXDocument::Make(100.0f, 100.0f);
   float canvasWidth = 100.0f;
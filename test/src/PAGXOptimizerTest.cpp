@@ -24,8 +24,10 @@
 #include "pagx/PAGXImporter.h"
 #include "pagx/PAGXOptimizer.h"
 #include "pagx/PAGXOptimizerOptions.h"
+#include "pagx/nodes/BackgroundBlurStyle.h"
 #include "pagx/nodes/BlurFilter.h"
 #include "pagx/nodes/Composition.h"
+#include "pagx/nodes/DataBind.h"
 #include "pagx/nodes/DropShadowStyle.h"
 #include "pagx/nodes/Ellipse.h"
 #include "pagx/nodes/Fill.h"
@@ -48,6 +50,7 @@ namespace pag {
 
 using pagx::Alignment;
 using pagx::Arrangement;
+using pagx::BackgroundBlurStyle;
 using pagx::BlendMode;
 using pagx::BlurFilter;
 using pagx::Color;
@@ -81,6 +84,7 @@ using pagx::PAGXOptimizer;
 using pagx::PAGXOptimizerOptions;
 using pagx::Path;
 using pagx::PathData;
+using pagx::PathVerb;
 using pagx::Rectangle;
 using pagx::SolidColor;
 using pagx::Stroke;
@@ -1822,4 +1826,284 @@ CLI_TEST(PAGXOptimizerTest, CollapseKeepsNonFillingChild) {
   EXPECT_EQ(parent->children[0], child);
 }
 
+// ---------------------------------------------------------------------------
+// Path simplification
+// ---------------------------------------------------------------------------
+
+static PAGXOptimizerOptions SimplifyOnly() {
+  auto options = OnlyRuleOptions();
+  options.simplifyPaths = true;
+  return options;
+}
+
+// A circle traced as a dense polygon, the shape SVG tracers typically emit.
+static Path* AddTracedCircle(PAGXDocument* doc, std::vector<Element*>& elements, int segments) {
+  auto* data = doc->makeNode<PathData>();
+  for (int i = 0; i < segments; i++) {
+    float angle = static_cast<float>(i) * 2.0f * 3.14159265f / static_cast<float>(segments);
+    float x = 50.0f + 40.0f * std::cos(angle);
+    float y = 50.0f + 40.0f * std::sin(angle);
+    if (i == 0) {
+      data->moveTo(x, y);
+    } else {
+      data->lineTo(x, y);
+    }
+  }
+  data->close();
+  auto* path = doc->makeNode<Path>();
+  path->data = data;
+  elements.push_back(path);
+  elements.push_back(MakeSolidFill(doc, 0, 0, 0));
+  return path;
+}
+
+CLI_TEST(PAGXOptimizerTest, SimplifyPathsFitsTracedCircle) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* layer = AddTopLayer(doc.get());
+  auto* path = AddTracedCircle(doc.get(), layer->contents, 720);
+
+  auto result = OptimizeWithOptions(doc.get(), SimplifyOnly());
+
+  EXPECT_EQ(result.pathPointsBefore, 720);
+  EXPECT_EQ(result.pathPointsAfter, static_cast<int>(path->data->countPoints()));
+  EXPECT_LT(result.pathPointsAfter, 72);
+  auto& verbs = path->data->verbs();
+  ASSERT_FALSE(verbs.empty());
+  EXPECT_EQ(verbs.front(), PathVerb::Move);
+  EXPECT_EQ(verbs.back(), PathVerb::Close);
+  // Every on-curve point the fit keeps still lies on the circle.
+  auto& points = path->data->points();
+  size_t index = 0;
+  for (auto verb : verbs) {
+    index += static_cast<size_t>(PathData::PointsPerVerb(verb));
+    if (verb == PathVerb::Close) {
+      continue;
+    }
+    auto& end = points[index - 1];
+    EXPECT_NEAR(std::hypot(end.x - 50.0f, end.y - 50.0f), 40.0f, 0.25f);
+  }
+}
+
+// The tolerance is in device pixels, so geometry drawn under a magnifying group keeps more points.
+CLI_TEST(PAGXOptimizerTest, SimplifyPathsScalesToleranceByTransform) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* layer = AddTopLayer(doc.get());
+  auto* plain = AddTracedCircle(doc.get(), layer->contents, 720);
+  auto* group = doc->makeNode<Group>();
+  group->scale = {8.0f, 8.0f};
+  auto* magnified = AddTracedCircle(doc.get(), group->elements, 720);
+  layer->contents.push_back(group);
+
+  OptimizeWithOptions(doc.get(), SimplifyOnly());
+
+  EXPECT_LT(plain->data->countPoints(), magnified->data->countPoints());
+  EXPECT_LT(magnified->data->countPoints(), 720u);
+}
+
+// Addressable Paths can be animated or swapped at runtime, and straight polygons have nothing to
+// drop, so both are kept point for point.
+CLI_TEST(PAGXOptimizerTest, SimplifyPathsKeepsAddressableAndMinimalPaths) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* layer = AddTopLayer(doc.get());
+  auto* animated = AddTracedCircle(doc.get(), layer->contents, 360);
+  animated->id = "wave";
+  auto* square = doc->makeNode<Path>();
+  square->data = doc->makeNode<PathData>();
+  square->data->moveTo(0, 0);
+  square->data->lineTo(10, 0);
+  square->data->lineTo(10, 10);
+  square->data->lineTo(0, 10);
+  square->data->close();
+  auto* group = doc->makeNode<Group>();
+  group->elements.push_back(square);
+  group->elements.push_back(MakeSolidFill(doc.get(), 1, 0, 0));
+  layer->contents.push_back(group);
+
+  auto result = OptimizeWithOptions(doc.get(), SimplifyOnly());
+
+  EXPECT_EQ(animated->data->countPoints(), 360u);
+  EXPECT_EQ(square->data->countPoints(), 4u);
+  EXPECT_EQ(result.pathPointsBefore, 4);
+  EXPECT_EQ(result.pathPointsAfter, 4);
+}
+
+// Geometry under a data-bound group or a layer running ViewModel scripts may be scaled at runtime
+// even though no animation targets it, so it is kept point for point as well.
+CLI_TEST(PAGXOptimizerTest, SimplifyPathsKeepsDataBoundAndScriptedGeometry) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* layer = AddTopLayer(doc.get());
+  auto* group = doc->makeNode<Group>("zoom");
+  auto* bound = AddTracedCircle(doc.get(), group->elements, 360);
+  layer->contents.push_back(group);
+  auto* dataBind = doc->makeNode<DataBind>();
+  dataBind->source = "$vm.zoom";
+  dataBind->target = "@zoom";
+  dataBind->channel = "scale";
+  doc->dataBinds.push_back(dataBind);
+  auto* scripted = AddTopLayer(doc.get());
+  scripted->vmContext = "$vm.item";
+  auto* scriptedPath = AddTracedCircle(doc.get(), scripted->contents, 360);
+
+  auto result = OptimizeWithOptions(doc.get(), SimplifyOnly());
+
+  EXPECT_EQ(bound->data->countPoints(), 360u);
+  EXPECT_EQ(scriptedPath->data->countPoints(), 360u);
+  EXPECT_EQ(result.pathPointsBefore, 0);
+  EXPECT_EQ(result.pathPointsAfter, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Occlusion culling / static subtree baking
+// ---------------------------------------------------------------------------
+
+static PAGXOptimizerOptions CullOnly() {
+  auto options = OnlyRuleOptions();
+  options.cullOccludedLayers = true;
+  return options;
+}
+
+static Layer* AddOpaqueBackdrop(PAGXDocument* doc, float w, float h) {
+  auto* layer = AddTopLayer(doc);
+  AddRectFill(doc, layer, w, h);
+  return layer;
+}
+
+// A static layer that sits entirely inside an opaque rectangle drawn above it never reaches the
+// screen, so it is removed and its draw calls are reported as saved.
+CLI_TEST(PAGXOptimizerTest, CullRemovesLayerCoveredByOpaqueRect) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* hidden = AddTopLayer(doc.get());
+  hidden->x = 20;
+  hidden->y = 20;
+  AddRectFill(doc.get(), hidden, 40, 40);
+  auto* cover = AddOpaqueBackdrop(doc.get(), 100, 100);
+
+  auto result = OptimizeWithOptions(doc.get(), CullOnly());
+
+  ASSERT_EQ(doc->layers.size(), 1u);
+  EXPECT_EQ(doc->layers[0], cover);
+  EXPECT_EQ(result.culledLayers, 1);
+  EXPECT_EQ(result.estimatedDrawCallsSaved, 1);
+  EXPECT_FLOAT_EQ(result.estimatedOverdrawSaved, 40.0f * 40.0f);
+}
+
+// Partial coverage, a layer that can be looked up by id, and a translucent cover all keep the
+// layer beneath.
+CLI_TEST(PAGXOptimizerTest, CullKeepsPartiallyCoveredOrAddressableLayers) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* overflowing = AddTopLayer(doc.get());
+  overflowing->x = 80;
+  AddRectFill(doc.get(), overflowing, 40, 40);
+  auto* named = AddTopLayer(doc.get());
+  named->id = "target";
+  AddRectFill(doc.get(), named, 10, 10);
+  AddOpaqueBackdrop(doc.get(), 100, 100);
+
+  auto result = OptimizeWithOptions(doc.get(), CullOnly());
+
+  EXPECT_EQ(doc->layers.size(), 3u);
+  EXPECT_EQ(result.culledLayers, 0);
+  EXPECT_EQ(result.estimatedDrawCallsSaved, 0);
+
+  auto translucentDoc = PAGXDocument::Make(100, 100);
+  auto* hidden = AddTopLayer(translucentDoc.get());
+  AddRectFill(translucentDoc.get(), hidden, 10, 10);
+  auto* cover = AddOpaqueBackdrop(translucentDoc.get(), 100, 100);
+  static_cast<Fill*>(cover->contents[1])->alpha = 0.5f;
+
+  result = OptimizeWithOptions(translucentDoc.get(), CullOnly());
+
+  EXPECT_EQ(translucentDoc->layers.size(), 2u);
+  EXPECT_EQ(result.culledLayers, 0);
+}
+
+// A backdrop blur between the cover and the candidate samples the candidate's pixels around its
+// own edges, so the candidate must survive.
+CLI_TEST(PAGXOptimizerTest, CullStopsAtBackdropReader) {
+  auto doc = PAGXDocument::Make(100, 100);
+  auto* hidden = AddTopLayer(doc.get());
+  AddRectFill(doc.get(), hidden, 10, 10);
+  auto* blur = AddTopLayer(doc.get());
+  AddRectFill(doc.get(), blur, 30, 30);
+  blur->styles.push_back(doc->makeNode<BackgroundBlurStyle>());
+  AddOpaqueBackdrop(doc.get(), 100, 100);
+
+  auto result = OptimizeWithOptions(doc.get(), CullOnly());
+
+  EXPECT_EQ(doc->layers.size(), 3u);
+  EXPECT_EQ(result.culledLayers, 0);
+}
+
+// A deep static subtree with several effects collapses into a single image-filled rectangle on the
+// subtree root, which keeps its id and position.
+PAGX_TEST(PAGXOptimizerTest, BakeCollapsesDeepStaticSubtree) {
+  auto doc = PAGXDocument::Make(200, 200);
+  auto* root = AddTopLayer(doc.get());
+  root->id = "card";
+  root->x = 40;
+  root->y = 40;
+  auto* shadow = doc->makeNode<DropShadowStyle>();
+  shadow->offsetY = 4;
+  shadow->blurX = 6;
+  shadow->blurY = 6;
+  shadow->color = {0, 0, 0, 0.5f};
+  root->styles.push_back(shadow);
+  AddRectFill(doc.get(), root, 100, 100);
+  auto* middle = doc->makeNode<Layer>();
+  auto* blur = doc->makeNode<BlurFilter>();
+  blur->blurX = 2;
+  blur->blurY = 2;
+  middle->filters.push_back(blur);
+  AddRectFill(doc.get(), middle, 60, 60);
+  root->children.push_back(middle);
+  auto* leaf = doc->makeNode<Layer>();
+  leaf->x = 10;
+  leaf->y = 10;
+  AddRectFill(doc.get(), leaf, 20, 20);
+  middle->children.push_back(leaf);
+
+  auto options = OnlyRuleOptions();
+  options.bakeStaticSubtrees = true;
+  auto result = OptimizeWithOptions(doc.get(), options);
+
+  EXPECT_EQ(result.bakedLayers, 1);
+  EXPECT_EQ(result.estimatedDrawCallsSaved, 4);
+  EXPECT_GT(result.estimatedOverdrawSaved, 0.0f);
+  ASSERT_EQ(doc->layers.size(), 1u);
+  EXPECT_EQ(doc->layers[0], root);
+  EXPECT_EQ(root->id, "card");
+  EXPECT_FLOAT_EQ(root->x, 40.0f);
+  EXPECT_TRUE(root->children.empty());
+  EXPECT_TRUE(root->styles.empty());
+  ASSERT_EQ(root->contents.size(), 2u);
+  ASSERT_EQ(root->contents[1]->nodeType(), NodeType::Fill);
+  auto* fill = static_cast<Fill*>(root->contents[1]);
+  ASSERT_NE(fill->color, nullptr);
+  ASSERT_EQ(fill->color->nodeType(), NodeType::ImagePattern);
+  auto* pattern = static_cast<ImagePattern*>(fill->color);
+  ASSERT_NE(pattern->image, nullptr);
+  EXPECT_NE(pattern->image->data, nullptr);
+}
+
+// Without enough effects the subtree is cheap to draw as vectors and stays untouched.
+PAGX_TEST(PAGXOptimizerTest, BakeSkipsSubtreeWithoutEnoughEffects) {
+  auto doc = PAGXDocument::Make(200, 200);
+  auto* root = AddTopLayer(doc.get());
+  AddRectFill(doc.get(), root, 100, 100);
+  auto* middle = doc->makeNode<Layer>();
+  AddRectFill(doc.get(), middle, 60, 60);
+  root->children.push_back(middle);
+  auto* leaf = doc->makeNode<Layer>();
+  AddRectFill(doc.get(), leaf, 20, 20);
+  middle->children.push_back(leaf);
+
+  auto options = OnlyRuleOptions();
+  options.bakeStaticSubtrees = true;
+  auto result = OptimizeWithOptions(doc.get(), options);
+
+  EXPECT_EQ(result.bakedLayers, 0);
+  ASSERT_EQ(root->children.size(), 1u);
+  EXPECT_EQ(root->children[0], middle);
+}
+
 }  // namespace pag
@@ -93,6 +93,7 @@
 #include "pagx/utils/StringParser.h"
 #include "renderer/FontEmbedder.h"
 #include "renderer/LayerBuilder.h"
+#include "renderer/PathPool.h"
 #ifdef PAG_USE_SWIFTSHADER
 #include <GLES3/gl3.h>
 #else
@@ -14077,5 +14078,143 @@ PAGX_TEST(PAGXTest, TextReshapeDemoAnimationAndViewModel) {
   EXPECT_GT(vmWidthAfterSize, vmWidthAfter) << "viewmodel did not reshape vmText fontSize to 60";
 }
 
+/**
+ * Test case: the streaming exporters write their output to the sink in bounded chunks as it is
+ * generated, stop as soon as the sink reports a failure, and ToFile never leaves a partial file.
+ */
+PAGX_TEST(PAGXTest, StreamingExport) {
+  auto doc = pagx::PAGXDocument::Make(400, 300);
+  for (int i = 0; i < 1000; i++) {
+    auto layer = doc->makeNode<pagx::Layer>();
+    layer->name = "Layer" + std::to_string(i);
+    auto rect = doc->makeNode<pagx::Rectangle>();
+    rect->position.x = static_cast<float>(i % 40) * 10.5f;
+    rect->position.y = static_cast<float>(i / 40) * 12.25f;
+    rect->size.width = 8.125f;
+    rect->size.height = 6.5f;
+    auto fill = doc->makeNode<pagx::Fill>();
+    auto solidColor = doc->makeNode<pagx::SolidColor>();
+    solidColor->color = {static_cast<float>(i % 255) / 255.0f, 0.5f, 0.25f, 1.0f};
+    fill->color = solidColor;
+    layer->contents = {rect, fill};
+    doc->layers.push_back(layer);
+  }
+  std::vector<uint8_t> bytes(300 * 1024);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(i * 31);
+  }
+  auto image = doc->makeNode<pagx::Image>("img");
+  image->data = pagx::Data::MakeWithCopy(bytes.data(), bytes.size());
+
+  std::string streamed = {};
+  size_t chunkCount = 0;
+  size_t maxChunkSize = 0;
+  auto callbackSink = pagx::OutputSink::MakeFromCallback([&](const void* data, size_t length) {
+    streamed.append(static_cast<const char*>(data), length);
+    chunkCount++;
+    maxChunkSize = std::max(maxChunkSize, length);
+    return true;
+  });
+  ASSERT_TRUE(callbackSink != nullptr);
+  EXPECT_TRUE(pagx::PAGXExporter::ToStream(*doc, callbackSink.get()));
+  auto xml = pagx::PAGXExporter::ToXML(*doc);
+  EXPECT_GT(xml.size(), bytes.size());
+  EXPECT_EQ(streamed, xml);
+  EXPECT_GT(chunkCount, 4u);
+  // Neither the document nor the base64 payload reaches the sink as a single block.
+  EXPECT_LT(maxChunkSize, static_cast<size_t>(128 * 1024));
+
+  size_t failingWrites = 0;
+  auto failingSink = pagx::OutputSink::MakeFromCallback([&](const void*, size_t) {
+    failingWrites++;
+    return false;
+  });
+  EXPECT_FALSE(pagx::PAGXExporter::ToStream(*doc, failingSink.get()));
+  EXPECT_EQ(failingWrites, 1u);
+
+  // Without style extraction the HTML exporter writes the document head before any layer is
+  // exported, and a failing sink stops the export at its first write.
+  auto resourceDir = ProjectPath::Absolute("test/out/PAGXTest/StreamingExport");
+  pagx::HTMLExporter::Options htmlOptions = {};
+  htmlOptions.extractStyleSheet = false;
+  std::vector<std::string> htmlChunks = {};
+  auto htmlSink = pagx::OutputSink::MakeFromCallback([&](const void* data, size_t length) {
+    htmlChunks.emplace_back(static_cast<const char*>(data), length);
+    return true;
+  });
+  EXPECT_TRUE(pagx::HTMLExporter::ToStream(*doc, resourceDir, htmlSink.get(),
+                                           pagx::HTMLOutputMode::FullDocument, htmlOptions));
+  ASSERT_GT(htmlChunks.size(), 2u);
+  EXPECT_EQ(htmlChunks.front().rfind("<!DOCTYPE", 0), 0u);
+  EXPECT_EQ(htmlChunks.front().find("data-pagx-version"), std::string::npos);
+  EXPECT_NE(htmlChunks.back().find("</html>"), std::string::npos);
+  failingWrites = 0;
+  std::string errorMsg = {};
+  EXPECT_FALSE(pagx::HTMLExporter::ToStream(*doc, resourceDir, failingSink.get(),
+                                            pagx::HTMLOutputMode::FullDocument, htmlOptions,
+                                            &errorMsg));
+  EXPECT_EQ(failingWrites, 1u);
+  EXPECT_FALSE(errorMsg.empty());
+
+  // ToFile writes through a temporary file: an export that cannot be written leaves the existing
+  // file untouched, and a successful one replaces it without leaving the temporary file behind.
+  auto htmlPath = ProjectPath::Absolute("test/out/PAGXTest/StreamingExport.html");
+  auto tempPath = htmlPath + ".tmp";
+  std::filesystem::create_directories(std::filesystem::path(htmlPath).parent_path());
+  std::filesystem::remove_all(tempPath);
+  {
+    std::ofstream file(htmlPath, std::ios::binary | std::ios::trunc);
+    file << "previous";
+  }
+  std::filesystem::create_directories(tempPath);
+  EXPECT_FALSE(pagx::HTMLExporter::ToFile(*doc, htmlPath));
+  auto readFile = [](const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+  EXPECT_EQ(readFile(htmlPath), "previous");
+  std::filesystem::remove_all(tempPath);
+  EXPECT_TRUE(pagx::HTMLExporter::ToFile(*doc, htmlPath));
+  EXPECT_FALSE(std::filesystem::exists(tempPath));
+  auto htmlFile = readFile(htmlPath);
+  EXPECT_EQ(htmlFile.rfind("<!DOCTYPE", 0), 0u);
+  EXPECT_NE(htmlFile.find("</html>"), std::string::npos);
+}
+
+/**
+ * Test case: PathData resources with identical geometry share one pooled tgfx path, which lives
+ * as long as any PathData uses it.
+ */
+PAGX_TEST(PAGXTest, PathPoolSharing) {
+  auto doc1 = pagx::PAGXDocument::Make(100, 100);
+  auto data1 = doc1->makeNode<pagx::PathData>();
+  *data1 = pagx::PathDataFromSVGString("M0 0 L100 0 L100 100 L0 100 Z");
+  auto doc2 = pagx::PAGXDocument::Make(100, 100);
+  auto data2 = doc2->makeNode<pagx::PathData>();
+  *data2 = pagx::PathDataFromSVGString("M0 0 L100 0 L100 100 L0 100 Z");
+  auto path1 = pagx::PathPool::Get(data1);
+  ASSERT_TRUE(path1 != nullptr);
+  EXPECT_EQ(pagx::PathPool::Get(data1), path1);
+  EXPECT_EQ(pagx::PathPool::Get(data2), path1);
+  std::weak_ptr<const tgfx::Path> weakPath = path1;
+  path1 = nullptr;
+
+  // Changing the geometry drops the shared path of that PathData only.
+  data2->lineTo(50, 50);
+  auto path2 = pagx::PathPool::Get(data2);
+  EXPECT_NE(path2, weakPath.lock());
+  EXPECT_FALSE(weakPath.expired());
+
+  doc1 = nullptr;
+  EXPECT_TRUE(weakPath.expired());
+  auto doc3 = pagx::PAGXDocument::Make(100, 100);
+  auto data3 = doc3->makeNode<pagx::PathData>();
+  *data3 = pagx::PathDataFromSVGString("M0 0 L100 0 L100 100 L0 100 Z");
+  auto path3 = pagx::PathPool::Get(data3);
+  ASSERT_TRUE(path3 != nullptr);
+  EXPECT_NE(path3, path2);
+  EXPECT_FALSE(path3->isEmpty());
+}
+
 // Canonical scene render test: Composition-wrapped layer with animation via scene.
 }  // namespace pag
@@ -15,9 +15,16 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <clocale>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <random>
+#include <string>
+#include <vector>
 #include "base/PAGTest.h"
+#include "pagx/utils/NumberCodec.h"
 #include "pagx/utils/StringParser.h"
 
 namespace pag {
@@ -90,4 +97,76 @@ CLI_TEST(StringParserTest, CssFloatToString_NegativeFraction) {
   EXPECT_EQ(pagx::CssFloatToString(-0.123f), "-0.123");
 }
 
+// NumberCodec: locale-independent parsing and shortest round-trip formatting shared by the
+// importers and exporters.
+
+CLI_TEST(StringParserTest, FormatFloat_Shortest) {
+  EXPECT_EQ(pagx::FloatToString(0.1f), "0.1");
+  EXPECT_EQ(pagx::FloatToString(-12.5f), "-12.5");
+  EXPECT_EQ(pagx::FloatToString(100.0f), "100");
+  EXPECT_EQ(pagx::FloatToString(1234567.0f), "1234567");
+  EXPECT_EQ(pagx::FloatToString(0.000123f), "0.000123");
+  EXPECT_EQ(pagx::FloatToString(1.0f / 3.0f), "0.33333334");
+}
+
+CLI_TEST(StringParserTest, FormatFloat_RoundTrip) {
+  std::mt19937 random(2026);
+  std::uniform_int_distribution<uint32_t> distribution = {};
+  char buffer[pagx::MaxFloatChars] = {};
+  for (int i = 0; i < 100000; i++) {
+    auto bits = distribution(random);
+    float value = 0;
+    memcpy(&value, &bits, sizeof(float));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    auto end = pagx::FormatFloat(value, buffer);
+    ASSERT_LT(static_cast<size_t>(end - buffer), pagx::MaxFloatChars);
+    float parsed = 0;
+    ASSERT_EQ(pagx::ParseFloat(buffer, end, &parsed), end) << buffer;
+    ASSERT_EQ(memcmp(&parsed, &value, sizeof(float)), 0) << buffer;
+  }
+}
+
+CLI_TEST(StringParserTest, ParseFloat_MatchesStrtof) {
+  std::vector<std::string> inputs = {"0",        "-0",       "+1.5",      ".5",     "5.",
+                                     "1e3",      "1E-3",     "  42",      "3.4e38", "3.5e38",
+                                     "1e-46",    "1.17549435e-38",        "0.1",    "123.456e2",
+                                     "16777217", "9007199254740993",      "1e",     "1e+"};
+  for (auto& input : inputs) {
+    char* expectedEnd = nullptr;
+    auto expected = strtof(input.c_str(), &expectedEnd);
+    float value = 0;
+    auto end = pagx::ParseFloat(input.data(), input.data() + input.size(), &value);
+    EXPECT_EQ(end - input.data(), expectedEnd - input.c_str()) << input;
+    EXPECT_EQ(memcmp(&value, &expected, sizeof(float)), 0) << input;
+  }
+}
+
+CLI_TEST(StringParserTest, ParseFloat_Rejects) {
+  float value = 1;
+  EXPECT_FALSE(pagx::ParseFloat(std::string_view(""), &value));
+  EXPECT_FALSE(pagx::ParseFloat(std::string_view("abc"), &value));
+  EXPECT_FALSE(pagx::ParseFloat(std::string_view("1.5px"), &value));
+  EXPECT_FALSE(pagx::ParseFloat(std::string_view("0x10"), &value));
+  EXPECT_FALSE(pagx::ParseFloat(std::string_view("nan"), &value));
+  EXPECT_TRUE(pagx::ParseFloat(std::string_view("-2.25"), &value));
+  EXPECT_EQ(value, -2.25f);
+}
+
+CLI_TEST(StringParserTest, NumberCodec_IgnoresLocale) {
+  std::string previous = setlocale(LC_NUMERIC, nullptr);
+  if (setlocale(LC_NUMERIC, "de_DE.UTF-8") == nullptr &&
+      setlocale(LC_NUMERIC, "fr_FR.UTF-8") == nullptr) {
+    GTEST_SKIP() << "No locale with a comma radix character is installed.";
+  }
+  float value = 0;
+  auto parsed = pagx::ParseFloat(std::string_view("1.5"), &value);
+  auto formatted = pagx::FloatToString(2.75f);
+  setlocale(LC_NUMERIC, previous.c_str());
+  EXPECT_TRUE(parsed);
+  EXPECT_EQ(value, 1.5f);
+  EXPECT_EQ(formatted, "2.75");
+}
+
 }  // namespace pag